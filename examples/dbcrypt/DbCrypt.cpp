@@ -89,6 +89,19 @@ public:
 		// fprintf(stderr, "DbInfo: name is %s\n", info->getDatabaseFullPath(status));
 	}
 
+	// Trivial XOR crypt does not depend upon block position, tweaks are ignored
+	void encryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+		const ISC_INT64* tweaks, const void* from, void* to)
+	{
+		encrypt(status, count * length, from, to);
+	}
+
+	void decryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+		const ISC_INT64* tweaks, const void* from, void* to)
+	{
+		decrypt(status, count * length, from, to);
+	}
+
 	int release()
 	{
 		if (--refCounter == 0)
@@ -18,6 +18,9 @@
 #define LTC_SHA256
 #define LTC_SHA512
 
+#define LTC_RIJNDAEL
+#define LTC_XTS_MODE
+
 #if defined(_MSC_VER)
 #define LTC_NO_PROTOTYPES
 #endif
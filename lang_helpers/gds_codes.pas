@@ -2101,6 +2101,10 @@ const
 	gds_dyn_defvaldecl_package_func      = 336068898;
 	isc_dyn_cant_use_zero_inc_ident      = 336068904;
 	gds_dyn_cant_use_zero_inc_ident      = 336068904;
+	isc_dyn_trigram_index                = 336068905;
+	gds_dyn_trigram_index                = 336068905;
+	isc_dyn_ext_delimiter                = 336068906;
+	gds_dyn_ext_delimiter                = 336068906;
 	isc_gbak_unknown_switch              = 336330753;
 	gds_gbak_unknown_switch              = 336330753;
 	isc_gbak_page_size_missing           = 336330754;
@@ -2739,6 +2743,10 @@ const
 	gds_nbackup_deco_parse               = 337117259;
 	isc_nbackup_lostrec_guid_db          = 337117261;
 	gds_nbackup_lostrec_guid_db          = 337117261;
+	isc_nbackup_zip_unavailable          = 337117265;
+	gds_nbackup_zip_unavailable          = 337117265;
+	isc_nbackup_zip_corrupted            = 337117266;
+	gds_nbackup_zip_corrupted            = 337117266;
 	isc_trace_conflict_acts              = 337182750;
 	gds_trace_conflict_acts              = 337182750;
 	isc_trace_act_notfound               = 337182751;
@@ -41,7 +41,7 @@ DDL11_1			= 111,	// rdb$relation_type in rdb$relations
 DDL11_2			= 112,	// rdb$field_name and rdb$relation_name in rdb$procedure_parameters
 						// rdb$admin system role
 						// rdb$message enlarged to 1023.
-DDL12_0			= 120	// rdb$engine_name and rdb$entrypoint in rdb$triggers
+DDL12_0			= 120,	// rdb$engine_name and rdb$entrypoint in rdb$triggers
 						// rdb$package_name in rdb$dependencies
 						// rdb$engine_name, rdb$package_name and rdb$private_flag
 						// in rdb$functions
@@ -52,6 +52,7 @@ DDL12_0			= 120	// rdb$engine_name and rdb$entrypoint in rdb$triggers
 						// rdb$package_name in mon$call_stack
 						// Table rdb$packages
 						// Type of rdb$triggers.rdb$trigger_type changed from SMALLINT to BIGINT
+DDL13_1			= 131	// rdb$generator_cache in rdb$generators
 
 ASF: Engine that works with ODS11.1 and newer supports access to non-existent system fields.
 Reads return NULL and writes do nothing.
@@ -66,6 +67,7 @@ const int DB_VERSION_DDL11		= 110; // ods11 db, FB2
 const int DB_VERSION_DDL11_1	= 111; // ods11.1 db, FB2.1
 const int DB_VERSION_DDL11_2	= 112; // ods11.2 db, FB2.5
 const int DB_VERSION_DDL12		= 120; // ods12.0 db, FB3.0
+const int DB_VERSION_DDL13_1	= 131; // ods13.1 db
 
 const int DB_VERSION_OLDEST_SUPPORTED = DB_VERSION_DDL8;  // IB4.0 is ods8
 
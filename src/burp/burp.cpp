@@ -632,6 +632,21 @@ int gbak(Firebird::UtilSvc* uSvc)
 				// msg 259 expected page buffers, encountered "%s"
 			}
 			break;
+		case IN_SW_BURP_PARALLEL:
+			if (tdgbl->gbl_sw_parallel)
+				BURP_error(333, true, SafeArg() << in_sw_tab->in_sw_name << tdgbl->gbl_sw_parallel);
+			if (++itr >= argc)
+			{
+				BURP_error(371, true);
+				// msg 371 parallel workers parameter missing
+			}
+			tdgbl->gbl_sw_parallel = get_number(argv[itr]);
+			if (tdgbl->gbl_sw_parallel <= 0)
+			{
+				BURP_error(372, true, argv[itr]);
+				// msg 372 expected number of parallel workers, encountered "%s"
+			}
+			break;
 		case IN_SW_BURP_MODE:
 			if (tdgbl->gbl_sw_mode)
 			{
@@ -871,6 +886,11 @@ int gbak(Firebird::UtilSvc* uSvc)
 				BURP_error(334, true, SafeArg() << in_sw_tab->in_sw_name);
 			tdgbl->gbl_sw_compress = false;
 			break;
+		case IN_SW_BURP_ZIP:
+			if (tdgbl->gbl_sw_zip)
+				BURP_error(334, true, SafeArg() << in_sw_tab->in_sw_name);
+			tdgbl->gbl_sw_zip = true;
+			break;
 		case IN_SW_BURP_G:
 			if (noGarbage)
 				BURP_error(334, true, SafeArg() << in_sw_tab->in_sw_name);
@@ -1143,6 +1163,8 @@ int gbak(Firebird::UtilSvc* uSvc)
 	{
 		if (tdgbl->gbl_sw_page_buffers)
 			BURP_error(260, true); // msg 260 page buffers is allowed only on restore or create
+		if (tdgbl->gbl_sw_parallel)
+			BURP_error(373, true); // msg 373 parallel workers are allowed only on restore or create
 
 		int errNum = IN_SW_BURP_0;
 
@@ -200,9 +200,15 @@ Version 10: FB3.0.
 
 Version 11: FB4.0.
 			SQL SECURITY feature.
+
+Version 12: FB4.0.
+			Data may be stored in zlib compressed blocks (att_backup_zip).
+			Backups without -ZIP are still written as version 11, so they
+			may be restored by the previous gbak versions.
 */
 
-const int ATT_BACKUP_FORMAT		= 11;
+const int ATT_BACKUP_FORMAT		= 12;
+const int ATT_BACKUP_FORMAT_NO_ZIP	= 11;
 
 // format version number for ranges for arrays
 
@@ -230,6 +236,7 @@ enum att_type {
 	att_backup_blksize,		// backup block size
 	att_backup_file,		// database file name
 	att_backup_volume,		// backup volume number
+	att_backup_zip,			// size of zlib compressed blocks
 
 	// Database attributes
 
@@ -505,6 +512,7 @@ enum att_type {
 	att_gen_sysflag,
 	att_gen_init_val,
 	att_gen_id_increment,
+	att_gen_cache,			// FB4.0, ODS13_0
 
 	// Stored procedure attributes
 
@@ -911,6 +919,10 @@ public:
 };
 
 
+// zlib compressed stream of backup data, see mvol.cpp
+class BackupZip;
+
+
 // Global switches and data
 
 class BurpGlobals : public Firebird::ThreadData
@@ -970,6 +982,8 @@ public:
 	const SCHAR*	gbl_sw_password;
 	SLONG		gbl_sw_skip_count;
 	SLONG		gbl_sw_page_buffers;
+	SLONG		gbl_sw_parallel;
+	bool		gbl_sw_zip;
 	burp_fil*	gbl_sw_files;
 	burp_fil*	gbl_sw_backup_files;
 	gfld*		gbl_global_fields;
@@ -1001,6 +1015,7 @@ public:
 	SCHAR		mvol_old_file [MAX_FILE_NAME_SIZE];
 	int			mvol_volume_count;
 	bool		mvol_empty_file;
+	BackupZip*	mvol_zip;
 	isc_db_handle	db_handle;
 	isc_tr_handle	tr_handle;
 	isc_tr_handle	global_trans;
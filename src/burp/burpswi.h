@@ -90,6 +90,8 @@ const int IN_SW_BURP_FIX_FSS_METADATA	= 44;	// fix unicode_fss metadata
 const int IN_SW_BURP_FETCHPASS			= 45;	// fetch default password from file to use on attach
 const int IN_SW_BURP_VERBINT			= 46;	// verbose but with specific interval
 const int IN_SW_BURP_STATS				= 47;	// print statistics
+const int IN_SW_BURP_PARALLEL			= 48;	// parallel workers to activate indices
+const int IN_SW_BURP_ZIP				= 49;	// compress backup with zlib
 
 /**************************************************************************/
 	// used 0BCDEFGILMNOPRSTUVYZ	available AHJQWX
@@ -150,6 +152,8 @@ static const Switches::in_sw_tab_t reference_burp_in_sw_table[] =
 				// msg 186: @1OLD_DESCRIPTIONS save old style metadata descriptions
 	{IN_SW_BURP_P,	isc_spb_res_page_size,		"PAGE_SIZE",		0, 0, 0, false, false,	101,	1, NULL, boRestore},
 				// msg 101: @1PAGE_SIZE override default page size
+	{IN_SW_BURP_PARALLEL, isc_spb_res_parallel,	"PARALLEL",			0, 0, 0, false, false,	370,	3, NULL, boRestore},
+				// msg 370: @1PAR(ALLEL) <n> number of workers to activate indices on restore
 	{IN_SW_BURP_PASS, 0,						"PASSWORD", 		0, 0, 0, false, false,	190,	3, NULL, boGeneral},
 				// msg 190: @1PA(SSWORD) Firebird password
 	{IN_SW_BURP_RECREATE, 0,					"RECREATE_DATABASE", 0, 0, 0, false, false,	284,	1, NULL, boMain},
@@ -197,6 +201,8 @@ static const Switches::in_sw_tab_t reference_burp_in_sw_table[] =
 				// msg 109: @1Y redirect/suppress output (file path or OUTPUT_SUPPRESS)
 	{IN_SW_BURP_Z,	  0,						"Z",				0, 0, 0, false, false,	104,	1, NULL, boGeneral},
 				// msg 104: @1Z print version number
+	{IN_SW_BURP_ZIP,  isc_spb_bkp_zip,			"ZIP",				0, 0, 0, false, true,	374,	3, NULL, boBackup},
+				// msg 374: @1ZIP compress backup file with zlib
 /**************************************************************************/
 // The next two 'virtual' switches are hidden from user and are needed
 // for services API
@@ -45,6 +45,8 @@
 #include "../yvalve/gds_proto.h"
 #include "../common/gdsassert.h"
 #include "../common/os/os_utils.h"
+#include "../common/classes/zip.h"
+#include "memory_routines.h"
 #include <fcntl.h>
 #include <sys/types.h>
 
@@ -73,10 +75,13 @@ const char* TERM_OUTPUT	= "/dev/tty";
 
 const int MAX_HEADER_SIZE	= 512;
 
+static int   raw_read(int*, UCHAR**);
+static UCHAR raw_write(const UCHAR, int*, UCHAR**);
+
 static inline int get(BurpGlobals* tdgbl)
 {
 	if (tdgbl->mvol_io_cnt <= 0)
-		MVOL_read(NULL, NULL);
+		raw_read(NULL, NULL);
 	return (--tdgbl->mvol_io_cnt >= 0 ? *tdgbl->mvol_io_ptr++ : 255);
 }
 
@@ -100,10 +105,89 @@ static int   get_text(UCHAR*, SSHORT);
 static void  prompt_for_name(SCHAR*, int);
 static void  put_asciz(SCHAR, const SCHAR*);
 static void  put_numeric(SCHAR, int);
-static bool  read_header(DESC, ULONG*, USHORT*, bool);
+static bool  read_header(DESC, ULONG*, USHORT*, bool, ULONG*);
 static bool  write_header(DESC, ULONG, bool);
 static DESC	 next_volume(DESC, ULONG, bool);
 static void	 mvol_read(int*, UCHAR**);
+static void  zip_fini();
+static void  zip_init(ULONG, bool);
+static void  zip_flush(ULONG);
+static int   zip_read(int*, UCHAR**);
+static void  zip_get(UCHAR*, ULONG);
+static void  zip_put(const UCHAR*, ULONG);
+
+
+#ifdef HAVE_ZLIB_H
+using Firebird::zlib;
+using Firebird::ZLib;
+#endif
+
+// When backup is compressed, data are split into blocks of up to ZIP_BLOCK_SIZE
+// bytes, compressed independently. Each block is preceded by its length,
+// compressed length and crc32 of its data. When compression doesn't make
+// the block shorter it's stored as is, with both lengths equal.
+
+const ULONG ZIP_BLOCK_SIZE	= 256 * 1024;
+const ULONG ZIP_HEADER_SIZE	= 3 * sizeof(ULONG);
+
+class BackupZip
+{
+public:
+	BackupZip(ULONG blockSize, bool compress);
+	~BackupZip();
+
+	UCHAR*		zip_data;		// uncompressed data of the current block
+	ULONG		zip_size;		// block size
+	UCHAR*		zip_packed;		// compressed data of the current block
+	ULONG		zip_packed_size;
+#ifdef HAVE_ZLIB_H
+	z_stream	zip_stream;
+#endif
+	bool		zip_compress;
+	int			zip_raw_cnt;	// position in the backup file buffer
+	UCHAR*		zip_raw_ptr;
+};
+
+#ifdef HAVE_ZLIB_H
+BackupZip::BackupZip(ULONG blockSize, bool compress)
+	: zip_data(NULL), zip_size(blockSize), zip_packed(NULL), zip_packed_size(0),
+	  zip_compress(compress), zip_raw_cnt(0), zip_raw_ptr(NULL)
+{
+	memset(&zip_stream, 0, sizeof(zip_stream));
+	zip_stream.zalloc = ZLib::allocFunc;
+	zip_stream.zfree = ZLib::freeFunc;
+	zip_stream.opaque = Z_NULL;
+
+	const int ret = zip_compress ?
+		zlib().deflateInit(&zip_stream, Z_DEFAULT_COMPRESSION) : zlib().inflateInit(&zip_stream);
+
+	if (ret != Z_OK)
+	{
+		BURP_error(375, true);
+		// msg 375 zlib library is not available, backup file can not be compressed or decompressed
+	}
+
+	// Block is never stored longer than its data, but deflate may need more
+	zip_packed_size = zip_compress ? zlib().deflateBound(&zip_stream, zip_size) : zip_size;
+	zip_data = BURP_alloc(zip_size);
+	zip_packed = BURP_alloc(zip_packed_size);
+}
+
+BackupZip::~BackupZip()
+{
+	if (zip_compress)
+		zlib().deflateEnd(&zip_stream);
+	else
+		zlib().inflateEnd(&zip_stream);
+
+	BURP_free(zip_data);
+	BURP_free(zip_packed);
+}
+#else
+BackupZip::~BackupZip()
+{
+}
+#endif // HAVE_ZLIB_H
 
 
 //____________________________________________________________
@@ -127,6 +211,7 @@ FB_UINT64 MVOL_fini_read()
 	}
 
 	tdgbl->file_desc = INVALID_HANDLE_VALUE;
+	zip_fini();
 	BURP_free(tdgbl->mvol_io_buffer);
 	tdgbl->mvol_io_buffer = NULL;
 	tdgbl->io_cnt = 0;
@@ -142,7 +227,15 @@ FB_UINT64 MVOL_fini_write(int* io_cnt, UCHAR** io_ptr)
 {
 	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
 
-	MVOL_write(rec_end, io_cnt, io_ptr);
+	if (tdgbl->mvol_zip)
+	{
+		zip_flush(*io_ptr - tdgbl->mvol_zip->zip_data);
+		raw_write(rec_end, &tdgbl->mvol_zip->zip_raw_cnt, &tdgbl->mvol_zip->zip_raw_ptr);
+		zip_fini();
+	}
+	else
+		MVOL_write(rec_end, io_cnt, io_ptr);
+
 	flush_platf(tdgbl->file_desc);
 
 	if (!tdgbl->stdIoMode)
@@ -204,7 +297,8 @@ void MVOL_init_read(const char* file_name, USHORT* format, int* cnt, UCHAR** ptr
 	tdgbl->mvol_io_buffer = BURP_alloc(temp_buffer_size);
 	tdgbl->gbl_backup_start_time[0] = 0;
 
-	read_header(tdgbl->file_desc, &temp_buffer_size, format, true);
+	ULONG zip_block_size = 0;
+	read_header(tdgbl->file_desc, &temp_buffer_size, format, true, &zip_block_size);
 
 	if (temp_buffer_size > tdgbl->mvol_actual_buffer_size)
 	{
@@ -216,6 +310,17 @@ void MVOL_init_read(const char* file_name, USHORT* format, int* cnt, UCHAR** ptr
 	}
 
 	tdgbl->mvol_actual_buffer_size = tdgbl->mvol_io_buffer_size = temp_buffer_size;
+
+	if (zip_block_size)
+	{
+		zip_init(zip_block_size, false);
+
+		// First read from the caller's buffer will decompress the first block
+		*cnt = 0;
+		*ptr = tdgbl->mvol_zip->zip_data;
+		return;
+	}
+
 	*cnt = tdgbl->mvol_io_cnt;
 	*ptr = tdgbl->mvol_io_ptr;
 }
@@ -259,6 +364,15 @@ void MVOL_init_write(const char* file_name, int* cnt, UCHAR** ptr)
 
 	tdgbl->mvol_actual_buffer_size = temp_buffer_size;
 
+	if (tdgbl->gbl_sw_zip)
+	{
+		zip_init(ZIP_BLOCK_SIZE, true);
+
+		*cnt = tdgbl->mvol_zip->zip_size;
+		*ptr = tdgbl->mvol_zip->zip_data;
+		return;
+	}
+
 	*cnt = tdgbl->mvol_io_cnt;
 	*ptr = tdgbl->mvol_io_ptr;
 }
@@ -266,12 +380,27 @@ void MVOL_init_write(const char* file_name, int* cnt, UCHAR** ptr)
 
 //____________________________________________________________
 //
-// Read a buffer's worth of data. (common)
+// Read a buffer's worth of data, decompressing it if needed.
 //
 int MVOL_read(int* cnt, UCHAR** ptr)
 {
 	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
 
+	if (tdgbl->mvol_zip)
+		return zip_read(cnt, ptr);
+
+	return raw_read(cnt, ptr);
+}
+
+
+//____________________________________________________________
+//
+// Read a buffer's worth of data from backup file. (common)
+//
+static int raw_read(int* cnt, UCHAR** ptr)
+{
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+
 	if (tdgbl->stdIoMode && tdgbl->uSvc->isService())
 	{
 		tdgbl->uSvc->started();
@@ -524,9 +653,34 @@ DESC MVOL_open(const char* name, ULONG mode, ULONG create)
 
 //____________________________________________________________
 //
-// Write a buffer's worth of data.
+// Write a buffer's worth of data, compressing it if needed.
 //
 UCHAR MVOL_write(const UCHAR c, int* io_cnt, UCHAR** io_ptr)
+{
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+
+	if (tdgbl->mvol_zip)
+	{
+		BackupZip* const zip = tdgbl->mvol_zip;
+
+		zip_flush(*io_ptr - zip->zip_data);
+
+		zip->zip_data[0] = c;
+		*io_ptr = zip->zip_data + 1;
+		*io_cnt = zip->zip_size - 1;
+
+		return c;
+	}
+
+	return raw_write(c, io_cnt, io_ptr);
+}
+
+
+//____________________________________________________________
+//
+// Write a buffer's worth of data to backup file.
+//
+static UCHAR raw_write(const UCHAR c, int* io_cnt, UCHAR** io_ptr)
 {
 	const UCHAR* ptr;
 	ULONG cnt = 0;
@@ -953,7 +1107,7 @@ static DESC next_volume( DESC handle, ULONG mode, bool full_buffer)
 
 			ULONG temp_buffer_size;
 			USHORT format;
-			if (!read_header(new_desc, &temp_buffer_size, &format, false))
+			if (!read_header(new_desc, &temp_buffer_size, &format, false, NULL))
 			{
 				BURP_print(true, 224, new_file);
 				continue;
@@ -1115,7 +1269,8 @@ static void put_numeric( SCHAR attribute, int value)
 //
 // Functional description
 //
-static bool read_header(DESC handle, ULONG* buffer_size, USHORT* format, bool init_flag)
+static bool read_header(DESC handle, ULONG* buffer_size, USHORT* format, bool init_flag,
+	ULONG* zip_block_size)
 {
 	TEXT buffer[MAX_FILE_NAME_SIZE], msg[BURP_MSG_GET_SIZE];
 
@@ -1257,6 +1412,12 @@ static bool read_header(DESC handle, ULONG* buffer_size, USHORT* format, bool in
 			}
 			break;
 
+		case att_backup_zip:
+			temp = get_numeric();
+			if (init_flag && zip_block_size)
+				*zip_block_size = temp;
+			break;
+
 		case att_backup_volume:
 			temp = get_numeric();
 			if (temp != tdgbl->mvol_volume_count)
@@ -1289,7 +1450,8 @@ static bool write_header(DESC handle, ULONG backup_buffer_size, bool full_buffer
 		tdgbl->mvol_io_header = tdgbl->mvol_io_buffer;
 
 		put(tdgbl, rec_burp);
-		put_numeric(att_backup_format, ATT_BACKUP_FORMAT);
+		put_numeric(att_backup_format,
+			tdgbl->gbl_sw_zip ? ATT_BACKUP_FORMAT : ATT_BACKUP_FORMAT_NO_ZIP);
 
 		if (tdgbl->gbl_sw_compress)
 			put_numeric(att_backup_compress, 1);
@@ -1299,6 +1461,9 @@ static bool write_header(DESC handle, ULONG backup_buffer_size, bool full_buffer
 
 		put_numeric(att_backup_blksize, backup_buffer_size);
 
+		if (tdgbl->gbl_sw_zip)
+			put_numeric(att_backup_zip, ZIP_BLOCK_SIZE);
+
 		tdgbl->mvol_io_volume = tdgbl->mvol_io_ptr + 2;
 		put_numeric(att_backup_volume, tdgbl->mvol_volume_count);
 
@@ -1438,3 +1603,208 @@ bool MVOL_split_hdr_read()
 
 	return false;
 }
+
+
+//____________________________________________________________
+//
+// Start (de)compression of backup data
+//
+static void zip_init(ULONG block_size, bool compress)
+{
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+
+#ifdef HAVE_ZLIB_H
+	if (zlib() && block_size)
+	{
+		BackupZip* const zip = FB_NEW_POOL(*getDefaultMemoryPool()) BackupZip(block_size, compress);
+
+		// Compressed blocks continue the backup file buffer after the header
+		zip->zip_raw_cnt = tdgbl->mvol_io_cnt;
+		zip->zip_raw_ptr = tdgbl->mvol_io_ptr;
+		tdgbl->mvol_zip = zip;
+		return;
+	}
+#endif
+
+	BURP_error(375, true);
+	// msg 375 zlib library is not available, backup file can not be compressed or decompressed
+}
+
+
+//____________________________________________________________
+//
+// Release (de)compression data
+//
+static void zip_fini()
+{
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+
+	delete tdgbl->mvol_zip;
+	tdgbl->mvol_zip = NULL;
+}
+
+
+//____________________________________________________________
+//
+// Compress a block of data and put it into the backup file buffer
+//
+static void zip_flush(ULONG length)
+{
+#ifdef HAVE_ZLIB_H
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+	BackupZip* const zip = tdgbl->mvol_zip;
+
+	if (!length)
+		return;
+
+	z_stream& stream = zip->zip_stream;
+	zlib().deflateReset(&stream);
+	stream.next_in = zip->zip_data;
+	stream.avail_in = length;
+	stream.next_out = zip->zip_packed;
+	stream.avail_out = zip->zip_packed_size;
+
+	const UCHAR* block = zip->zip_packed;
+	ULONG packed_length = 0;
+
+	if (zlib().deflate(&stream, Z_FINISH) == Z_STREAM_END)
+		packed_length = stream.total_out;
+
+	if (!packed_length || packed_length >= length)
+	{
+		block = zip->zip_data;
+		packed_length = length;
+	}
+
+	UCHAR header[ZIP_HEADER_SIZE];
+	put_vax_long(header, length);
+	put_vax_long(header + sizeof(ULONG), packed_length);
+	put_vax_long(header + 2 * sizeof(ULONG), zlib().crc32(0, zip->zip_data, length));
+
+	zip_put(header, sizeof(header));
+	zip_put(block, packed_length);
+#endif
+}
+
+
+//____________________________________________________________
+//
+// Read the next block from the backup file and decompress it
+//
+static int zip_read(int* cnt, UCHAR** ptr)
+{
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+	BackupZip* const zip = tdgbl->mvol_zip;
+
+#ifdef HAVE_ZLIB_H
+	UCHAR header[ZIP_HEADER_SIZE];
+	zip_get(header, sizeof(header));
+
+	const ULONG length = gds__vax_integer(header, sizeof(ULONG));
+	const ULONG packed_length = gds__vax_integer(header + sizeof(ULONG), sizeof(ULONG));
+	const ULONG crc = gds__vax_integer(header + 2 * sizeof(ULONG), sizeof(ULONG));
+
+	if (!length || length > zip->zip_size || packed_length > length)
+	{
+		BURP_error(376, true);
+		// msg 376 compressed block is corrupted in backup file
+	}
+
+	if (packed_length == length)
+		zip_get(zip->zip_data, length);
+	else
+	{
+		zip_get(zip->zip_packed, packed_length);
+
+		z_stream& stream = zip->zip_stream;
+		zlib().inflateReset(&stream);
+		stream.next_in = zip->zip_packed;
+		stream.avail_in = packed_length;
+		stream.next_out = zip->zip_data;
+		stream.avail_out = zip->zip_size;
+
+		if (zlib().inflate(&stream, Z_FINISH) != Z_STREAM_END || stream.total_out != length)
+		{
+			BURP_error(376, true);
+			// msg 376 compressed block is corrupted in backup file
+		}
+	}
+
+	if (zlib().crc32(0, zip->zip_data, length) != crc)
+	{
+		BURP_error(376, true);
+		// msg 376 compressed block is corrupted in backup file
+	}
+
+	if (ptr)
+		*ptr = zip->zip_data + 1;
+	if (cnt)
+		*cnt = length - 1;
+
+	return zip->zip_data[0];
+#else
+	return 0;
+#endif
+}
+
+
+//____________________________________________________________
+//
+// Read a chunk of data from the backup file buffer
+// bypassing decompression.
+//
+static void zip_get(UCHAR* ptr, ULONG count)
+{
+#ifdef HAVE_ZLIB_H
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+	BackupZip* const zip = tdgbl->mvol_zip;
+
+	while (count)
+	{
+		if (zip->zip_raw_cnt <= 0)
+		{
+			*ptr++ = raw_read(&zip->zip_raw_cnt, &zip->zip_raw_ptr);
+			count--;
+			continue;
+		}
+
+		const ULONG n = MIN(count, (ULONG) zip->zip_raw_cnt);
+		memcpy(ptr, zip->zip_raw_ptr, n);
+		ptr += n;
+		count -= n;
+		zip->zip_raw_cnt -= n;
+		zip->zip_raw_ptr += n;
+	}
+#endif
+}
+
+
+//____________________________________________________________
+//
+// Write a chunk of data to the backup file buffer
+// bypassing compression.
+//
+static void zip_put(const UCHAR* ptr, ULONG count)
+{
+#ifdef HAVE_ZLIB_H
+	BurpGlobals* tdgbl = BurpGlobals::getSpecific();
+	BackupZip* const zip = tdgbl->mvol_zip;
+
+	while (count)
+	{
+		if (zip->zip_raw_cnt <= 0)
+		{
+			raw_write(*ptr++, &zip->zip_raw_cnt, &zip->zip_raw_ptr);
+			count--;
+			continue;
+		}
+
+		const ULONG n = MIN(count, (ULONG) zip->zip_raw_cnt);
+		memcpy(zip->zip_raw_ptr, ptr, n);
+		ptr += n;
+		count -= n;
+		zip->zip_raw_cnt -= n;
+		zip->zip_raw_ptr += n;
+	}
+#endif
+}
@@ -43,7 +43,8 @@ namespace
 	{
 		TextTypeImpl(charset* a_cs, UnicodeUtil::Utf16Collation* a_collation)
 			: cs(a_cs),
-			  collation(a_collation)
+			  collation(a_collation),
+			  asciiIdentity(isAsciiIdentity(a_cs))
 		{
 		}
 
@@ -55,8 +56,82 @@ namespace
 			delete collation;
 		}
 
+		ULONG toUtf16(ULONG srcLen, const UCHAR* src,
+			Firebird::HalfStaticArray<UCHAR, BUFFER_SMALL>& utf16Str) const
+		{
+			// ASCII text of a charset that maps ASCII to itself is just widened
+			if (asciiIdentity)
+			{
+				const UCHAR* const end = src + srcLen;
+				const UCHAR* p = src;
+
+				while (p < end && *p < 0x80)
+					++p;
+
+				if (p == end)
+				{
+					USHORT* dst = reinterpret_cast<USHORT*>(utf16Str.getBuffer(srcLen * sizeof(USHORT)));
+
+					for (p = src; p < end; ++p)
+						*dst++ = *p;
+
+					return srcLen * sizeof(USHORT);
+				}
+			}
+
+			USHORT errorCode;
+			ULONG offendingPos;
+
+			utf16Str.getBuffer(
+				cs->charset_to_unicode.csconvert_fn_convert(
+					&cs->charset_to_unicode,
+					srcLen,
+					src,
+					0,
+					NULL,
+					&errorCode,
+					&offendingPos));
+
+			return cs->charset_to_unicode.csconvert_fn_convert(
+				&cs->charset_to_unicode,
+				srcLen,
+				src,
+				utf16Str.getCapacity(),
+				utf16Str.begin(),
+				&errorCode,
+				&offendingPos);
+		}
+
 		charset* cs;
 		UnicodeUtil::Utf16Collation* collation;
+		const bool asciiIdentity;
+
+	private:
+		static bool isAsciiIdentity(charset* cs)
+		{
+			if (cs->charset_min_bytes_per_char != 1)
+				return false;
+
+			UCHAR ascii[0x80];
+			USHORT expected[0x80], utf16[0x80];
+
+			for (unsigned i = 0; i < 0x80; ++i)
+				expected[i] = ascii[i] = (UCHAR) i;
+
+			USHORT errorCode;
+			ULONG offendingPos;
+
+			const ULONG len = cs->charset_to_unicode.csconvert_fn_convert(
+				&cs->charset_to_unicode,
+				sizeof(ascii),
+				ascii,
+				sizeof(utf16),
+				reinterpret_cast<UCHAR*>(utf16),
+				&errorCode,
+				&offendingPos);
+
+			return len == sizeof(utf16) && memcmp(utf16, expected, sizeof(utf16)) == 0;
+		}
 	};
 }
 
@@ -767,30 +842,8 @@ static USHORT unicodeStrToKey(texttype* tt, USHORT srcLen, const UCHAR* src,
 
 	try
 	{
-		charset* cs = impl->cs;
-
 		HalfStaticArray<UCHAR, BUFFER_SMALL> utf16Str;
-		USHORT errorCode;
-		ULONG offendingPos;
-
-		utf16Str.getBuffer(
-			cs->charset_to_unicode.csconvert_fn_convert(
-				&cs->charset_to_unicode,
-				srcLen,
-				src,
-				0,
-				NULL,
-				&errorCode,
-				&offendingPos));
-
-		ULONG utf16Len = cs->charset_to_unicode.csconvert_fn_convert(
-			&cs->charset_to_unicode,
-			srcLen,
-			src,
-			utf16Str.getCapacity(),
-			utf16Str.begin(),
-			&errorCode,
-			&offendingPos);
+		const ULONG utf16Len = impl->toUtf16(srcLen, src, utf16Str);
 
 		return impl->collation->stringToKey(utf16Len, (USHORT*)utf16Str.begin(), dstLen, dst, keyType);
 	}
@@ -811,50 +864,15 @@ static SSHORT unicodeCompare(texttype* tt, ULONG len1, const UCHAR* str1,
 	{
 		*errorFlag = false;
 
-		charset* cs = impl->cs;
+		// Identical strings are equal in any collation
+		if (len1 == len2 && memcmp(str1, str2, len1) == 0)
+			return 0;
 
 		HalfStaticArray<UCHAR, BUFFER_SMALL> utf16Str1;
 		HalfStaticArray<UCHAR, BUFFER_SMALL> utf16Str2;
-		USHORT errorCode;
-		ULONG offendingPos;
 
-		utf16Str1.getBuffer(
-			cs->charset_to_unicode.csconvert_fn_convert(
-				&cs->charset_to_unicode,
-				len1,
-				str1,
-				0,
-				NULL,
-				&errorCode,
-				&offendingPos));
-
-		const ULONG utf16Len1 = cs->charset_to_unicode.csconvert_fn_convert(
-			&cs->charset_to_unicode,
-			len1,
-			str1,
-			utf16Str1.getCapacity(),
-			utf16Str1.begin(),
-			&errorCode,
-			&offendingPos);
-
-		utf16Str2.getBuffer(
-			cs->charset_to_unicode.csconvert_fn_convert(
-				&cs->charset_to_unicode,
-				len2,
-				str2,
-				0,
-				NULL,
-				&errorCode,
-				&offendingPos));
-
-		const ULONG utf16Len2 = cs->charset_to_unicode.csconvert_fn_convert(
-			&cs->charset_to_unicode,
-			len2,
-			str2,
-			utf16Str2.getCapacity(),
-			utf16Str2.begin(),
-			&errorCode,
-			&offendingPos);
+		const ULONG utf16Len1 = impl->toUtf16(len1, str1, utf16Str1);
+		const ULONG utf16Len2 = impl->toUtf16(len2, str2, utf16Str2);
 
 		return impl->collation->compare(utf16Len1, (USHORT*)utf16Str1.begin(),
 			utf16Len2, (USHORT*)utf16Str2.begin(), errorFlag);
@@ -873,30 +891,8 @@ static ULONG unicodeCanonical(texttype* tt, ULONG srcLen, const UCHAR* src, ULON
 
 	try
 	{
-		charset* cs = impl->cs;
-
 		HalfStaticArray<UCHAR, BUFFER_SMALL> utf16Str;
-		USHORT errorCode;
-		ULONG offendingPos;
-
-		utf16Str.getBuffer(
-			cs->charset_to_unicode.csconvert_fn_convert(
-				&cs->charset_to_unicode,
-				srcLen,
-				src,
-				0,
-				NULL,
-				&errorCode,
-				&offendingPos));
-
-		const ULONG utf16Len = cs->charset_to_unicode.csconvert_fn_convert(
-			&cs->charset_to_unicode,
-			srcLen,
-			src,
-			utf16Str.getCapacity(),
-			utf16Str.begin(),
-			&errorCode,
-			&offendingPos);
+		const ULONG utf16Len = impl->toUtf16(srcLen, src, utf16Str);
 
 		return impl->collation->canonical(
 			utf16Len, Firebird::Aligner<USHORT>(utf16Str.begin(), utf16Len),
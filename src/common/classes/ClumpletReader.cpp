@@ -341,6 +341,7 @@ ClumpletReader::ClumpletType ClumpletReader::getClumpletType(UCHAR tag) const
 			case isc_spb_res_length:
 			case isc_spb_res_buffers:
 			case isc_spb_res_page_size:
+			case isc_spb_res_parallel:
 			case isc_spb_options:
 			case isc_spb_verbint:
 				return IntSpb;
@@ -428,6 +429,8 @@ ClumpletReader::ClumpletType ClumpletReader::getClumpletType(UCHAR tag) const
 			case isc_spb_sts_table:
 				return StringSpb;
 			case isc_spb_options:
+			case isc_spb_sts_sample:
+			case isc_spb_sts_parallel:
 				return IntSpb;
 			}
 			invalid_structure("unknown parameter for getting statistics");
@@ -473,6 +476,7 @@ ClumpletReader::ClumpletType ClumpletReader::getClumpletType(UCHAR tag) const
 			case isc_spb_dbname:
 				return StringSpb;
 			case isc_spb_val_lock_timeout:
+			case isc_spb_val_parallel:
 				return IntSpb;
 			}
 			break;
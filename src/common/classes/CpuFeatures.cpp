@@ -0,0 +1,126 @@
+/*
+ *	PROGRAM:	Common Library
+ *	MODULE:		CpuFeatures.cpp
+ *	DESCRIPTION:	Runtime detection of processor extensions
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include "../common/classes/CpuFeatures.h"
+
+#if defined(FB_CPU_SSE2) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace
+{
+#ifdef FB_CPU_SSE2
+
+	bool AVX2Supported()
+	{
+		const unsigned bit_OSXSAVE_ = 1 << 27;
+		const unsigned bit_AVX_ = 1 << 28;
+		const unsigned bit_AVX2_ = 1 << 5;
+
+#ifdef _MSC_VER
+		int flags[4];
+		__cpuid(flags, 0);
+		if (flags[0] < 7)
+			return false;
+
+		__cpuid(flags, 1);
+		if ((flags[2] & (bit_OSXSAVE_ | bit_AVX_)) != (bit_OSXSAVE_ | bit_AVX_))
+			return false;
+
+		// OS must save YMM registers on context switch
+		if ((_xgetbv(0) & 6) != 6)
+			return false;
+
+		__cpuidex(flags, 7, 0);
+		return (flags[1] & bit_AVX2_) != 0;
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (__get_cpuid_max(0, NULL) < 7)
+			return false;
+
+		__cpuid(1, eax, ebx, ecx, edx);
+		if ((ecx & (bit_OSXSAVE_ | bit_AVX_)) != (bit_OSXSAVE_ | bit_AVX_))
+			return false;
+
+		// OS must save YMM registers on context switch
+		__asm__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+		if ((eax & 6) != 6)
+			return false;
+
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		return (ebx & bit_AVX2_) != 0;
+#endif
+	}
+
+	bool AESNISupported()
+	{
+		const unsigned bit_AES_ = 1 << 25;
+
+#ifdef _MSC_VER
+		int flags[4];
+		__cpuid(flags, 1);
+		return (flags[2] & bit_AES_) != 0;
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
+
+		return (ecx & bit_AES_) != 0;
+#endif
+	}
+
+#else	// FB_CPU_SSE2
+
+	bool AVX2Supported()
+	{
+		return false;
+	}
+
+	bool AESNISupported()
+	{
+		return false;
+	}
+
+#endif	// FB_CPU_SSE2
+} // namespace
+
+namespace Firebird {
+
+bool cpuSupportsAVX2()
+{
+	static const bool avx2 = AVX2Supported();
+	return avx2;
+}
+
+bool cpuSupportsAESNI()
+{
+	static const bool aesni = AESNISupported();
+	return aesni;
+}
+
+} // namespace Firebird
@@ -0,0 +1,71 @@
+/*
+ *	PROGRAM:	Common Library
+ *	MODULE:		CpuFeatures.h
+ *	DESCRIPTION:	Runtime detection of processor extensions
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#ifndef CLASSES_CPU_FEATURES_H
+#define CLASSES_CPU_FEATURES_H
+
+// SSE2 is always present on x86-64, so vector code for it needs no checks.
+// Functions using wider extensions must be marked with FB_TARGET_AVX2
+// and called only when cpuSupportsAVX2() returns true. The same applies
+// to AES instructions, FB_TARGET_AESNI and cpuSupportsAESNI().
+
+#if (defined(_M_X64) && _MSC_VER >= 1700) || defined(__x86_64__)
+#define FB_CPU_SSE2
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FB_TARGET_AVX2
+#define FB_TARGET_AESNI
+#else
+#define FB_TARGET_AVX2 __attribute__((target("avx2")))
+#define FB_TARGET_AESNI __attribute__((target("aes")))
+#endif
+#endif
+
+namespace Firebird
+{
+	bool cpuSupportsAVX2();
+	bool cpuSupportsAESNI();
+
+#ifdef FB_CPU_SSE2
+	// Index of the lowest set bit, mask must not be zero
+	inline unsigned lowestBit(unsigned mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+#endif
+} // namespace Firebird
+
+#endif // CLASSES_CPU_FEATURES_H
@@ -0,0 +1,72 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2017 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../common/classes/zip.h"
+
+#if defined(HAVE_ZLIB_H)
+
+namespace Firebird {
+
+InitInstance<ZLib> zlib;
+
+ZLib::ZLib(MemoryPool&)
+{
+#ifdef WIN_NT
+	const char* name = "zlib1.dll";
+#else
+	const char* name = "libz." SHRLIB_EXT ".1";
+#endif
+	z.reset(ModuleLoader::fixAndLoadModule(name));
+	if (z)
+		symbols();
+}
+
+void ZLib::symbols()
+{
+#define FB_ZSYMB(A) z->findSymbol(STRINGIZE(A), A); if (!A) { z.reset(NULL); return; }
+	FB_ZSYMB(deflateInit_)
+	FB_ZSYMB(inflateInit_)
+	FB_ZSYMB(deflate)
+	FB_ZSYMB(inflate)
+	FB_ZSYMB(deflateReset)
+	FB_ZSYMB(inflateReset)
+	FB_ZSYMB(deflateEnd)
+	FB_ZSYMB(inflateEnd)
+	FB_ZSYMB(deflateBound)
+	FB_ZSYMB(crc32)
+#undef FB_ZSYMB
+}
+
+void* ZLib::allocFunc(void*, uInt items, uInt size)
+{
+	return MemoryPool::globalAlloc(items * size ALLOC_ARGS);
+}
+
+void ZLib::freeFunc(void*, void* address)
+{
+	MemoryPool::globalFree(address);
+}
+
+} // namespace Firebird
+
+#endif // HAVE_ZLIB_H
@@ -0,0 +1,72 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2017 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef COMMON_CLASSES_ZIP_H
+#define COMMON_CLASSES_ZIP_H
+
+#if defined(HAVE_ZLIB_H)
+
+#include <zlib.h>
+
+#include "../common/classes/init.h"
+#include "../common/classes/auto.h"
+#include "../common/os/mod_loader.h"
+
+namespace Firebird {
+
+// zlib is loaded at runtime, when it's missing compression is just not available
+class ZLib
+{
+public:
+	explicit ZLib(MemoryPool&);
+
+	int ZEXPORT (*deflateInit_)(z_stream* strm, int level, const char *version, int stream_size);
+	int ZEXPORT (*inflateInit_)(z_stream* strm, const char *version, int stream_size);
+	int ZEXPORT (*deflate)(z_stream* strm, int flush);
+	int ZEXPORT (*inflate)(z_stream* strm, int flush);
+	int ZEXPORT (*deflateReset)(z_stream* strm);
+	int ZEXPORT (*inflateReset)(z_stream* strm);
+	void ZEXPORT (*deflateEnd)(z_stream* strm);
+	void ZEXPORT (*inflateEnd)(z_stream* strm);
+	uLong ZEXPORT (*deflateBound)(z_stream* strm, uLong sourceLen);
+	uLong ZEXPORT (*crc32)(uLong crc, const Bytef* buf, uInt len);
+
+	operator bool() { return z.hasData(); }
+	bool operator!() { return !z.hasData(); }
+
+	// Memory management routines for z_stream
+	static void* allocFunc(void*, uInt items, uInt size);
+	static void freeFunc(void*, void* address);
+
+private:
+	AutoPtr<ModuleLoader::Module> z;
+
+	void symbols();
+};
+
+extern InitInstance<ZLib> zlib;
+
+} // namespace Firebird
+
+#endif // HAVE_ZLIB_H
+
+#endif // COMMON_CLASSES_ZIP_H
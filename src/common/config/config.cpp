@@ -128,6 +128,9 @@ const char*	GCPolicyCooperative	= "cooperative";
 const char*	GCPolicyBackground	= "background";
 const char*	GCPolicyCombined	= "combined";
 
+const char*	RecordCompressionRLE	= "rle";
+const char*	RecordCompressionLZ		= "lz";
+
 
 const Config::ConfigEntry Config::entries[MAX_CONFIG_KEY] =
 {
@@ -202,7 +205,12 @@ const Config::ConfigEntry Config::entries[MAX_CONFIG_KEY] =
 	{TYPE_BOOLEAN,		"AllowEncryptedSecurityDatabase", (ConfigValue) false},
 	{TYPE_INTEGER,		"StatementTimeout",			(ConfigValue) 0},
 	{TYPE_INTEGER,		"ConnectionIdleTimeout",	(ConfigValue) 0},
-	{TYPE_INTEGER,		"ClientBatchBuffer",		(ConfigValue) (128 * 1024)}
+	{TYPE_INTEGER,		"ClientBatchBuffer",		(ConfigValue) (128 * 1024)},
+	{TYPE_STRING,		"RecordCompression",		(ConfigValue) "rle"},	// encoding of record data
+	{TYPE_INTEGER,		"CryptThreads",				(ConfigValue) 1},
+	{TYPE_BOOLEAN,		"TempCompression",			(ConfigValue) false},
+	{TYPE_BOOLEAN,		"TempAsyncIO",				(ConfigValue) false},
+	{TYPE_INTEGER,		"TempCacheQuota",			(ConfigValue) 0}			// bytes
 };
 
 /******************************************************************************
@@ -438,6 +446,22 @@ FB_UINT64 Config::getTempCacheLimit()
 	return v;
 }
 
+FB_UINT64 Config::getTempCacheQuota()
+{
+	const SINT64 v = (SINT64) getDefaultConfig()->values[KEY_TEMP_CACHE_QUOTA];
+	return v > 0 ? v : 0;
+}
+
+bool Config::getTempCompression()
+{
+	return (bool) getDefaultConfig()->values[KEY_TEMP_COMPRESSION];
+}
+
+bool Config::getTempAsyncIO()
+{
+	return (bool) getDefaultConfig()->values[KEY_TEMP_ASYNC_IO];
+}
+
 bool Config::getRemoteFileOpenAbility()
 {
 	return fb_utils::bootBuild() ? true : ((bool) getDefaultConfig()->values[KEY_REMOTE_FILE_OPEN_ABILITY]);
@@ -839,3 +863,19 @@ unsigned int Config::getClientBatchBuffer() const
 	return get<unsigned int>(KEY_CLIENT_BATCH_BUFFER);
 }
 
+const char* Config::getRecordCompression() const
+{
+	const char* rc = get<const char*>(KEY_RECORD_COMPRESSION);
+
+	if (rc && fb_utils::stricmp(rc, RecordCompressionLZ) == 0)
+		return RecordCompressionLZ;
+
+	// invalid value falls back to default
+	return RecordCompressionRLE;
+}
+
+int Config::getCryptThreads() const
+{
+	const int rc = get<int>(KEY_CRYPT_THREADS);
+	return MIN(MAX(rc, 1), 64);
+}
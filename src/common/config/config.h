@@ -69,6 +69,9 @@ extern const char*	GCPolicyCooperative;
 extern const char*	GCPolicyBackground;
 extern const char*	GCPolicyCombined;
 
+extern const char*	RecordCompressionRLE;
+extern const char*	RecordCompressionLZ;
+
 const int WIRE_CRYPT_DISABLED = 0;
 const int WIRE_CRYPT_ENABLED = 1;
 const int WIRE_CRYPT_REQUIRED = 2;
@@ -146,6 +149,11 @@ public:
 		KEY_STMT_TIMEOUT,
 		KEY_CONN_IDLE_TIMEOUT,
 		KEY_CLIENT_BATCH_BUFFER,
+		KEY_RECORD_COMPRESSION,
+		KEY_CRYPT_THREADS,
+		KEY_TEMP_COMPRESSION,
+		KEY_TEMP_ASYNC_IO,
+		KEY_TEMP_CACHE_QUOTA,
 		MAX_CONFIG_KEY		// keep it last
 	};
 
@@ -230,6 +238,15 @@ public:
 	// Caching limit for the temporary data
 	static FB_UINT64 getTempCacheLimit();
 
+	// Part of the temporary data cache an attachment may hold, zero if not limited
+	static FB_UINT64 getTempCacheQuota();
+
+	// Whether temporary data spilled to files is compressed
+	static bool getTempCompression();
+
+	// Whether temporary files are written behind and read ahead in background
+	static bool getTempAsyncIO();
+
 	// Whether remote (NFS) files can be opened
 	static bool getRemoteFileOpenAbility();
 
@@ -362,6 +379,12 @@ public:
 	unsigned int getConnIdleTimeout() const;
 
 	unsigned int getClientBatchBuffer() const;
+
+	// Encoding used to pack new record versions
+	const char* getRecordCompression() const;
+
+	// Number of threads changing database encryption
+	int getCryptThreads() const;
 };
 
 // Implementation of interface to access master configuration file
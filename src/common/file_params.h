@@ -37,6 +37,7 @@
 static const char* const EVENT_FILE		= "fb_event_%s";
 static const char* const LOCK_FILE		= "fb_lock_%s";
 static const char* const MONITOR_FILE	= "fb_monitor_%s";
+static const char* const TPC_FILE		= "fb_tpc_%s";
 static const char* const TRACE_FILE		= "fb" COMMON_FILE_PREFIX "_trace";
 static const char* const USER_MAP_FILE	= "fb" COMMON_FILE_PREFIX "_user_mapping";
 
@@ -1350,6 +1350,7 @@ UnicodeUtil::Utf16Collation* UnicodeUtil::Utf16Collation::create(
 	obj->contractions = contractions;
 	obj->contractionsCount = icu->usetGetItemCount(contractions);
 	obj->numericSort = isNumericSort;
+	obj->fastAscii = !isNumericSort && obj->buildAsciiRanks();
 
 	return obj;
 }
@@ -1511,6 +1512,14 @@ SSHORT UnicodeUtil::Utf16Collation::compare(ULONG len1, const USHORT* str1,
 		len2 = pad - str2 + 1;
 	}
 
+	if (fastAscii)
+	{
+		SSHORT result;
+
+		if (compareAscii(len1, str1, len2, str2, &result))
+			return result;
+	}
+
 	len1 *= sizeof(*str1);
 	len2 *= sizeof(*str2);
 
@@ -1617,4 +1626,119 @@ void UnicodeUtil::Utf16Collation::normalize(ULONG* strLen, const USHORT** str, b
 }
 
 
+// Build primary strength ranks of printable ASCII characters, used to compare
+// ASCII strings without calling ICU when they differ at the primary level.
+bool UnicodeUtil::Utf16Collation::buildAsciiRanks()
+{
+	memset(asciiRanks, 0, sizeof(asciiRanks));
+
+	// A contraction made of ASCII characters makes the per-character order useless
+	for (int i = 0; i < contractionsCount; ++i)
+	{
+		UChar str[32];
+		UErrorCode status = U_ZERO_ERROR;
+		const int len = icu->usetGetItem(contractions, i, NULL, NULL, str, FB_NELEM(str), &status);
+
+		if (U_FAILURE(status))
+			return false;
+
+		int j = 0;
+
+		while (j < len && str[j] < 0x80)
+			++j;
+
+		if (len > 0 && j == len)
+			return false;
+	}
+
+	UChar chars[0x7F - 0x20];
+	unsigned count = 0;
+
+	for (UChar c = 0x20; c < 0x7F; ++c)
+	{
+		// Characters ignorable at primary level are left to ICU
+		if (icu->ucolStrColl(partialCollator, &c, 1, NULL, 0) != UCOL_EQUAL)
+			chars[count++] = c;
+	}
+
+	// Insertion sort - it runs once per collation
+	for (unsigned i = 1; i < count; ++i)
+	{
+		const UChar c = chars[i];
+		unsigned j = i;
+
+		for (; j > 0 && icu->ucolStrColl(partialCollator, &c, 1, &chars[j - 1], 1) == UCOL_LESS; --j)
+			chars[j] = chars[j - 1];
+
+		chars[j] = c;
+	}
+
+	UCHAR rank = 0;
+
+	for (unsigned i = 0; i < count; ++i)
+	{
+		if (i == 0 || icu->ucolStrColl(partialCollator, &chars[i - 1], 1, &chars[i], 1) != UCOL_EQUAL)
+			++rank;
+
+		asciiRanks[chars[i]] = rank;
+	}
+
+	return count != 0;
+}
+
+
+// Compare strings made of ranked ASCII characters. Returns false when the
+// strings are not such or are equal at the primary level, so ICU should decide.
+bool UnicodeUtil::Utf16Collation::compareAscii(ULONG len1, const USHORT* str1,
+	ULONG len2, const USHORT* str2, SSHORT* result) const
+{
+	const ULONG len = MIN(len1, len2);
+	SSHORT primary = 0;
+	ULONG i = 0;
+
+	for (; i < len; ++i)
+	{
+		if (str1[i] >= 0x80 || str2[i] >= 0x80)
+			return false;
+
+		const UCHAR rank1 = asciiRanks[str1[i]];
+		const UCHAR rank2 = asciiRanks[str2[i]];
+
+		if (rank1 == 0 || rank2 == 0)
+			return false;
+
+		if (rank1 != rank2)
+		{
+			primary = rank1 < rank2 ? -1 : 1;
+			break;
+		}
+	}
+
+	// The rest of the strings should be ranked too, otherwise an ignorable
+	// or a non-ASCII character may change the result
+	for (ULONG j = i; j < len1; ++j)
+	{
+		if (str1[j] >= 0x80 || asciiRanks[str1[j]] == 0)
+			return false;
+	}
+
+	for (ULONG j = i; j < len2; ++j)
+	{
+		if (str2[j] >= 0x80 || asciiRanks[str2[j]] == 0)
+			return false;
+	}
+
+	if (primary == 0)
+	{
+		if (len1 == len2)
+			return false;
+
+		primary = len1 < len2 ? -1 : 1;
+	}
+
+	*result = primary;
+	return true;
+}
+
+
 }	// namespace Jrd
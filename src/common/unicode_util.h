@@ -179,6 +179,9 @@ public:
 
 		void normalize(ULONG* strLen, const USHORT** str, bool forNumericSort,
 			Firebird::HalfStaticArray<USHORT, BUFFER_SMALL / 2>& buffer) const;
+		bool buildAsciiRanks();
+		bool compareAscii(ULONG len1, const USHORT* str1, ULONG len2, const USHORT* str2,
+			SSHORT* result) const;
 
 		ICU* icu;
 		texttype* tt;
@@ -189,6 +192,8 @@ public:
 		USet* contractions;
 		int contractionsCount;
 		bool numericSort;
+		bool fastAscii;
+		UCHAR asciiRanks[128];	// primary order of ASCII characters, 0 - not ranked
 	};
 
 	friend class Utf16Collation;
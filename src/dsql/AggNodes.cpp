@@ -50,6 +50,20 @@ namespace Jrd {
 
 static RegisterNode<AggNode> regAggNode(blr_agg_function);
 
+// Sum accumulators that give the same result whatever the order of additions and subtractions.
+static inline bool isExactAccumulator(const impure_value_ex* impure)
+{
+	switch (impure->vlu_desc.dsc_dtype)
+	{
+		case dtype_long:
+		case dtype_int64:
+		case dtype_dec_fixed:
+			return true;
+	}
+
+	return false;
+}
+
 AggNode::Factory* AggNode::factories = NULL;
 
 AggNode::AggNode(MemoryPool& pool, const AggInfo& aAggInfo, bool aDistinct, bool aDialect1,
@@ -412,6 +426,26 @@ bool AggNode::aggPass(thread_db* tdbb, jrd_req* request) const
 	return true;
 }
 
+bool AggNode::aggRetract(thread_db* tdbb, jrd_req* request) const
+{
+	// Values were put in a sort, there is no way to take them back.
+	if (distinct)
+		return false;
+
+	dsc* desc = NULL;
+
+	if (arg)
+	{
+		desc = EVL_expr(tdbb, request, arg);
+
+		// NULLs were ignored by aggPass, so there is nothing to undo.
+		if (request->req_flags & req_null)
+			return true;
+	}
+
+	return aggRetract(tdbb, request, desc);
+}
+
 void AggNode::aggFinish(thread_db* /*tdbb*/, jrd_req* request) const
 {
 	if (asb)
@@ -665,6 +699,20 @@ void AvgAggNode::aggPass(thread_db* /*tdbb*/, jrd_req* request, dsc* desc) const
 		ArithmeticNode::add2(desc, impure, this, blr_add);
 }
 
+bool AvgAggNode::aggRetract(thread_db* /*tdbb*/, jrd_req* request, dsc* desc) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	// Only exact accumulators may be subtracted without drifting from the recomputed value.
+	if (dialect1 || !isExactAccumulator(impure))
+		return false;
+
+	--impure->vlux_count;
+	ArithmeticNode::add2(desc, impure, this, blr_subtract);
+
+	return isExactAccumulator(impure);
+}
+
 dsc* AvgAggNode::aggExecute(thread_db* tdbb, jrd_req* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -939,6 +987,18 @@ void CountAggNode::aggPass(thread_db* /*tdbb*/, jrd_req* request, dsc* /*desc*/)
 		++impure->vlu_misc.vlu_int64;
 }
 
+bool CountAggNode::aggRetract(thread_db* /*tdbb*/, jrd_req* request, dsc* /*desc*/) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	if (dialect1)
+		--impure->vlu_misc.vlu_long;
+	else
+		--impure->vlu_misc.vlu_int64;
+
+	return true;
+}
+
 dsc* CountAggNode::aggExecute(thread_db* /*tdbb*/, jrd_req* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -1191,6 +1251,24 @@ void SumAggNode::aggPass(thread_db* /*tdbb*/, jrd_req* request, dsc* desc) const
 		ArithmeticNode::add2(desc, impure, this, blr_add);
 }
 
+bool SumAggNode::aggRetract(thread_db* /*tdbb*/, jrd_req* request, dsc* desc) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	// Only exact accumulators may be subtracted without drifting from the recomputed value.
+	if (!isExactAccumulator(impure))
+		return false;
+
+	--impure->vlux_count;
+
+	if (dialect1)
+		ArithmeticNode::add(desc, impure, this, blr_subtract);
+	else
+		ArithmeticNode::add2(desc, impure, this, blr_subtract);
+
+	return isExactAccumulator(impure);
+}
+
 dsc* SumAggNode::aggExecute(thread_db* /*tdbb*/, jrd_req* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
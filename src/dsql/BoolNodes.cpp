@@ -55,6 +55,60 @@ static const int MAX_MEMBER_LIST = 1500;
 static const int TEMP_LENGTH = 128;
 
 
+// Get the compiled SIMILAR TO matcher of an invariant node. Invariants are recomputed at every
+// request start, so a trigger checking its input with SIMILAR TO used to compile the same
+// pattern for every row. Keep the pattern, escape and text type the matcher was built for in
+// the impure string and only compile a new one when they change.
+static PatternMatcher* getSimilarToMatcher(thread_db* tdbb, impure_value* impure, USHORT ttype,
+	Collation* obj, const UCHAR* pattern, SLONG patternLen, const UCHAR* escape, USHORT escapeLen)
+{
+	const ULONG keyLength = sizeof(USHORT) * 2 + escapeLen + patternLen;
+	VaryingString* key = impure->vlu_string;
+	PatternMatcher* evaluator = impure->vlu_misc.vlu_invariant;
+
+	if (evaluator && key && key->str_length == keyLength)
+	{
+		const UCHAR* p = key->str_data;
+
+		if (memcmp(p, &ttype, sizeof(USHORT)) == 0 &&
+			memcmp(p + sizeof(USHORT), &escapeLen, sizeof(USHORT)) == 0 &&
+			memcmp(p + sizeof(USHORT) * 2, escape, escapeLen) == 0 &&
+			memcmp(p + sizeof(USHORT) * 2 + escapeLen, pattern, patternLen) == 0)
+		{
+			evaluator->reset();
+			return evaluator;
+		}
+	}
+
+	delete evaluator;
+	impure->vlu_misc.vlu_invariant = NULL;
+
+	delete key;
+	impure->vlu_string = NULL;
+
+	evaluator = obj->createSimilarToMatcher(*tdbb->getDefaultPool(),
+		pattern, patternLen, escape, escapeLen);
+	impure->vlu_misc.vlu_invariant = evaluator;
+
+	if (keyLength <= MAX_USHORT)
+	{
+		key = impure->vlu_string = FB_NEW_RPT(*tdbb->getDefaultPool(), keyLength) VaryingString();
+		key->str_length = keyLength;
+
+		UCHAR* p = key->str_data;
+		memcpy(p, &ttype, sizeof(USHORT));
+		p += sizeof(USHORT);
+		memcpy(p, &escapeLen, sizeof(USHORT));
+		p += sizeof(USHORT);
+		memcpy(p, escape, escapeLen);
+		p += escapeLen;
+		memcpy(p, pattern, patternLen);
+	}
+
+	return evaluator;
+}
+
+
 //--------------------
 
 
@@ -944,18 +998,18 @@ bool ComparativeBoolNode::stringBoolean(thread_db* tdbb, jrd_req* request, dsc*
 
 				if (!(impure->vlu_flags & VLU_computed))
 				{
-					delete impure->vlu_misc.vlu_invariant;
 					impure->vlu_flags |= VLU_computed;
 
 					if (blrOp == blr_like)
 					{
+						delete impure->vlu_misc.vlu_invariant;
 						impure->vlu_misc.vlu_invariant = evaluator = obj->createLikeMatcher(
 							*tdbb->getDefaultPool(), p2, l2, escape_str, escape_length);
 					}
 					else	// nod_similar
 					{
-						impure->vlu_misc.vlu_invariant = evaluator = obj->createSimilarToMatcher(
-							*tdbb->getDefaultPool(), p2, l2, escape_str, escape_length);
+						evaluator = getSimilarToMatcher(tdbb, impure, type1, obj,
+							p2, l2, escape_str, escape_length);
 					}
 				}
 				else
@@ -1151,18 +1205,18 @@ bool ComparativeBoolNode::stringFunction(thread_db* tdbb, jrd_req* request,
 
 			if (!(impure->vlu_flags & VLU_computed))
 			{
-				delete impure->vlu_misc.vlu_invariant;
 				impure->vlu_flags |= VLU_computed;
 
 				if (blrOp == blr_like)
 				{
+					delete impure->vlu_misc.vlu_invariant;
 					impure->vlu_misc.vlu_invariant = evaluator = obj->createLikeMatcher(
 						*tdbb->getDefaultPool(), p2, l2, escape_str, escape_length);
 				}
 				else	// nod_similar
 				{
-					impure->vlu_misc.vlu_invariant = evaluator = obj->createSimilarToMatcher(
-						*tdbb->getDefaultPool(), p2, l2, escape_str, escape_length);
+					evaluator = getSimilarToMatcher(tdbb, impure, ttype, obj,
+						p2, l2, escape_str, escape_length);
 				}
 			}
 			else
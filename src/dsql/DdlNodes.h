@@ -1050,7 +1050,7 @@ public:
 	}
 
 	static SSHORT store(thread_db* tdbb, jrd_tra* transaction, const Firebird::MetaName& name,
-		fb_sysflag sysFlag, SINT64 value, SLONG step);
+		fb_sysflag sysFlag, SINT64 value, SLONG step, SLONG cache);
 
 public:
 	virtual Firebird::string internalPrint(NodePrinter& printer) const;
@@ -1079,6 +1079,7 @@ public:
 	const Firebird::MetaName name;
 	BaseNullable<SINT64> value;
 	Nullable<SLONG> step;
+	Nullable<SLONG> cache;
 };
 
 
@@ -1321,6 +1322,7 @@ public:
 		Nullable<IdentityType> type;
 		Nullable<SINT64> startValue;
 		Nullable<SLONG> increment;
+		Nullable<SLONG> cache;
 		bool restart;	// used in ALTER
 	};
 
@@ -1499,6 +1501,7 @@ public:
 				const Firebird::string* aExternalFile = NULL)
 		: RelationNode(p, aDsqlNode),
 		  externalFile(aExternalFile),
+		  externalDelimiter(NULL),
 		  relationType(rel_persistent)
 	{
 	}
@@ -1519,6 +1522,7 @@ private:
 
 public:
 	const Firebird::string* externalFile;
+	const Firebird::string* externalDelimiter;
 	Nullable<rel_t> relationType;
 	bool preserveRowsOpt;
 	bool deleteRowsOpt;
@@ -1660,6 +1664,7 @@ public:
 		Firebird::ObjectsArray<Firebird::MetaName> columns;
 		Nullable<bool> unique;
 		Nullable<bool> descending;
+		Nullable<bool> trigram;
 		Nullable<bool> inactive;
 		SSHORT type;
 		bid expressionBlr;
@@ -1674,6 +1679,7 @@ public:
 		  name(p, aName),
 		  unique(false),
 		  descending(false),
+		  trigram(false),
 		  relation(NULL),
 		  columns(NULL),
 		  computed(NULL)
@@ -1699,6 +1705,7 @@ public:
 	Firebird::MetaName name;
 	bool unique;
 	bool descending;
+	bool trigram;
 	NestConst<RelationSourceNode> relation;
 	NestConst<ValueListNode> columns;
 	NestConst<ValueSourceClause> computed;
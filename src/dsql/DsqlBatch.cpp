@@ -27,6 +27,7 @@
 #include "../jrd/EngineInterface.h"
 #include "../jrd/jrd.h"
 #include "../jrd/status.h"
+#include "../jrd/btr.h"
 #include "../jrd/exe_proto.h"
 #include "../dsql/dsql.h"
 #include "../dsql/errd_proto.h"
@@ -663,96 +664,126 @@ private:
 	const dsql_msg* message = m_request->getStatement()->getSendMsg();
 	bool startRequest = true;
 
-	// process messages
-	ULONG remains;
-	UCHAR* data;
-	while ((remains = m_messages.get(&data)) > 0)
+	// INSERT puts keys of indices that check nothing in bulk, when all messages are done
+	AutoPtr<DeferredIndexKeys> deferredKeys;
+	if (m_request->getStatement()->getType() == DsqlCompiledStatement::TYPE_INSERT)
 	{
-		if (remains < m_messageSize)
-		{
-			ERRD_post(Arg::Gds(isc_sqlerr) << Arg::Num(-104) <<
-				Arg::Gds(isc_batch_blob_buf) <<
-				Arg::Gds(isc_batch_small_data) << "messages");
-		}
+		MemoryPool& pool = *tdbb->getDefaultPool();
+		deferredKeys = FB_NEW_POOL(pool) DeferredIndexKeys(pool, transaction);
+	}
+	AutoSetRestore<DeferredIndexKeys*> deferredKeysPtr(&req->req_index_keys, deferredKeys);
 
-		while (remains >= m_messageSize)
+	try
+	{
+		// process messages
+		ULONG remains;
+		UCHAR* data;
+		while ((remains = m_messages.get(&data)) > 0)
 		{
-			if (startRequest)
+			if (remains < m_messageSize)
 			{
-				EXE_unwind(tdbb, req);
-				EXE_start(tdbb, req, transaction);
-				startRequest = false;
+				ERRD_post(Arg::Gds(isc_sqlerr) << Arg::Num(-104) <<
+					Arg::Gds(isc_batch_blob_buf) <<
+					Arg::Gds(isc_batch_small_data) << "messages");
 			}
 
-			// skip alignment data
-			UCHAR* alignedData = FB_ALIGN(data, m_alignment);
-			if (alignedData != data)
+			while (remains >= m_messageSize)
 			{
-				remains -= (alignedData - data);
-				data = alignedData;
-				continue;
-			}
+				if (startRequest)
+				{
+					EXE_unwind(tdbb, req);
+					EXE_start(tdbb, req, transaction);
+					startRequest = false;
+				}
 
-			// translate blob IDs
-			fb_assert(intptr_t(data) % m_alignment == 0);
-			for (unsigned i = 0; i < m_blobMeta.getCount(); ++i)
-			{
-				const SSHORT* nullFlag = reinterpret_cast<const SSHORT*>(&data[m_blobMeta[i].nullOffset]);
-				if (*nullFlag)
+				// skip alignment data
+				UCHAR* alignedData = FB_ALIGN(data, m_alignment);
+				if (alignedData != data)
+				{
+					remains -= (alignedData - data);
+					data = alignedData;
 					continue;
+				}
 
-				ISC_QUAD* id = reinterpret_cast<ISC_QUAD*>(&data[m_blobMeta[i].offset]);
-				ISC_QUAD newId;
-				if (!m_blobMap.get(*id, newId))
+				// translate blob IDs
+				fb_assert(intptr_t(data) % m_alignment == 0);
+				for (unsigned i = 0; i < m_blobMeta.getCount(); ++i)
 				{
-					ERRD_post(Arg::Gds(isc_sqlerr) << Arg::Num(-104) <<
-						Arg::Gds(isc_batch_blob_id) << Arg::Quad(id));
+					const SSHORT* nullFlag = reinterpret_cast<const SSHORT*>(&data[m_blobMeta[i].nullOffset]);
+					if (*nullFlag)
+						continue;
+
+					ISC_QUAD* id = reinterpret_cast<ISC_QUAD*>(&data[m_blobMeta[i].offset]);
+					ISC_QUAD newId;
+					if (!m_blobMap.get(*id, newId))
+					{
+						ERRD_post(Arg::Gds(isc_sqlerr) << Arg::Num(-104) <<
+							Arg::Gds(isc_batch_blob_id) << Arg::Quad(id));
+					}
+
+					m_blobMap.remove(*id);
+					*id = newId;
 				}
 
-				m_blobMap.remove(*id);
-				*id = newId;
-			}
+				// map message to internal engine format
+				m_request->mapInOut(tdbb, false, message, m_meta, NULL, data);
+				data += m_messageSize;
+				remains -= m_messageSize;
 
-			// map message to internal engine format
-			m_request->mapInOut(tdbb, false, message, m_meta, NULL, data);
-			data += m_messageSize;
-			remains -= m_messageSize;
+				UCHAR* msgBuffer = m_request->req_msg_buffers[message->msg_buffer_number];
+				DEB_BATCH(fprintf(stderr, "\n\n+++ Send\n\n"));
+				try
+				{
+					ULONG before = req->req_records_inserted + req->req_records_updated +
+						req->req_records_deleted;
+					EXE_send(tdbb, req, message->msg_number, message->msg_length, msgBuffer);
+					ULONG after = req->req_records_inserted + req->req_records_updated +
+						req->req_records_deleted;
+					completionState->regUpdate(after - before);
+				}
+				catch (const Exception& ex)
+				{
+					// record is undone, so are its index keys
+					if (deferredKeys)
+						deferredKeys->discard();
 
-			UCHAR* msgBuffer = m_request->req_msg_buffers[message->msg_buffer_number];
-			DEB_BATCH(fprintf(stderr, "\n\n+++ Send\n\n"));
-			try
-			{
-				ULONG before = req->req_records_inserted + req->req_records_updated +
-					req->req_records_deleted;
-				EXE_send(tdbb, req, message->msg_number, message->msg_length, msgBuffer);
-				ULONG after = req->req_records_inserted + req->req_records_updated +
-					req->req_records_deleted;
-				completionState->regUpdate(after - before);
-			}
-			catch (const Exception& ex)
-			{
-				FbLocalStatus status;
-				ex.stuffException(&status);
-				tdbb->tdbb_status_vector->init();
+					FbLocalStatus status;
+					ex.stuffException(&status);
+					tdbb->tdbb_status_vector->init();
 
-				JTransliterate trLit(tdbb);
-				completionState->regError(&status, &trLit);
+					JTransliterate trLit(tdbb);
+					completionState->regError(&status, &trLit);
 
-				if (!(m_flags & (1 << IBatch::TAG_MULTIERROR)))
-				{
-					cancel(tdbb);
-					remains = 0;
-					break;
+					if (!(m_flags & (1 << IBatch::TAG_MULTIERROR)))
+					{
+						cancel(tdbb);
+						remains = 0;
+						break;
+					}
+
+					startRequest = true;
 				}
 
-				startRequest = true;
+				if (deferredKeys)
+					deferredKeys->confirm(tdbb);
 			}
+
+			UCHAR* alignedData = FB_ALIGN(data, m_alignment);
+			m_messages.remained(remains, alignedData - data);
 		}
+	}
+	catch (const Exception&)
+	{
+		// messages already stored should not lose their index keys
+		if (deferredKeys)
+			deferredKeys->flush(tdbb);
 
-		UCHAR* alignedData = FB_ALIGN(data, m_alignment);
-		m_messages.remained(remains, alignedData - data);
+		throw;
 	}
 
+	if (deferredKeys)
+		deferredKeys->flush(tdbb);
+
 	// reset to initial state
 	cancel(tdbb);
 
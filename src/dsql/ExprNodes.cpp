@@ -4535,7 +4535,7 @@ ValueExprNode* DefaultNode::createFromField(thread_db* tdbb, CompilerScratch* cs
 			csb->csb_pool, (csb->blrVersion == 4), fld->fld_generator_name, NULL, true, true);
 
 		bool sysGen = false;
-		if (!MET_load_generator(tdbb, genNode->generator, &sysGen, &genNode->step))
+		if (!MET_load_generator(tdbb, genNode->generator, &sysGen, &genNode->step, &genNode->cache))
 			PAR_error(csb, Arg::Gds(isc_gennotdef) << Arg::Str(fld->fld_generator_name));
 
 		if (sysGen)
@@ -6390,6 +6390,7 @@ GenIdNode::GenIdNode(MemoryPool& pool, bool aDialect1,
 	  generator(pool, name),
 	  arg(aArg),
 	  step(0),
+	  cache(0),
 	  sysGen(false),
 	  implicit(aImplicit),
 	  identity(aIdentity)
@@ -6416,7 +6417,7 @@ DmlNode* GenIdNode::parse(thread_db* tdbb, MemoryPool& pool, CompilerScratch* cs
 
 		node->generator.id = 0;
 	}
-	else if (!MET_load_generator(tdbb, node->generator, &node->sysGen, &node->step))
+	else if (!MET_load_generator(tdbb, node->generator, &node->sysGen, &node->step, &node->cache))
 		PAR_error(csb, Arg::Gds(isc_gennotdef) << Arg::Str(name));
 
 	if (csb->csb_g_flags & csb_get_dependencies)
@@ -6437,6 +6438,7 @@ string GenIdNode::internalPrint(NodePrinter& printer) const
 	NODE_PRINT(printer, generator);
 	NODE_PRINT(printer, arg);
 	NODE_PRINT(printer, step);
+	NODE_PRINT(printer, cache);
 	NODE_PRINT(printer, sysGen);
 	NODE_PRINT(printer, implicit);
 	NODE_PRINT(printer, identity);
@@ -6451,6 +6453,7 @@ ValueExprNode* GenIdNode::dsqlPass(DsqlCompilerScratch* dsqlScratch)
 				  doDsqlPass(dsqlScratch, arg), implicit, identity);
 	node->generator = generator;
 	node->step = step;
+	node->cache = cache;
 	node->sysGen = sysGen;
 	return node;
 }
@@ -6512,6 +6515,7 @@ ValueExprNode* GenIdNode::copy(thread_db* tdbb, NodeCopier& copier) const
 				  copier.copy(tdbb, arg), implicit, identity);
 	node->generator = generator;
 	node->step = step;
+	node->cache = cache;
 	node->sysGen = sysGen;
 	return node;
 }
@@ -6591,7 +6595,11 @@ dsc* GenIdNode::execute(thread_db* tdbb, jrd_req* request) const
 			status_exception::raise(Arg::Gds(isc_cant_modify_sysobj) << "generator" << generator.name);
 	}
 
-	const SINT64 new_val = DPM_gen_id(tdbb, generator.id, false, change);
+	// NEXT VALUE FOR of the sequence declared with CACHE takes values
+	// from the block reserved by the database, explicit GEN_ID does not
+	const SINT64 new_val = (implicit && cache > 1) ?
+		tdbb->getDatabase()->dbb_gen_cache.next(tdbb, generator.id, change, cache) :
+		DPM_gen_id(tdbb, generator.id, false, change);
 
 	if (dialect1)
 		impure->make_long((SLONG) new_val);
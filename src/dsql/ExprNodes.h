@@ -729,6 +729,7 @@ public:
 	GeneratorItem generator;
 	NestConst<ValueExprNode> arg;
 	SLONG step;
+	SLONG cache;
 
 private:
 	bool sysGen;
@@ -1056,12 +1056,20 @@ public:
 	virtual void aggInit(thread_db* tdbb, jrd_req* request) const = 0;	// pure, but defined
 	virtual void aggFinish(thread_db* tdbb, jrd_req* request) const;
 	virtual bool aggPass(thread_db* tdbb, jrd_req* request) const;
+	virtual bool aggRetract(thread_db* tdbb, jrd_req* request) const;
 	virtual dsc* execute(thread_db* tdbb, jrd_req* request) const;
 
 	virtual unsigned getCapabilities() const = 0;
 	virtual void aggPass(thread_db* tdbb, jrd_req* request, dsc* desc) const = 0;
 	virtual dsc* aggExecute(thread_db* tdbb, jrd_req* request) const = 0;
 
+	// Remove a value previously accumulated by aggPass, used when a window frame slides.
+	// Returns false if the aggregate cannot undo it and must be recomputed from scratch.
+	virtual bool aggRetract(thread_db* /*tdbb*/, jrd_req* /*request*/, dsc* /*desc*/) const
+	{
+		return false;
+	}
+
 	virtual AggNode* dsqlPass(DsqlCompilerScratch* dsqlScratch);
 
 protected:
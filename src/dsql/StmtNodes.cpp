@@ -7151,8 +7151,11 @@ const StmtNode* StoreNode::store(thread_db* tdbb, jrd_req* request, WhichTrigger
 					VirtualTable::store(tdbb, rpb);
 				else if (!relation->rel_view_rse)
 				{
+					DeferredIndexKeys* const deferredKeys = request->req_index_keys;
+
 					VIO_store(tdbb, rpb, transaction);
-					IDX_store(tdbb, rpb, transaction);
+					IDX_store(tdbb, rpb, transaction,
+						(deferredKeys && deferredKeys->accept(request, relation)) ? deferredKeys : NULL);
 				}
 
 				rpb->rpb_number.setValid(true);
@@ -7663,6 +7666,7 @@ const StmtNode* SetGeneratorNode::execute(thread_db* tdbb, jrd_req* request, Exe
 
 		dsc* const desc = EVL_expr(tdbb, request, value);
 		DPM_gen_id(tdbb, generator.id, true, MOV_get_int64(tdbb, desc, 0));
+		tdbb->getDatabase()->dbb_gen_cache.invalidate(tdbb, generator.id);
 
 		DdlNode::executeDdlTrigger(tdbb, transaction, DdlNode::DTW_AFTER,
 			DDL_TRIGGER_ALTER_SEQUENCE, generator.name, NULL, *request->getStatement()->sqlText);
@@ -594,10 +594,12 @@ using namespace Firebird;
 
 %token <metaNamePtr> BINARY
 %token <metaNamePtr> BIND
+%token <metaNamePtr> CACHE
 %token <metaNamePtr> COMPARE_DECFLOAT
 %token <metaNamePtr> CUME_DIST
 %token <metaNamePtr> DECFLOAT
 %token <metaNamePtr> DEFINER
+%token <metaNamePtr> DELIMITER
 %token <metaNamePtr> EXCLUDE
 %token <metaNamePtr> FIRST_DAY
 %token <metaNamePtr> FOLLOWING
@@ -625,6 +627,7 @@ using namespace Firebird;
 %token <metaNamePtr> TIES
 %token <metaNamePtr> TOTALORDER
 %token <metaNamePtr> TRAPS
+%token <metaNamePtr> TRIGRAM
 %token <metaNamePtr> UNBOUNDED
 %token <metaNamePtr> VARBINARY
 %token <metaNamePtr> WINDOW
@@ -1443,6 +1446,17 @@ create_clause
 			{
 				$$ = $7;
 			}
+	| TRIGRAM INDEX symbol_index_name ON simple_table_name
+			{
+				CreateIndexNode* node = newNode<CreateIndexNode>(*$3);
+				node->trigram = true;
+				node->relation = $5;
+				$$ = node;
+			}
+		index_definition(static_cast<CreateIndexNode*>($6))
+			{
+				$$ = $6;
+			}
 	| FUNCTION function_clause					{ $$ = $2; }
 	| PROCEDURE procedure_clause				{ $$ = $2; }
 	| TABLE table_clause						{ $$ = $2; }
@@ -1712,6 +1726,7 @@ create_sequence_options($seqNode)
 create_seq_option($seqNode)
 	: start_with_opt($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 %type start_with_opt(<createAlterSequenceNode>)
@@ -1729,6 +1744,12 @@ step_option($seqNode)
 		{ setClause($seqNode->step, "INCREMENT BY", $3); }
 	;
 
+%type cache_option(<createAlterSequenceNode>)
+cache_option($seqNode)
+	: CACHE long_integer
+		{ setClause($seqNode->cache, "CACHE", $2); }
+	;
+
 by_noise
 	: // nothing
 	| BY
@@ -1744,7 +1765,7 @@ replace_sequence_clause
 	  replace_sequence_options($2)
 		{
 			// Remove this to implement CORE-5137
-			if (!$2->restartSpecified && !$2->step.specified)
+			if (!$2->restartSpecified && !$2->step.specified && !$2->cache.specified)
 				yyerrorIncompleteCmd();
 			$$ = $2;
 		}
@@ -1764,6 +1785,7 @@ replace_seq_option($seqNode)
 		}
 	| start_with_opt($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 %type <createAlterSequenceNode> alter_sequence_clause
@@ -1777,8 +1799,11 @@ alter_sequence_clause
 		}
 	  alter_sequence_options($2)
 		{
-			if (!$2->restartSpecified && !$2->value.specified && !$2->step.specified)
+			if (!$2->restartSpecified && !$2->value.specified && !$2->step.specified &&
+				!$2->cache.specified)
+			{
 				yyerrorIncompleteCmd();
+			}
 			$$ = $2;
 		}
 
@@ -1792,6 +1817,7 @@ alter_sequence_options($seqNode)
 alter_seq_option($seqNode)
 	: restart_option($seqNode)
 	| step_option($seqNode)
+	| cache_option($seqNode)
 	;
 
 
@@ -2104,10 +2130,10 @@ table_clause
 			{
 				$<createRelationNode>$ = newNode<CreateRelationNode>($1, $2);
 			}
-		'(' table_elements($3) ')' sql_security_clause
+		external_delimiter_opt($3) '(' table_elements($3) ')' sql_security_clause
 			{
 				$$ = $3;
-				$$->ssDefiner = $7;
+				$$->ssDefiner = $8;
 			}
 	;
 
@@ -2150,6 +2176,13 @@ external_file
 	| EXTERNAL utf_string			{ $$ = $2; }
 	;
 
+%type external_delimiter_opt(<createRelationNode>)
+external_delimiter_opt($createRelationNode)
+	: // nothing
+	| DELIMITER utf_string
+		{ $createRelationNode->externalDelimiter = $2; }
+	;
+
 %type table_elements(<createRelationNode>)
 table_elements($createRelationNode)
 	: table_element($createRelationNode)
@@ -2246,6 +2279,8 @@ identity_clause_option($identityOptions)
 		{ setClause($identityOptions->startValue, "START WITH", $3); }
 	| INCREMENT by_noise signed_long_integer
 		{ setClause($identityOptions->increment, "INCREMENT BY", $3); }
+	| CACHE long_integer
+		{ setClause($identityOptions->cache, "CACHE", $2); }
 	;
 
 // value does allow parens around it, but there is a problem getting the source text.
@@ -4187,6 +4222,8 @@ alter_identity_clause_option($identityOptions)
 		}
 	| SET INCREMENT by_noise signed_long_integer
 		{ setClause($identityOptions->increment, "SET INCREMENT BY", $4); }
+	| SET CACHE long_integer
+		{ setClause($identityOptions->cache, "SET CACHE", $3); }
 	;
 
 %type <boolVal> drop_behaviour
@@ -8480,10 +8517,12 @@ non_reserved_word
 	| INCREMENT
 	| TRUSTED
 	| BIND					// added in FB 4.0
+	| CACHE
 	| COMPARE_DECFLOAT
 	| CUME_DIST
 	| DECFLOAT
 	| DEFINER
+	| DELIMITER
 	| EXCLUDE
 	| FIRST_DAY
 	| FOLLOWING
@@ -8508,6 +8547,7 @@ non_reserved_word
 	| TIES
 	| TOTALORDER
 	| TRAPS
+	| TRIGRAM
 	;
 
 %%
@@ -393,6 +393,7 @@
 #define isc_spb_bkp_length               7
 #define isc_spb_bkp_skip_data            8
 #define isc_spb_bkp_stat                 15
+#define isc_spb_bkp_parallel             16
 #define isc_spb_bkp_ignore_checksums     0x01
 #define isc_spb_bkp_ignore_limbo         0x02
 #define isc_spb_bkp_metadata_only        0x04
@@ -402,6 +403,7 @@
 #define isc_spb_bkp_convert              0x40
 #define isc_spb_bkp_expand				 0x80
 #define isc_spb_bkp_no_triggers			 0x8000
+#define isc_spb_bkp_zip					 0x010000
 
 /********************************************
  * Parameters for isc_action_svc_properties *
@@ -506,6 +508,7 @@
 #define isc_spb_res_fix_fss_data		13
 #define isc_spb_res_fix_fss_metadata	14
 #define isc_spb_res_stat				isc_spb_bkp_stat
+#define isc_spb_res_parallel			isc_spb_bkp_parallel
 #define isc_spb_res_metadata_only		isc_spb_bkp_metadata_only
 #define isc_spb_res_deactivate_idx		0x0100
 #define isc_spb_res_no_shadow			0x0200
@@ -524,6 +527,7 @@
 #define isc_spb_val_idx_incl		3	// regexp of indices to validate
 #define isc_spb_val_idx_excl		4	// regexp of indices to NOT validate
 #define isc_spb_val_lock_timeout	5	// how long to wait for table lock
+#define isc_spb_val_parallel		6	// number of attachments validating tables in parallel
 
 /******************************************
  * Parameters for isc_spb_res_access_mode  *
@@ -544,6 +548,8 @@
  *****************************************/
 
 #define isc_spb_sts_table			64
+#define isc_spb_sts_sample			65	// percent of data pages and index leaf buckets to analyze
+#define isc_spb_sts_parallel		66	// number of threads reading pages in parallel
 
 #define isc_spb_sts_data_pages		0x01
 #define isc_spb_sts_db_log			0x02
@@ -571,6 +577,7 @@
 #define isc_spb_nbk_guid			8
 #define isc_spb_nbk_no_triggers		0x01
 #define isc_spb_nbk_inplace			0x02
+#define isc_spb_nbk_zip				0x04
 
 /***************************************
  * Parameters for isc_action_svc_trace *
@@ -3348,6 +3348,8 @@ namespace Firebird
 			void (CLOOP_CARG *encrypt)(IDbCryptPlugin* self, IStatus* status, unsigned length, const void* from, void* to) throw();
 			void (CLOOP_CARG *decrypt)(IDbCryptPlugin* self, IStatus* status, unsigned length, const void* from, void* to) throw();
 			void (CLOOP_CARG *setInfo)(IDbCryptPlugin* self, IStatus* status, IDbCryptInfo* info) throw();
+			void (CLOOP_CARG *encryptBlocks)(IDbCryptPlugin* self, IStatus* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) throw();
+			void (CLOOP_CARG *decryptBlocks)(IDbCryptPlugin* self, IStatus* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) throw();
 		};
 
 	protected:
@@ -3361,7 +3363,7 @@ namespace Firebird
 		}
 
 	public:
-		static const unsigned VERSION = 5;
+		static const unsigned VERSION = 6;
 
 		template <typename StatusType> void setKey(StatusType* status, unsigned length, IKeyHolderPlugin** sources, const char* keyName)
 		{
@@ -3396,6 +3398,32 @@ namespace Firebird
 			static_cast<VTable*>(this->cloopVTable)->setInfo(this, status, info);
 			StatusType::checkException(status);
 		}
+
+		template <typename StatusType> void encryptBlocks(StatusType* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to)
+		{
+			if (cloopVTable->version < 6)
+			{
+				StatusType::setVersionError(status, "IDbCryptPlugin", cloopVTable->version, 6);
+				StatusType::checkException(status);
+				return;
+			}
+			StatusType::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->encryptBlocks(this, status, count, length, tweaks, from, to);
+			StatusType::checkException(status);
+		}
+
+		template <typename StatusType> void decryptBlocks(StatusType* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to)
+		{
+			if (cloopVTable->version < 6)
+			{
+				StatusType::setVersionError(status, "IDbCryptPlugin", cloopVTable->version, 6);
+				StatusType::checkException(status);
+				return;
+			}
+			StatusType::clearException(status);
+			static_cast<VTable*>(this->cloopVTable)->decryptBlocks(this, status, count, length, tweaks, from, to);
+			StatusType::checkException(status);
+		}
 	};
 
 	class IExternalContext : public IVersioned
@@ -12581,6 +12609,8 @@ namespace Firebird
 					this->encrypt = &Name::cloopencryptDispatcher;
 					this->decrypt = &Name::cloopdecryptDispatcher;
 					this->setInfo = &Name::cloopsetInfoDispatcher;
+					this->encryptBlocks = &Name::cloopencryptBlocksDispatcher;
+					this->decryptBlocks = &Name::cloopdecryptBlocksDispatcher;
 				}
 			} vTable;
 
@@ -12643,6 +12673,34 @@ namespace Firebird
 			}
 		}
 
+		static void CLOOP_CARG cloopencryptBlocksDispatcher(IDbCryptPlugin* self, IStatus* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) throw()
+		{
+			StatusType status2(status);
+
+			try
+			{
+				static_cast<Name*>(self)->Name::encryptBlocks(&status2, count, length, tweaks, from, to);
+			}
+			catch (...)
+			{
+				StatusType::catchException(&status2);
+			}
+		}
+
+		static void CLOOP_CARG cloopdecryptBlocksDispatcher(IDbCryptPlugin* self, IStatus* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) throw()
+		{
+			StatusType status2(status);
+
+			try
+			{
+				static_cast<Name*>(self)->Name::decryptBlocks(&status2, count, length, tweaks, from, to);
+			}
+			catch (...)
+			{
+				StatusType::catchException(&status2);
+			}
+		}
+
 		static void CLOOP_CARG cloopsetOwnerDispatcher(IPluginBase* self, IReferenceCounted* r) throw()
 		{
 			try
@@ -12711,6 +12769,8 @@ namespace Firebird
 		virtual void encrypt(StatusType* status, unsigned length, const void* from, void* to) = 0;
 		virtual void decrypt(StatusType* status, unsigned length, const void* from, void* to) = 0;
 		virtual void setInfo(StatusType* status, IDbCryptInfo* info) = 0;
+		virtual void encryptBlocks(StatusType* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) = 0;
+		virtual void decryptBlocks(StatusType* status, unsigned count, unsigned length, const ISC_INT64* tweaks, const void* from, void* to) = 0;
 	};
 
 	template <typename Name, typename StatusType, typename Base>
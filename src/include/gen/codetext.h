@@ -1049,6 +1049,8 @@ static const struct {
 	{"dyn_cant_use_in_foreignkey", 336068897},
 	{"dyn_defvaldecl_package_func", 336068898},
 	{"dyn_cant_use_zero_inc_ident", 336068904},
+	{"dyn_trigram_index", 336068905},
+	{"dyn_ext_delimiter", 336068906},
 	{"gbak_unknown_switch", 336330753},
 	{"gbak_page_size_missing", 336330754},
 	{"gbak_page_size_toobig", 336330755},
@@ -1368,6 +1370,8 @@ static const struct {
 	{"nbackup_user_stop", 337117257},
 	{"nbackup_deco_parse", 337117259},
 	{"nbackup_lostrec_guid_db", 337117261},
+	{"nbackup_zip_unavailable", 337117265},
+	{"nbackup_zip_corrupted", 337117266},
 	{"trace_conflict_acts", 337182750},
 	{"trace_act_notfound", 337182751},
 	{"trace_switch_once", 337182752},
@@ -1083,6 +1083,8 @@ const ISC_STATUS isc_dyn_cant_use_zero_increment      = 336068896L;
 const ISC_STATUS isc_dyn_cant_use_in_foreignkey       = 336068897L;
 const ISC_STATUS isc_dyn_defvaldecl_package_func      = 336068898L;
 const ISC_STATUS isc_dyn_cant_use_zero_inc_ident      = 336068904L;
+const ISC_STATUS isc_dyn_trigram_index                = 336068905L;
+const ISC_STATUS isc_dyn_ext_delimiter                = 336068906L;
 const ISC_STATUS isc_gbak_unknown_switch              = 336330753L;
 const ISC_STATUS isc_gbak_page_size_missing           = 336330754L;
 const ISC_STATUS isc_gbak_page_size_toobig            = 336330755L;
@@ -1402,6 +1404,8 @@ const ISC_STATUS isc_nbackup_switchd_parameter        = 337117255L;
 const ISC_STATUS isc_nbackup_user_stop                = 337117257L;
 const ISC_STATUS isc_nbackup_deco_parse               = 337117259L;
 const ISC_STATUS isc_nbackup_lostrec_guid_db          = 337117261L;
+const ISC_STATUS isc_nbackup_zip_unavailable          = 337117265L;
+const ISC_STATUS isc_nbackup_zip_corrupted            = 337117266L;
 const ISC_STATUS isc_trace_conflict_acts              = 337182750L;
 const ISC_STATUS isc_trace_act_notfound               = 337182751L;
 const ISC_STATUS isc_trace_switch_once                = 337182752L;
@@ -1413,7 +1417,7 @@ const ISC_STATUS isc_trace_switch_user_only           = 337182757L;
 const ISC_STATUS isc_trace_switch_param_miss          = 337182758L;
 const ISC_STATUS isc_trace_param_act_notcompat        = 337182759L;
 const ISC_STATUS isc_trace_mandatory_switch_miss      = 337182760L;
-const ISC_STATUS isc_err_max                          = 1357;
+const ISC_STATUS isc_err_max                          = 1361;
 
 #else /* c definitions */
 
@@ -2466,6 +2470,8 @@ const ISC_STATUS isc_err_max                          = 1357;
 #define isc_dyn_cant_use_in_foreignkey       336068897L
 #define isc_dyn_defvaldecl_package_func      336068898L
 #define isc_dyn_cant_use_zero_inc_ident      336068904L
+#define isc_dyn_trigram_index                336068905L
+#define isc_dyn_ext_delimiter                336068906L
 #define isc_gbak_unknown_switch              336330753L
 #define isc_gbak_page_size_missing           336330754L
 #define isc_gbak_page_size_toobig            336330755L
@@ -2785,6 +2791,8 @@ const ISC_STATUS isc_err_max                          = 1357;
 #define isc_nbackup_user_stop                337117257L
 #define isc_nbackup_deco_parse               337117259L
 #define isc_nbackup_lostrec_guid_db          337117261L
+#define isc_nbackup_zip_unavailable          337117265L
+#define isc_nbackup_zip_corrupted            337117266L
 #define isc_trace_conflict_acts              337182750L
 #define isc_trace_act_notfound               337182751L
 #define isc_trace_switch_once                337182752L
@@ -2796,7 +2804,7 @@ const ISC_STATUS isc_err_max                          = 1357;
 #define isc_trace_switch_param_miss          337182758L
 #define isc_trace_param_act_notcompat        337182759L
 #define isc_trace_mandatory_switch_miss      337182760L
-#define isc_err_max                          1357
+#define isc_err_max                          1361
 
 #endif
 
@@ -100,6 +100,7 @@
 	const USHORT  f_idx_exp_blr = 10;
 	const USHORT  f_idx_exp_source = 11;
 	const USHORT  f_idx_statistics = 12;
+	const USHORT  f_idx_histogram = 13;
 
 
 // Relation 5 (RDB$RELATION_FIELDS)
@@ -322,6 +323,7 @@
 	const USHORT  f_gen_owner = 5;
 	const USHORT  f_gen_init_val = 6;
 	const USHORT  f_gen_increment = 7;
+	const USHORT  f_gen_cache = 8;
 
 
 // Relation 21 (RDB$FIELD_DIMENSIONS)
@@ -523,6 +525,9 @@
 	const USHORT  f_mon_att_stmt_timeout = 22;
 	const USHORT  f_mon_att_conn_compressed = 23;
 	const USHORT  f_mon_att_conn_encrypted = 24;
+	const USHORT  f_mon_att_work_mem_used = 25;
+	const USHORT  f_mon_att_work_mem_grant = 26;
+	const USHORT  f_mon_att_work_mem_spilled = 27;
 
 
 // Relation 35 (MON$TRANSACTIONS)
@@ -1052,6 +1052,8 @@ Data source : @4"},		/* eds_statement */
 	{336068897, "Can't use @1 in FOREIGN KEY constraint"},		/* dyn_cant_use_in_foreignkey */
 	{336068898, "Default values for parameters are not allowed in the definition of a previously declared packaged function @1.@2"},		/* dyn_defvaldecl_package_func */
 	{336068904, "INCREMENT BY 0 is an illegal option for identity column @1 of table @2"},		/* dyn_cant_use_zero_inc_ident */
+	{336068905, "Trigram index @1 must be defined on a single CHAR or VARCHAR column and cannot be unique or descending"},		/* dyn_trigram_index */
+	{336068906, "Delimiter of external file must be a single ASCII character other than double quote or line break"},		/* dyn_ext_delimiter */
 	{336330753, "found unknown switch"},		/* gbak_unknown_switch */
 	{336330754, "page size parameter missing"},		/* gbak_page_size_missing */
 	{336330755, "Page size specified (@1) greater than limit (32768 bytes)"},		/* gbak_page_size_toobig */
@@ -1371,6 +1373,8 @@ Data source : @4"},		/* eds_statement */
 	{337117257, "Terminated due to user request"},		/* nbackup_user_stop */
 	{337117259, "Too complex decompress command (> @1 arguments)"},		/* nbackup_deco_parse */
 	{337117261, "Cannot find record for database \"@1\" backup GUID @2 in the backup history"},		/* nbackup_lostrec_guid_db */
+	{337117265, "zlib library is not available, compressed backup file can not be processed"},		/* nbackup_zip_unavailable */
+	{337117266, "Compressed block @1 is corrupted in backup file @2"},		/* nbackup_zip_corrupted */
 	{337182750, "conflicting actions \"@1\" and \"@2\" found"},		/* trace_conflict_acts */
 	{337182751, "action switch not found"},		/* trace_act_notfound */
 	{337182752, "switch \"@1\" must be set only once"},		/* trace_switch_once */
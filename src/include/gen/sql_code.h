@@ -1048,6 +1048,8 @@ static const struct {
 	{336068897, -901}, /* 289 dyn_cant_use_in_foreignkey */
 	{336068898, -901}, /* 290 dyn_defvaldecl_package_func */
 	{336068904, -901}, /* 296 dyn_cant_use_zero_inc_ident */
+	{336068905, -607}, /* 297 dyn_trigram_index */
+	{336068906, -607}, /* 298 dyn_ext_delimiter */
 	{336330753, -901}, /*   1 gbak_unknown_switch */
 	{336330754, -901}, /*   2 gbak_page_size_missing */
 	{336330755, -901}, /*   3 gbak_page_size_toobig */
@@ -1367,6 +1369,8 @@ static const struct {
 	{337117257, -901}, /*  73 nbackup_user_stop */
 	{337117259, -901}, /*  75 nbackup_deco_parse */
 	{337117261, -901}, /*  77 nbackup_lostrec_guid_db */
+	{337117265, -901}, /*  81 nbackup_zip_unavailable */
+	{337117266, -901}, /*  82 nbackup_zip_corrupted */
 	{337182750, -901}, /*  30 trace_conflict_acts */
 	{337182751, -901}, /*  31 trace_act_notfound */
 	{337182752, -901}, /*  32 trace_switch_once */
@@ -1048,6 +1048,8 @@ static const struct {
 	{336068897, "42000"}, // 289 dyn_cant_use_in_foreignkey
 	{336068898, "42000"}, // 290 dyn_defvaldecl_package_func
 	{336068904, "42000"}, // 296 dyn_cant_use_zero_inc_ident
+	{336068905, "42000"}, // 297 dyn_trigram_index
+	{336068906, "42000"}, // 298 dyn_ext_delimiter
 	{336330753, "00000"}, //   1 gbak_unknown_switch
 	{336330754, "00000"}, //   2 gbak_page_size_missing
 	{336330755, "00000"}, //   3 gbak_page_size_toobig
@@ -1367,6 +1369,8 @@ static const struct {
 	{337117257, "08006"}, //  73 nbackup_user_stop
 	{337117259, "54023"}, //  75 nbackup_deco_parse
 	{337117261, "00000"}, //  77 nbackup_lostrec_guid_db
+	{337117265, "00000"}, //  81 nbackup_zip_unavailable
+	{337117266, "00000"}, //  82 nbackup_zip_corrupted
 	{337182750, "00000"}, //  30 trace_conflict_acts
 	{337182751, "00000"}, //  31 trace_act_notfound
 	{337182752, "00000"}, //  32 trace_switch_once
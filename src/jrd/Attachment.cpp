@@ -175,6 +175,7 @@ void Jrd::Attachment::backupStateReadUnLock(thread_db* tdbb)
 Jrd::Attachment::Attachment(MemoryPool* pool, Database* dbb)
 	: att_pool(pool),
 	  att_memory_stats(&dbb->dbb_memory_stats),
+	  att_work_memory(&dbb->dbb_work_memory),
 	  att_database(dbb),
 	  att_requests(*pool),
 	  att_lock_owner_id(Database::getLockOwnerId()),
@@ -32,6 +32,7 @@
 #include "../jrd/PreparedStatement.h"
 #include "../jrd/RandomGenerator.h"
 #include "../jrd/RuntimeStatistics.h"
+#include "../jrd/WorkMemory.h"
 
 #include "../common/classes/ByteChunk.h"
 #include "../common/classes/GenericMap.h"
@@ -275,6 +276,7 @@ public:
 
 	MemoryPool* const att_pool;					// Memory pool
 	Firebird::MemoryStats att_memory_stats;
+	WorkMemory	att_work_memory;			// Sort, hash and temporary space memory
 
 	Database*	att_database;				// Parent database block
 	Attachment*	att_next;					// Next attachment to database
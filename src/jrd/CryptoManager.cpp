@@ -63,6 +63,33 @@ namespace {
 		return 0;
 	}
 
+	THREAD_ENTRY_DECLARE cryptHelperStatic(THREAD_ENTRY_PARAM p)
+	{
+		Jrd::CryptoManager* cryptoManager = (Jrd::CryptoManager*) p;
+		cryptoManager->cryptHelper();
+
+		return 0;
+	}
+
+	class UseCountHolder
+	{
+	public:
+		explicit UseCountHolder(Jrd::Attachment* a)
+			: att(a)
+		{
+			att->att_use_count++;
+		}
+		~UseCountHolder()
+		{
+			att->att_use_count--;
+		}
+	private:
+		Jrd::Attachment* att;
+	};
+
+	// Pages processed by crypt thread at once, they are read ahead from disk
+	const ULONG CRYPT_CHUNK = 64;
+
 	const UCHAR CRYPT_RELEASE = LCK_SR;
 	const UCHAR CRYPT_NORMAL = LCK_PR;
 	const UCHAR CRYPT_CHANGE = LCK_PW;
@@ -290,7 +317,12 @@ namespace Jrd {
 		  crypt(false),
 		  process(false),
 		  down(false),
-		  run(false)
+		  run(false),
+		  pageTweaks(false),
+		  activeChunks(getPool()),
+		  nextChunkPage(0),
+		  lastChunkPage(0),
+		  helperFailed(false)
 	{
 		stateLock = FB_NEW_RPT(getPool(), 0)
 			Lock(tdbb, 0, LCK_crypt_status, this, blockingAstChangeCryptState);
@@ -431,6 +463,7 @@ namespace Jrd {
 		setDbInfo(p);
 
 		keyHolderPlugins.init(p, keyName);
+		pageTweaks = true;			// until plugin reports it's too old for them
 		cryptPlugin = p;
 		cryptPlugin->addRef();
 
@@ -830,77 +863,44 @@ namespace Jrd {
 					tdbb->tdbb_quantum = SWEEP_QUANTUM;
 
 					DatabaseContextHolder dbHolder(tdbb);
-
-					class UseCountHolder
-					{
-					public:
-						explicit UseCountHolder(Attachment* a)
-							: att(a)
-						{
-							att->att_use_count++;
-						}
-						~UseCountHolder()
-						{
-							att->att_use_count--;
-						}
-					private:
-						Attachment* att;
-					};
 					UseCountHolder use_count(att);
 
 					// get ready...
 					AutoSetRestore<Attachment*> attSet(&cryptAtt, att);
 					ULONG lastPage = getLastPage(tdbb);
+					const unsigned threads = dbb.dbb_config->getCryptThreads();
+					helperFailed = false;
 
 					do
 					{
 						// Check is there some job to do
-						while (currentPage < lastPage)
-						{
-							// forced terminate
-							if (down)
-							{
-								break;
-							}
-
-							// scheduling
-							if (--tdbb->tdbb_quantum < 0)
-							{
-								JRD_reschedule(tdbb, SWEEP_QUANTUM, true);
-							}
-
-							// nbackup state check
-							int bak_state = Ods::hdr_nbak_unknown;
-							{	// scope
-								BackupManager::StateReadGuard stateGuard(tdbb);
-								bak_state = dbb.dbb_backup_manager->getState();
-							}
+						activeChunks.clear();
+						nextChunkPage = currentPage;
+						lastChunkPage = lastPage;
 
-							if (bak_state != Ods::hdr_nbak_normal)
-							{
-								EngineCheckout checkout(tdbb, FB_FUNCTION);
-								Thread::sleep(10);
-								continue;
-							}
+						// Start helpers when there are enough chunks for them.
+						// Failed helper is not restarted, its chunk is processed again
+						// by the next round.
+						HalfStaticArray<Thread::Handle, 8> helpers;
 
-							// writing page to disk will change it's crypt status in usual way
-							WIN window(DB_PAGE_SPACE, currentPage);
-							Ods::pag* page = CCH_FETCH(tdbb, &window, LCK_write, pag_undefined);
-							if (page && page->pag_type <= pag_max &&
-								(bool(page->pag_flags & Ods::crypted_page) != crypt) &&
-								Ods::pag_crypt_page[page->pag_type])
+						try
+						{
+							for (unsigned n = 1; n < threads && !helperFailed &&
+								currentPage + n * CRYPT_CHUNK < lastPage; ++n)
 							{
-								CCH_MARK_MUST_WRITE(tdbb, &window);
+								Thread::Handle h;
+								Thread::start(cryptHelperStatic, (THREAD_ENTRY_PARAM) this, THREAD_medium, &h);
+								helpers.add(h);
 							}
-							CCH_RELEASE_TAIL(tdbb, &window);
 
-							// sometimes save currentPage into DB header
-							++currentPage;
-							if ((currentPage & 0x3FF) == 0)
-							{
-								writeDbHeader(tdbb, currentPage);
-							}
+							cryptChunks(tdbb, true);
+						}
+						catch (const Exception&)
+						{
+							waitHelpers(tdbb, helpers);
+							throw;
 						}
+						waitHelpers(tdbb, helpers);
 
 						// forced terminate
 						if (down)
@@ -908,7 +908,7 @@ namespace Jrd {
 							break;
 						}
 
-						// At this moment of time all pages with number < lastpage
+						// At this moment of time all pages with number < currentPage
 						// are guaranteed to change crypt state. Check for added pages.
 						lastPage = getLastPage(tdbb);
 
@@ -954,6 +954,162 @@ namespace Jrd {
 		}
 	}
 
+	void CryptoManager::cryptHelper()
+	{
+		FbLocalStatus status_vector;
+
+		try
+		{
+			// Establish context - helper has own attachment like the crypt thread
+			ClumpletWriter writer(ClumpletReader::Tagged, MAX_DPB_SIZE, isc_dpb_version1);
+			writer.insertString(isc_dpb_user_name, DBA_USER_NAME);
+			writer.insertByte(isc_dpb_no_db_triggers, TRUE);
+
+			// Avoid races with release_attachment() in jrd.cpp
+			MutexEnsureUnlock releaseGuard(cryptAttMutex, FB_FUNCTION);
+			releaseGuard.enter();
+
+			if (down)
+				return;
+
+			RefPtr<JAttachment> jAtt(REF_NO_INCR, dbb.dbb_provider->attachDatabase(&status_vector,
+				dbb.dbb_database_name.c_str(), writer.getBufferLength(), writer.getBuffer()));
+			check(&status_vector);
+
+			MutexLockGuard attGuard(*(jAtt->getStable()->getMutex()), FB_FUNCTION);
+			Attachment* att = jAtt->getHandle();
+			if (!att)
+				Arg::Gds(isc_att_shutdown).raise();
+			att->att_flags |= ATT_crypt_thread;
+			releaseGuard.leave();
+
+			ThreadContextHolder tdbb(att->att_database, att, &status_vector);
+			tdbb->tdbb_quantum = SWEEP_QUANTUM;
+
+			DatabaseContextHolder dbHolder(tdbb);
+			UseCountHolder use_count(att);
+
+			cryptChunks(tdbb, false);
+		}
+		catch (const Exception& ex)
+		{
+			helperFailed = true;
+			iscLogException("Crypt thread helper:", ex);
+		}
+	}
+
+	void CryptoManager::waitHelpers(thread_db* tdbb, HalfStaticArray<Thread::Handle, 8>& helpers)
+	{
+		{	// scope
+			// Do not let helpers take new chunks
+			MutexLockGuard guard(chunkMtx, FB_FUNCTION);
+			lastChunkPage = nextChunkPage;
+		}
+
+		if (helpers.hasData())
+		{
+			EngineCheckout checkout(tdbb, FB_FUNCTION);
+
+			for (FB_SIZE_T n = 0; n < helpers.getCount(); ++n)
+				Thread::waitForCompletion(helpers[n]);
+			helpers.clear();
+		}
+
+		// Chunks left active by failed or terminated threads are not done
+		MutexLockGuard guard(chunkMtx, FB_FUNCTION);
+		currentPage = activeChunks.hasData() ? activeChunks[0] : nextChunkPage;
+	}
+
+	bool CryptoManager::nextChunk(ULONG& start, ULONG& end)
+	{
+		MutexLockGuard guard(chunkMtx, FB_FUNCTION);
+
+		if (down || nextChunkPage >= lastChunkPage)
+			return false;
+
+		start = nextChunkPage;
+		end = MIN(start + CRYPT_CHUNK, lastChunkPage);
+		nextChunkPage = end;
+		activeChunks.add(start);
+
+		return true;
+	}
+
+	ULONG CryptoManager::chunkDone(ULONG start)
+	{
+		MutexLockGuard guard(chunkMtx, FB_FUNCTION);
+
+		FB_SIZE_T pos;
+		if (activeChunks.find(start, pos))
+			activeChunks.remove(pos);
+
+		currentPage = activeChunks.hasData() ? activeChunks[0] : nextChunkPage;
+		return currentPage;
+	}
+
+	void CryptoManager::cryptChunks(thread_db* tdbb, bool leader)
+	{
+		PageSpace* const pageSpace = dbb.dbb_page_manager.findPageSpace(DB_PAGE_SPACE);
+		ULONG savedPage = currentPage;
+		ULONG start, end;
+
+		while (nextChunk(start, end))
+		{
+			// let OS read the whole chunk at once
+			PIO_prefetch(pageSpace->file, start, end - start, dbb.dbb_page_size);
+
+			for (ULONG pageNum = start; pageNum < end; )
+			{
+				// forced terminate, chunk remains not done
+				if (down)
+				{
+					return;
+				}
+
+				// scheduling
+				if (--tdbb->tdbb_quantum < 0)
+				{
+					JRD_reschedule(tdbb, SWEEP_QUANTUM, true);
+				}
+
+				// nbackup state check
+				int bak_state = Ods::hdr_nbak_unknown;
+				{	// scope
+					BackupManager::StateReadGuard stateGuard(tdbb);
+					bak_state = dbb.dbb_backup_manager->getState();
+				}
+
+				if (bak_state != Ods::hdr_nbak_normal)
+				{
+					EngineCheckout checkout(tdbb, FB_FUNCTION);
+					Thread::sleep(10);
+					continue;
+				}
+
+				// writing page to disk will change it's crypt status in usual way
+				WIN window(DB_PAGE_SPACE, pageNum);
+				Ods::pag* page = CCH_FETCH(tdbb, &window, LCK_write, pag_undefined);
+				if (page && page->pag_type <= pag_max &&
+					(bool(page->pag_flags & Ods::crypted_page) != crypt) &&
+					Ods::pag_crypt_page[page->pag_type])
+				{
+					CCH_MARK_MUST_WRITE(tdbb, &window);
+				}
+				CCH_RELEASE_TAIL(tdbb, &window);
+
+				++pageNum;
+			}
+
+			// sometimes save currentPage into DB header
+			const ULONG done = chunkDone(start);
+			if (leader && done >= savedPage + 0x400)
+			{
+				writeDbHeader(tdbb, done);
+				savedPage = done;
+			}
+		}
+	}
+
 	void CryptoManager::writeDbHeader(thread_db* tdbb, ULONG runpage)
 	{
 		CchHdr hdr(tdbb, LCK_write);
@@ -1050,9 +1206,7 @@ namespace Jrd {
 				return FAILED_CRYPT;
 			}
 
-			cryptPlugin->decrypt(sv, dbb.dbb_page_size - sizeof(Ods::pag),
-				&page[1], &page[1]);
-			if (sv->getState() & IStatus::STATE_ERRORS)
+			if (!cryptPage(sv, false, page, page))
 				return FAILED_CRYPT;
 		}
 
@@ -1136,9 +1290,7 @@ namespace Jrd {
 			}
 
 			to[0] = page[0];
-			cryptPlugin->encrypt(sv, dbb.dbb_page_size - sizeof(Ods::pag),
-				&page[1], &to[1]);
-			if (sv->getState() & IStatus::STATE_ERRORS)
+			if (!cryptPage(sv, true, page, to))
 				return FAILED_CRYPT;
 
 			to->pag_flags |= Ods::crypted_page;		// Mark page that is going to be written as encrypted
@@ -1159,6 +1311,40 @@ namespace Jrd {
 		return SUCCESS_ALL;
 	}
 
+	bool CryptoManager::cryptPage(FbStatusVector* sv, bool encrypting, Ods::pag* from, Ods::pag* to)
+	{
+		const unsigned length = dbb.dbb_page_size - sizeof(Ods::pag);
+
+		if (pageTweaks)
+		{
+			// page number from never encrypted page header is a tweak
+			const ISC_INT64 tweak = from->pag_pageno;
+
+			if (encrypting)
+				cryptPlugin->encryptBlocks(sv, 1, length, &tweak, &from[1], &to[1]);
+			else
+				cryptPlugin->decryptBlocks(sv, 1, length, &tweak, &from[1], &to[1]);
+
+			if (!(sv->getState() & IStatus::STATE_ERRORS))
+				return true;
+
+			const ISC_STATUS* v = sv->getErrors();
+			if (v[0] != isc_arg_gds || v[1] != isc_interface_version_too_old)
+				return false;
+
+			// plugin does not support tweaks
+			pageTweaks = false;
+			sv->init();
+		}
+
+		if (encrypting)
+			cryptPlugin->encrypt(sv, length, &from[1], &to[1]);
+		else
+			cryptPlugin->decrypt(sv, length, &from[1], &to[1]);
+
+		return !(sv->getState() & IStatus::STATE_ERRORS);
+	}
+
 	int CryptoManager::blockingAstChangeCryptState(void* object)
 	{
 		((CryptoManager*) object)->blockingAstChangeCryptState();
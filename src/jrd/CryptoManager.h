@@ -296,6 +296,7 @@ public:
 	bool write(thread_db* tdbb, FbStatusVector* sv, Ods::pag* page, IOCallback* io);
 
 	void cryptThread();
+	void cryptHelper();
 
 	bool checkValidation(Firebird::IDbCryptPlugin* crypt);
 	void setDbInfo(Firebird::IDbCryptPlugin* cp);
@@ -307,6 +308,7 @@ private:
 	enum IoResult {SUCCESS_ALL, FAILED_CRYPT, FAILED_IO};
 	IoResult internalRead(thread_db* tdbb, FbStatusVector* sv, Ods::pag* page, IOCallback* io);
 	IoResult internalWrite(thread_db* tdbb, FbStatusVector* sv, Ods::pag* page, IOCallback* io);
+	bool cryptPage(FbStatusVector* sv, bool encrypting, Ods::pag* from, Ods::pag* to);
 
 	class Buffer
 	{
@@ -393,6 +395,10 @@ private:
 	void loadPlugin(thread_db* tdbb, const char* pluginName);
 	ULONG getLastPage(thread_db* tdbb);
 	void writeDbHeader(thread_db* tdbb, ULONG runpage);
+	void cryptChunks(thread_db* tdbb, bool leader);
+	bool nextChunk(ULONG& start, ULONG& end);
+	ULONG chunkDone(ULONG start);
+	void waitHelpers(thread_db* tdbb, Firebird::HalfStaticArray<Thread::Handle, 8>& helpers);
 	void calcValidation(Firebird::string& valid, Firebird::IDbCryptPlugin* plugin);
 	void checkValidation();
 
@@ -444,6 +450,17 @@ private:
 	SINT64 slowIO;
 	bool crypt, process, down, run;
 
+	// Plugin crypts pages using page number as a tweak
+	bool pageTweaks;
+
+	// Crypt thread and its helpers take pages by chunks. Each chunk being
+	// processed is kept in activeChunks, therefore all pages before the first
+	// of them (or before nextChunkPage) are done and currentPage may be moved there.
+	Firebird::Mutex chunkMtx;
+	Firebird::SortedArray<ULONG> activeChunks;
+	ULONG nextChunkPage, lastChunkPage;
+	bool helperFailed;
+
 public:
 	Firebird::Mutex cryptAttMutex;
 };
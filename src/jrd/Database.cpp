@@ -34,6 +34,7 @@
 #include "../jrd/nbak.h"
 #include "../jrd/tra.h"
 #include "../jrd/tpc_proto.h"
+#include "../jrd/dpm_proto.h"
 #include "../jrd/lck_proto.h"
 #include "../jrd/CryptoManager.h"
 #include "../jrd/os/pio_proto.h"
@@ -290,6 +291,343 @@ namespace Jrd
 		return result;
 	}
 
+	bool Database::FormatCache::get(thread_db* tdbb, USHORT relId, USHORT number,
+		UCharBuffer& buffer, ULONG& generation)
+	{
+		// If the format is not cached, return the generation to be passed
+		// into put() or zero if the format can't be cached at the moment
+
+		generation = 0;
+
+		// Other processes (Classic) or database blocks (SuperClassic) would not
+		// benefit from the cache but pay for the lock, so use it in SuperServer only
+
+		if (!(tdbb->getDatabase()->dbb_flags & DBB_shared))
+			return false;
+
+		RelationFormats* entry = NULL;
+
+		{ // scope
+			SyncLockGuard guard(&m_sync, SYNC_SHARED, "Database::FormatCache::get");
+
+			FB_SIZE_T pos;
+			if (m_relations.find(relId, pos))
+			{
+				entry = m_relations[pos];
+
+				if (entry->lock->lck_logical != LCK_none)
+				{
+					if (number < entry->formats.getCount() && entry->formats[number])
+					{
+						const UCharBuffer* const format = entry->formats[number];
+						buffer.assign(format->begin(), format->getCount());
+						return true;
+					}
+
+					generation = entry->generation;
+					return false;
+				}
+			}
+		}
+
+		if (!entry)
+		{
+			SyncLockGuard guard(&m_sync, SYNC_EXCLUSIVE, "Database::FormatCache::get");
+
+			FB_SIZE_T pos;
+			if (m_relations.find(relId, pos))
+				entry = m_relations[pos];
+			else
+			{
+				entry = FB_NEW_POOL(m_pool) RelationFormats(m_pool, this, relId);
+				entry->lock = FB_NEW_RPT(m_pool, 0)
+					Lock(tdbb, sizeof(SLONG), LCK_rel_formats, entry, blockingAst);
+				entry->lock->setKey(relId);
+				m_relations.insert(pos, entry);
+			}
+		}
+
+		// Lock manager calls are done without m_sync as the AST acquires it
+
+		MutexLockGuard lockGuard(m_lockMutex, FB_FUNCTION);
+
+		if (entry->lock->lck_logical == LCK_none &&
+			!LCK_lock(tdbb, entry->lock, LCK_SR, LCK_NO_WAIT))
+		{
+			// Someone is changing the relation right now, don't cache anything
+			fb_utils::init_status(tdbb->tdbb_status_vector);
+			return false;
+		}
+
+		SyncLockGuard guard(&m_sync, SYNC_SHARED, "Database::FormatCache::get");
+		generation = entry->generation;
+		return false;
+	}
+
+	void Database::FormatCache::put(USHORT relId, USHORT number, ULONG generation,
+		const UCHAR* data, ULONG length)
+	{
+		SyncLockGuard guard(&m_sync, SYNC_EXCLUSIVE, "Database::FormatCache::put");
+
+		FB_SIZE_T pos;
+		if (!m_relations.find(relId, pos))
+			return;
+
+		RelationFormats* const entry = m_relations[pos];
+
+		// Formats could be discarded while we were reading them
+
+		if (entry->generation != generation || entry->lock->lck_logical == LCK_none)
+			return;
+
+		while (entry->formats.getCount() <= number)
+			entry->formats.add(NULL);
+
+		if (!entry->formats[number])
+		{
+			UCharBuffer* const format = FB_NEW_POOL(m_pool) UCharBuffer(m_pool);
+			format->assign(data, length);
+			entry->formats[number] = format;
+		}
+	}
+
+	void Database::FormatCache::shutdown(thread_db* tdbb)
+	{
+		for (FB_SIZE_T i = 0; i < m_relations.getCount(); i++)
+		{
+			Lock* const lock = m_relations[i]->lock;
+
+			if (lock->lck_logical != LCK_none)
+				LCK_release(tdbb, lock);
+		}
+	}
+
+	void Database::FormatCache::invalidate(thread_db* tdbb, USHORT relId)
+	{
+		// Discard cached formats of the relation here and in every other
+		// database block. Our own lock is released first, otherwise we would
+		// wait for ourselves as both locks have the same owner.
+		// Nothing is cached by the database blocks that are not shared.
+
+		if (!(tdbb->getDatabase()->dbb_flags & DBB_shared))
+			return;
+
+		MutexLockGuard lockGuard(m_lockMutex, FB_FUNCTION);
+
+		{ // scope
+			SyncLockGuard guard(&m_sync, SYNC_EXCLUSIVE, "Database::FormatCache::invalidate");
+
+			FB_SIZE_T pos;
+			if (m_relations.find(relId, pos))
+			{
+				RelationFormats* const entry = m_relations[pos];
+
+				entry->clear();
+				entry->generation++;
+
+				if (entry->lock->lck_logical != LCK_none)
+					LCK_release(tdbb, entry->lock);
+			}
+		}
+
+		Lock temp_lock(tdbb, sizeof(SLONG), LCK_rel_formats);
+		temp_lock.setKey(relId);
+
+		LCK_lock(tdbb, &temp_lock, LCK_EX, LCK_WAIT);
+		LCK_release(tdbb, &temp_lock);
+	}
+
+	int Database::FormatCache::blockingAst(void* ast_object)
+	{
+		RelationFormats* const entry = static_cast<RelationFormats*>(ast_object);
+
+		try
+		{
+			Database* const dbb = entry->lock->lck_dbb;
+
+			AsyncContextHolder tdbb(dbb, FB_FUNCTION, entry->lock);
+
+			SyncLockGuard guard(&entry->cache->m_sync, SYNC_EXCLUSIVE,
+				"Database::FormatCache::blockingAst");
+
+			entry->clear();
+			entry->generation++;
+
+			LCK_release(tdbb, entry->lock);
+		}
+		catch (const Exception&)
+		{} // no-op
+
+		return 0;
+	}
+
+	SINT64 Database::GeneratorCache::next(thread_db* tdbb, SLONG genId, SINT64 step, SLONG cacheSize)
+	{
+		// The transaction which created or restarted the sequence keeps
+		// its value privately until commit, take it from there
+
+		jrd_tra* const transaction = tdbb->getTransaction();
+		SINT64 value;
+
+		if (cacheSize <= 1 || !step ||
+			(transaction && transaction->tra_gen_ids && transaction->tra_gen_ids->get(genId, value)) ||
+			step > MAX_SINT64 / cacheSize || step < MIN_SINT64 / cacheSize)
+		{
+			return DPM_gen_id(tdbb, genId, false, step);
+		}
+
+		GeneratorValues* entry = NULL;
+		ULONG generation;
+
+		{ // scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			FB_SIZE_T pos;
+			if (m_generators.find(genId, pos))
+			{
+				entry = m_generators[pos];
+
+				if (entry->remaining && entry->step == step && entry->lock->lck_logical != LCK_none)
+				{
+					value = entry->next;
+					entry->next += step;
+					entry->remaining--;
+					return value;
+				}
+			}
+			else
+			{
+				entry = FB_NEW_POOL(m_pool) GeneratorValues(this, genId);
+				entry->lock = FB_NEW_RPT(m_pool, 0)
+					Lock(tdbb, sizeof(SLONG), LCK_gen_cache, entry, blockingAst);
+				entry->lock->setKey(genId);
+				m_generators.insert(pos, entry);
+			}
+
+		}
+
+		// Only one thread reserves a block, the others wait for it
+		// and take their values from the cache then
+
+		MutexLockGuard refillGuard(entry->refillMutex, FB_FUNCTION);
+
+		{ // scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			if (entry->remaining && entry->step == step && entry->lock->lck_logical != LCK_none)
+			{
+				value = entry->next;
+				entry->next += step;
+				entry->remaining--;
+				return value;
+			}
+
+			generation = entry->generation;
+		}
+
+		// The lock is taken before the block is reserved, so a restart of the
+		// sequence done after the reservation discards the block for sure.
+		// Lock manager calls are done without m_mutex as the AST acquires it.
+
+		{ // scope
+			MutexLockGuard lockGuard(m_lockMutex, FB_FUNCTION);
+
+			if (entry->lock->lck_logical == LCK_none &&
+				!LCK_lock(tdbb, entry->lock, LCK_SR, LCK_NO_WAIT))
+			{
+				// Someone is restarting the sequence right now, don't cache anything
+				fb_utils::init_status(tdbb->tdbb_status_vector);
+				return DPM_gen_id(tdbb, genId, false, step);
+			}
+		}
+
+		const SINT64 last = DPM_gen_id(tdbb, genId, false, step * cacheSize);
+		value = last - step * (cacheSize - 1);
+
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+		// Values could be discarded while we were reserving them.
+		// Then only the first value is used and the rest of the block is lost.
+
+		if (entry->generation == generation && entry->lock->lck_logical != LCK_none)
+		{
+			entry->next = value + step;
+			entry->step = step;
+			entry->remaining = cacheSize - 1;
+		}
+
+		return value;
+	}
+
+	void Database::GeneratorCache::shutdown(thread_db* tdbb)
+	{
+		for (FB_SIZE_T i = 0; i < m_generators.getCount(); i++)
+		{
+			Lock* const lock = m_generators[i]->lock;
+
+			if (lock->lck_logical != LCK_none)
+				LCK_release(tdbb, lock);
+		}
+	}
+
+	void Database::GeneratorCache::invalidate(thread_db* tdbb, SLONG genId)
+	{
+		// Discard cached values of the sequence here and in every other
+		// database block. Our own lock is released first, otherwise we would
+		// wait for ourselves as both locks have the same owner.
+		// Nothing is cached by the database blocks that are not shared.
+
+		if (!(tdbb->getDatabase()->dbb_flags & DBB_shared))
+			return;
+
+		MutexLockGuard lockGuard(m_lockMutex, FB_FUNCTION);
+
+		{ // scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			FB_SIZE_T pos;
+			if (m_generators.find(genId, pos))
+			{
+				GeneratorValues* const entry = m_generators[pos];
+
+				entry->remaining = 0;
+				entry->generation++;
+
+				if (entry->lock->lck_logical != LCK_none)
+					LCK_release(tdbb, entry->lock);
+			}
+		}
+
+		Lock temp_lock(tdbb, sizeof(SLONG), LCK_gen_cache);
+		temp_lock.setKey(genId);
+
+		LCK_lock(tdbb, &temp_lock, LCK_EX, LCK_WAIT);
+		LCK_release(tdbb, &temp_lock);
+	}
+
+	int Database::GeneratorCache::blockingAst(void* ast_object)
+	{
+		GeneratorValues* const entry = static_cast<GeneratorValues*>(ast_object);
+
+		try
+		{
+			Database* const dbb = entry->lock->lck_dbb;
+
+			AsyncContextHolder tdbb(dbb, FB_FUNCTION, entry->lock);
+
+			MutexLockGuard guard(entry->cache->m_mutex, FB_FUNCTION);
+
+			entry->remaining = 0;
+			entry->generation++;
+
+			LCK_release(tdbb, entry->lock);
+		}
+		catch (const Exception&)
+		{} // no-op
+
+		return 0;
+	}
+
 	void Database::Linger::handler()
 	{
 		JRD_shutdown_database(dbb, SHUT_DBB_RELEASE_POOLS);
@@ -59,6 +59,7 @@
 #include "../jrd/sbm.h"
 #include "../jrd/flu.h"
 #include "../jrd/RuntimeStatistics.h"
+#include "../jrd/WorkMemory.h"
 #include "../jrd/event_proto.h"
 #include "../jrd/ExtEngineManager.h"
 #include "../lock/lock_proto.h"
@@ -219,6 +220,7 @@ const ULONG DBB_no_fs_cache				= 0x40000L;		// Not using file system cache
 const ULONG DBB_sweep_starting			= 0x80000L;		// Auto-sweep is starting
 const ULONG DBB_creating				= 0x100000L;	// Database creation is in progress
 const ULONG DBB_shared					= 0x200000L;	// Database object is shared among connections
+const ULONG DBB_lz_records				= 0x400000L;	// Pack new records using LZ when it's shorter
 
 //
 // dbb_ast_flags
@@ -274,6 +276,131 @@ public:
 		bool m_localOnly;
 	};
 
+	// Stored relation formats shared by the attachments of this database block.
+	// Formats of a relation are kept as long as the cache holds the relation
+	// formats lock, anyone dropping the relation or storing a new format revokes it.
+	// Only SuperServer shares the block between attachments, so the cache and
+	// its lock are bypassed when the database block is not shared (Classic and
+	// SuperClassic), every attachment reads RDB$FORMATS itself there.
+
+	class FormatCache
+	{
+		struct RelationFormats
+		{
+			RelationFormats(MemoryPool& pool, FormatCache* owner, USHORT id)
+				: cache(owner), relId(id), lock(NULL), generation(1), formats(pool)
+			{}
+
+			~RelationFormats()
+			{
+				clear();
+				delete lock;
+			}
+
+			void clear()
+			{
+				for (FB_SIZE_T i = 0; i < formats.getCount(); i++)
+					delete formats[i];
+
+				formats.clear();
+			}
+
+			static const USHORT generate(const RelationFormats* item)
+			{
+				return item->relId;
+			}
+
+			FormatCache* const cache;
+			const USHORT relId;
+			Lock* lock;						// relation formats lock
+			ULONG generation;				// incremented each time formats are discarded
+			Firebird::Array<Firebird::UCharBuffer*> formats;
+		};
+
+	public:
+		explicit FormatCache(MemoryPool& pool)
+			: m_pool(pool), m_relations(pool)
+		{}
+
+		~FormatCache()
+		{
+			while (m_relations.hasData())
+				delete m_relations.pop();
+		}
+
+		bool get(thread_db* tdbb, USHORT relId, USHORT number,
+			Firebird::UCharBuffer& buffer, ULONG& generation);
+		void put(USHORT relId, USHORT number, ULONG generation, const UCHAR* data, ULONG length);
+		void invalidate(thread_db* tdbb, USHORT relId);
+		void shutdown(thread_db* tdbb);
+
+	private:
+		static int blockingAst(void* ast_object);
+
+		MemoryPool& m_pool;
+		Firebird::SyncObject m_sync;
+		Firebird::Mutex m_lockMutex;
+		Firebird::SortedArray<RelationFormats*, Firebird::EmptyStorage<RelationFormats*>,
+			USHORT, RelationFormats> m_relations;
+	};
+
+	// Blocks of values reserved from sequences declared with CACHE. Values of
+	// a sequence are handed out as long as the cache holds its generator cache
+	// lock, anyone restarting or recreating the sequence revokes it.
+
+	class GeneratorCache
+	{
+		struct GeneratorValues
+		{
+			GeneratorValues(GeneratorCache* owner, SLONG id)
+				: cache(owner), genId(id), lock(NULL), generation(1), next(0), step(0), remaining(0)
+			{}
+
+			~GeneratorValues()
+			{
+				delete lock;
+			}
+
+			static const SLONG generate(const GeneratorValues* item)
+			{
+				return item->genId;
+			}
+
+			GeneratorCache* const cache;
+			const SLONG genId;
+			Lock* lock;						// generator cache lock
+			Firebird::Mutex refillMutex;	// serializes reservation of blocks
+			ULONG generation;				// incremented each time values are discarded
+			SINT64 next;					// next value to hand out
+			SINT64 step;					// increment the block was reserved with
+			SLONG remaining;				// values left in the block
+		};
+
+	public:
+		explicit GeneratorCache(MemoryPool& pool)
+			: m_pool(pool), m_generators(pool)
+		{}
+
+		~GeneratorCache()
+		{
+			while (m_generators.hasData())
+				delete m_generators.pop();
+		}
+
+		SINT64 next(thread_db* tdbb, SLONG genId, SINT64 step, SLONG cacheSize);
+		void invalidate(thread_db* tdbb, SLONG genId);
+		void shutdown(thread_db* tdbb);
+
+	private:
+		static int blockingAst(void* ast_object);
+
+		MemoryPool& m_pool;
+		Firebird::Mutex m_mutex;
+		Firebird::Mutex m_lockMutex;
+		Firebird::SortedArray<GeneratorValues*, Firebird::EmptyStorage<GeneratorValues*>,
+			SLONG, GeneratorValues> m_generators;
+	};
+
 	class ExistenceRefMutex : public Firebird::RefCounted
 	{
 	public:
@@ -433,6 +560,7 @@ public:
 
 	Firebird::SyncObject			dbb_sortbuf_sync;
 	Firebird::Array<UCHAR*>			dbb_sort_buffers;	// sort buffers ready for reuse
+	WorkMemoryBroker				dbb_work_memory;	// work memory shared by attachments
 
 	TraNumber dbb_oldest_active;		// Cached "oldest active" transaction
 	TraNumber dbb_oldest_transaction;	// Cached "oldest interesting" transaction
@@ -468,6 +596,8 @@ public:
 	Firebird::RefPtr<const Config> dbb_config;
 
 	SharedCounter dbb_shared_counter;
+	FormatCache dbb_format_cache;
+	GeneratorCache dbb_gen_cache;
 	CryptoManager* dbb_crypto_manager;
 	Firebird::RefPtr<ExistenceRefMutex> dbb_init_fini;
 	Firebird::RefPtr<Linger> dbb_linger_timer;
@@ -525,6 +655,8 @@ private:
 		dbb_creation_date(Firebird::TimeStamp::getCurrentTimeStamp()),
 		dbb_external_file_directory_list(NULL),
 		dbb_shared_counter(shared),
+		dbb_format_cache(*p),
+		dbb_gen_cache(*p),
 		dbb_init_fini(FB_NEW_POOL(*getDefaultMemoryPool()) ExistenceRefMutex()),
 		dbb_linger_seconds(0),
 		dbb_linger_end(0),
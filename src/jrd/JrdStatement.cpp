@@ -162,6 +162,15 @@ JrdStatement::JrdStatement(thread_db* tdbb, MemoryPool* p, CompilerScratch* csb)
 			if (!tail->csb_fields && !(tail->csb_flags & csb_update))
 				 rpb->rpb_stream_flags |= RPB_s_no_data;
 
+			// if the stream is not intended for update, its records could be
+			// decompressed up to the last referenced field only
+			if (tail->csb_fields && !(tail->csb_flags & csb_update) &&
+				tail->csb_fields->getLast() && tail->csb_fields->current() < MAX_USHORT)
+			{
+				rpb->rpb_stream_flags |= RPB_s_partial;
+				rpb->rpb_last_field = (USHORT) tail->csb_fields->current();
+			}
+
 			rpb->rpb_relation = tail->csb_relation;
 
 			delete tail->csb_fields;
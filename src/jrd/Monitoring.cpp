@@ -938,6 +938,11 @@ void Monitoring::putAttachment(SnapshotData::DumpRecord& record, const Jrd::Atta
 		record.storeTimestamp(f_mon_att_idle_timer, idleTimer);
 	// statement timeout, milliseconds
 	record.storeInteger(f_mon_att_stmt_timeout, attachment->getStatementTimeout());
+	// work memory of sorts, hash joins and temporary spaces
+	const WorkMemory& workMemory = attachment->att_work_memory;
+	record.storeInteger(f_mon_att_work_mem_used, workMemory.getUsed());
+	record.storeInteger(f_mon_att_work_mem_grant, workMemory.getGrant());
+	record.storeInteger(f_mon_att_work_mem_spilled, workMemory.getSpilled());
 
 	record.write();
 
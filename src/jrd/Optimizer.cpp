@@ -429,6 +429,77 @@ InversionNode* OptimizerRetrieval::composeInversion(InversionNode* node1, Invers
 	return FB_NEW_POOL(pool) InversionNode(node_type, node1, node2);
 }
 
+bool OptimizerRetrieval::estimateLeadingSegment(const IndexScratch* indexScratch,
+	double& selectivity) const
+{
+/**************************************
+ *
+ *	e s t i m a t e L e a d i n g S e g m e n t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Estimate the selectivity of the leading index
+ *	segment matched against constants, using the
+ *	distribution of its values gathered together
+ *	with the index statistics.
+ *
+ **************************************/
+
+	const index_desc* const idx = indexScratch->idx;
+	const IndexScratchSegment* const segment = indexScratch->segments[0];
+
+	switch (segment->scanType)
+	{
+		case segmentScanEqual:
+		case segmentScanBetween:
+		case segmentScanLess:
+		case segmentScanGreater:
+			break;
+
+		default:
+			return false;
+	}
+
+	// Unique values cannot be skewed, and instances of a GTT share the stored statistics
+	if ((idx->idx_flags & idx_unique) || !relation || relation->isTemporary())
+		return false;
+
+	const dsc* lower = NULL;
+	const dsc* upper = NULL;
+
+	if (segment->lowerValue)
+	{
+		const LiteralNode* const literal = nodeAs<LiteralNode>(segment->lowerValue);
+
+		if (!literal)
+			return false;
+
+		lower = &literal->litDesc;
+	}
+
+	if (segment->upperValue)
+	{
+		const LiteralNode* const literal = nodeAs<LiteralNode>(segment->upperValue);
+
+		if (!literal)
+			return false;
+
+		upper = &literal->litDesc;
+	}
+
+	const IndexDistribution* const distribution =
+		MET_lookup_index_distribution(tdbb, relation, idx);
+
+	if (!distribution)
+		return false;
+
+	if (segment->scanType == segmentScanEqual)
+		return distribution->estimateEquality(tdbb, idx, lower, selectivity);
+
+	return distribution->estimateRange(tdbb, idx, lower, upper, selectivity);
+}
+
 const string& OptimizerRetrieval::getAlias()
 {
 /**************************************
@@ -628,6 +699,27 @@ IndexTableScan* OptimizerRetrieval::getNavigation()
 	const USHORT key_length =
 		ROUNDUP(BTR_key_length(tdbb, relation, navigationCandidate->idx), sizeof(SLONG));
 
+	// The walk rebuilds the key from every fetched record, so all the fields
+	// the key depends on must be decompressed even if nothing else refers to
+	// them. Expression may depend on any field.
+
+	const index_desc* const idx = navigationCandidate->idx;
+	MemoryPool* const pool = tdbb->getDefaultPool();
+	UInt32Bitmap** const fields = &csb->csb_rpt[stream].csb_fields;
+
+	if (idx->idx_flags & idx_expressn)
+	{
+		const Format* const format = CMP_format(tdbb, csb, stream);
+
+		for (ULONG id = 0; id < format->fmt_count; ++id)
+			SBM_SET(pool, fields, id);
+	}
+	else
+	{
+		for (USHORT i = 0; i < idx->idx_count; ++i)
+			SBM_SET(pool, fields, idx->idx_rpt[i].idx_field);
+	}
+
 	InversionNode* const index_node = makeIndexScanNode(navigationCandidate);
 
 	return FB_NEW_POOL(*tdbb->getDefaultPool())
@@ -660,6 +752,10 @@ void OptimizerRetrieval::analyzeNavigation()
 		if (sort->expressions.getCount() > idx->idx_count)
 			continue;
 
+		// trigram index keys are unordered regarding the field values
+		if (idx->idx_flags & idx_trigram)
+			continue;
+
 		// if the user-specified access plan for this request didn't
 		// mention this index, forget it
 		if ((idx->idx_runtime_flags & idx_plan_dont_use) &&
@@ -848,6 +944,18 @@ void OptimizerRetrieval::getInversionCandidates(InversionCandidateList* inversio
 
 			bool unique = false;
 
+			// The stored selectivity assumes the values are distributed uniformly. If the
+			// leading segment is compared with constants and its actual distribution is known,
+			// use it instead and correct the selectivity of the next segments accordingly.
+			double leadingSelectivity = 0;
+			double skew = 1;
+
+			if (estimateLeadingSegment(&scratch, leadingSelectivity) &&
+				scratch.idx->idx_rpt[0].idx_selectivity > 0)
+			{
+				skew = leadingSelectivity / scratch.idx->idx_rpt[0].idx_selectivity;
+			}
+
 			for (int j = 0; j < scratch.idx->idx_count; j++)
 			{
 				const IndexScratchSegment* const segment = scratch.segments[j];
@@ -882,7 +990,17 @@ void OptimizerRetrieval::getInversionCandidates(InversionCandidateList* inversio
 					// This is a perfect usable segment thus update root selectivity
 					scratch.lowerCount++;
 					scratch.upperCount++;
-					scratch.selectivity = scratch.idx->idx_rpt[j].idx_selectivity;
+
+					if (j == 0 && leadingSelectivity > 0)
+						scratch.selectivity = leadingSelectivity;
+					else if (skew != 1)
+					{
+						scratch.selectivity = MIN(scratch.idx->idx_rpt[j].idx_selectivity * skew,
+							scratch.selectivity);
+					}
+					else
+						scratch.selectivity = scratch.idx->idx_rpt[j].idx_selectivity;
+
 					scratch.nonFullMatchedSegments = scratch.idx->idx_count - (j + 1);
 					// Add matches for this segment to the main matches list
 					matches.join(segment->matches);
@@ -944,6 +1062,7 @@ void OptimizerRetrieval::getInversionCandidates(InversionCandidateList* inversio
 							break;
 
 						case segmentScanStarting:
+						case segmentScanTrigram:
 						case segmentScanEqual:
 						case segmentScanEquivalent:
 							scratch.lowerCount++;
@@ -957,6 +1076,15 @@ void OptimizerRetrieval::getInversionCandidates(InversionCandidateList* inversio
 							break;
 					}
 
+					if (j == 0 && leadingSelectivity > 0)
+					{
+						// The range of the leading segment values is estimated already
+						selectivity = leadingSelectivity;
+						factor = 0;
+					}
+					else if (skew != 1 && segment->scanType != segmentScanNone)
+						selectivity = MIN(selectivity * skew, scratch.selectivity);
+
 					// Adjust the compound selectivity using the reduce factor.
 					// It should be better than the previous segment but worse
 					// than a full match.
@@ -1141,6 +1269,17 @@ InversionNode* OptimizerRetrieval::makeIndexScanNode(IndexScratch* indexScratch)
 		if (segment[i]->scanType == segmentScanStarting)
 			retrieval->irb_generic |= irb_starting;
 
+		if (segment[i]->scanType == segmentScanTrigram)
+		{
+			retrieval->irb_generic |= irb_trigram;
+
+			const ComparativeBoolNode* const cmpNode =
+				nodeAs<ComparativeBoolNode>(segment[i]->matches[0]);
+
+			if (cmpNode->blrOp == blr_like)
+				retrieval->irb_generic |= irb_trigram_like;
+		}
+
 		if (segment[i]->excludeLower)
 			retrieval->irb_generic |= irb_exclude_lower;
 
@@ -1675,6 +1814,44 @@ bool OptimizerRetrieval::matchBoolean(IndexScratch* indexScratch, BoolExprNode*
 		return false;
 	}
 
+	if (indexScratch->idx->idx_flags & idx_trigram)
+	{
+		// Trigram index serves only CONTAINING and LIKE without ESCAPE
+		// having the indexed field at the left side. Its scan returns
+		// candidates, so the boolean itself is still evaluated later.
+
+		FieldNode* fieldNode;
+
+		if (!cmpNode ||
+			!(cmpNode->blrOp == blr_containing || (cmpNode->blrOp == blr_like && !cmpNode->arg3)) ||
+			!(fieldNode = nodeAs<FieldNode>(match)) ||
+			fieldNode->fieldStream != stream ||
+			fieldNode->fieldId != indexScratch->idx->idx_rpt[0].idx_field ||
+			!value->computable(csb, stream, false))
+		{
+			return false;
+		}
+
+		IndexScratchSegment* const segment = indexScratch->segments[0];
+
+		// Only one pattern is looked up in the index
+		if (segment->scanType == segmentScanTrigram)
+			return false;
+
+		segment->matches.add(boolean);
+		segment->lowerValue = segment->upperValue = value;
+		segment->scanType = segmentScanTrigram;
+		segment->excludeLower = false;
+		segment->excludeUpper = false;
+
+		if (segment->scope < scope)
+			segment->scope = scope;
+
+		indexScratch->candidate = true;
+
+		return true;
+	}
+
 	ValueExprNode* value2 = (cmpNode && cmpNode->blrOp == blr_between) ?
 		cmpNode->arg3 : NULL;
 
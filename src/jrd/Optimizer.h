@@ -88,7 +88,8 @@ enum segmentScanType {
 	segmentScanEqual,
 	segmentScanEquivalent,
 	segmentScanMissing,
-	segmentScanStarting
+	segmentScanStarting,
+	segmentScanTrigram
 };
 
 class IndexScratchSegment
@@ -183,6 +184,7 @@ protected:
 	void analyzeNavigation();
 	InversionNode* composeInversion(InversionNode* node1, InversionNode* node2,
 		InversionNode::Type node_type) const;
+	bool estimateLeadingSegment(const IndexScratch* indexScratch, double& selectivity) const;
 	const Firebird::string& getAlias();
 	InversionCandidate* generateInversion();
 	void getInversionCandidates(InversionCandidateList* inversions,
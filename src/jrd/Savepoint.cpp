@@ -20,6 +20,7 @@
 #include "firebird.h"
 #include "../common/gdsassert.h"
 #include "../jrd/tra.h"
+#include "../jrd/sqz.h"
 #include "../jrd/blb_proto.h"
 #include "../jrd/cch_proto.h"
 #include "../jrd/dfw_proto.h"
@@ -39,8 +40,30 @@ UndoItem::UndoItem(jrd_tra* transaction, RecordNumber recordNumber, const Record
 	: m_number(recordNumber.getValue()), m_format(record->getFormat())
 {
 	fb_assert(m_format);
-	m_offset = transaction->getUndoSpace()->allocateSpace(m_format->fmt_length);
-	transaction->getUndoSpace()->write(m_offset, record->getData(), record->getLength());
+
+	// Undo data is compressed the same way as records on data pages,
+	// it's stored as is only if compression doesn't save anything
+
+	const Compressor dcc(*transaction->tra_pool, record->getLength(), record->getData());
+	m_length = (ULONG) dcc.getPackedLength();
+
+	TempSpace* const undoSpace = transaction->getUndoSpace();
+
+	if (m_length < record->getLength())
+	{
+		HalfStaticArray<UCHAR, BUFFER_MEDIUM> buffer(*transaction->tra_pool);
+		UCHAR* const packed = buffer.getBuffer(m_length);
+		dcc.pack(record->getData(), packed);
+
+		m_offset = undoSpace->allocateSpace(m_length);
+		undoSpace->write(m_offset, packed, m_length);
+	}
+	else
+	{
+		m_length = record->getLength();
+		m_offset = undoSpace->allocateSpace(m_length);
+		undoSpace->write(m_offset, record->getData(), m_length);
+	}
 }
 
 Record* UndoItem::setupRecord(jrd_tra* transaction) const
@@ -48,7 +71,23 @@ Record* UndoItem::setupRecord(jrd_tra* transaction) const
 	if (m_format)
 	{
 		Record* const record = transaction->getUndoRecord(m_format);
-		transaction->getUndoSpace()->read(m_offset, record->getData(), record->getLength());
+		TempSpace* const undoSpace = transaction->getUndoSpace();
+
+		if (m_length < record->getLength())
+		{
+			HalfStaticArray<UCHAR, BUFFER_MEDIUM> buffer(*transaction->tra_pool);
+			UCHAR* const packed = buffer.getBuffer(m_length);
+			undoSpace->read(m_offset, packed, m_length);
+
+			const UCHAR* const end =
+				Compressor::unpack(m_length, packed, record->getLength(), record->getData());
+
+			if (end != record->getData() + record->getLength())
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+		}
+		else
+			undoSpace->read(m_offset, record->getData(), m_length);
+
 		return record;
 	}
 
@@ -59,7 +98,7 @@ void UndoItem::release(jrd_tra* transaction)
 {
 	if (m_format)
 	{
-		transaction->getUndoSpace()->releaseSpace(m_offset, m_format->fmt_length);
+		transaction->getUndoSpace()->releaseSpace(m_offset, m_length);
 		m_format = NULL;
 	}
 }
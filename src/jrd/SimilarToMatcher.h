@@ -367,6 +367,35 @@ private:
 		bool match(int start);
 #else
 		bool match();
+
+		// Failed (node, position) pairs of the current match. The rest of the pattern
+		// starting at a given node and position matches or not regardless of how it was
+		// reached, so backtracking never needs to retry it. This bounds the cost of a
+		// match by nodes * positions instead of growing exponentially with nested
+		// repetitions and alternatives.
+		bool isFailed(const Node* node) const
+		{
+			if (failures.isEmpty())
+				return false;
+
+			const FB_SIZE_T bit = (node - nodes.begin()) * (bufferEnd - bufferStart + 1) +
+				(bufferPos - bufferStart);
+			return (failures[bit / 8] & (1 << (bit % 8))) != 0;
+		}
+
+		void setFailed(const Node* node)
+		{
+			const FB_SIZE_T positions = bufferEnd - bufferStart + 1;
+
+			if (failures.isEmpty())
+			{
+				const FB_SIZE_T size = (nodes.getCount() * positions + 7) / 8;
+				memset(failures.getBuffer(size), 0, size);
+			}
+
+			const FB_SIZE_T bit = (node - nodes.begin()) * positions + (bufferPos - bufferStart);
+			failures[bit / 8] |= (1 << (bit % 8));
+		}
 #endif
 
 	private:
@@ -401,6 +430,9 @@ private:
 		const CharType* bufferEnd;
 		const CharType* bufferPos;
 		CharType metaCharacters[15];
+#ifndef RECURSIVE_SIMILAR
+		HalfStaticArray<UCHAR, BUFFER_SMALL> failures;
+#endif
 
 	public:
 		unsigned branchNum;
@@ -486,6 +518,9 @@ SimilarToMatcher<CharType, StrConverter>::Evaluator::Evaluator(
 	  patternCvt(pool, textType, patternStr, patternLen),
 	  charSet(textType->getCharSet()),
 	  nodes(pool),
+#ifndef RECURSIVE_SIMILAR
+	  failures(pool),
+#endif
 	  branchNum(0)
 {
 	fb_assert(patternLen % sizeof(CharType) == 0);
@@ -1390,6 +1425,15 @@ bool SimilarToMatcher<CharType, StrConverter>::Evaluator::match()
 		msReturningMask		= (msReturningFalse | msReturningTrue)
 	};
 
+	// Don't remember failures when their bitmap would be too large, for example for
+	// a long blob matched by a complex pattern.
+	static const FB_SIZE_T MAX_FAILURE_BITS = 8 * 1024 * 1024;
+
+	const FB_SIZE_T positions = bufferEnd - bufferStart + 1;
+	const bool memoize = positions <= MAX_FAILURE_BITS / nodes.getCount();
+
+	failures.shrink(0);
+
 	SimpleStack<Scope> scopeStack;
 
 	// Add special node to return without needing additional comparison after popping
@@ -1467,12 +1511,23 @@ bool SimilarToMatcher<CharType, StrConverter>::Evaluator::match()
 
 				scope->save = bufferPos;
 
+				// Failures are remembered only outside of counted repetitions,
+				// as inside them the rest of the match depends on repeatCount.
+				if (memoize && repeatStack.getCount() == 0 && isFailed(scope->i + 1))
+				{
+					state = msReturningFalse;
+					continue;
+				}
+
 				scopeStack.push(scope->i + 1);
 				continue;
 
 			case ENCODE_OP_STATE(opBranch, msReturningFalse):
 				bufferPos = scope->save;
 
+				if (memoize && repeatStack.getCount() == 0)
+					setFailed(scope->i + 1);
+
 				if (node->ref != 0)
 				{
 					state = msIterating;
@@ -1483,6 +1538,12 @@ bool SimilarToMatcher<CharType, StrConverter>::Evaluator::match()
 					{
 						scope->save = bufferPos;
 
+						if (memoize && repeatStack.getCount() == 0 && isFailed(scope->i + 1))
+						{
+							state = msReturningFalse;
+							continue;
+						}
+
 						scopeStack.push(scope->i + 1);
 						continue;
 					}
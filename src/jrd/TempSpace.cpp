@@ -31,18 +31,31 @@
 #include "../common/isc_proto.h"
 #include "../common/os/path_utils.h"
 
+#include "../jrd/sqz.h"
+#include "../jrd/WorkMemory.h"
+
 #include "../jrd/TempSpace.h"
 
 using Firebird::TempFile;
+using Firebird::MutexLockGuard;
+using Firebird::MutexUnlockGuard;
 
 // Static definitions/initializations
 
 const size_t MIN_TEMP_BLOCK_SIZE = 64 * 1024;
 
+// Frames of temporary files, blocks in files are always aligned at frame boundary
+const FB_SIZE_T FRAME_SIZE = 32 * 1024;
+const FB_SIZE_T SYNC_FRAMES = 4;			// frames cached when only compression is used
+const FB_SIZE_T ASYNC_FRAMES = 64;			// frames cached with write-behind and read-ahead
+const FB_SIZE_T READ_AHEAD_FRAMES = 4;		// frames read ahead for a sequential reader
+
 Firebird::GlobalPtr<Firebird::Mutex> TempSpace::initMutex;
 Firebird::TempDirectoryList* TempSpace::tempDirs = NULL;
 FB_SIZE_T TempSpace::minBlockSize = 0;
 offset_t TempSpace::globalCacheUsage = 0;
+bool TempSpace::spillCompression = false;
+bool TempSpace::spillAsyncIO = false;
 
 //
 // In-memory block class
@@ -79,6 +92,13 @@ FB_SIZE_T TempSpace::FileBlock::read(offset_t offset, void* buffer, FB_SIZE_T le
 		length = size - offset;
 	}
 	offset += seek;
+
+	if (cache)
+	{
+		cache->read(file, offset, buffer, length);
+		return length;
+	}
+
 	return file->read(offset, buffer, length);
 }
 
@@ -89,9 +109,536 @@ FB_SIZE_T TempSpace::FileBlock::write(offset_t offset, const void* buffer, FB_SI
 		length = size - offset;
 	}
 	offset += seek;
+
+	if (cache)
+	{
+		cache->write(file, offset, buffer, length);
+		return length;
+	}
+
 	return file->write(offset, buffer, length);
 }
 
+//
+// Cache of temporary file frames
+//
+
+TempSpace::SpillCache::SpillCache(MemoryPool& p, bool aCompress, bool aAsync)
+	: pool(p), compress(aCompress), async(aAsync),
+	  memory(p), frames(p), files(p), jobs(p), ownerScratch(p), workerScratch(p),
+	  nextStream(0), stamp(0), stopping(false), failed(false)
+{
+	const FB_SIZE_T count = async ? ASYNC_FRAMES : SYNC_FRAMES;
+	UCHAR* const data = memory.getBuffer(count * FRAME_SIZE);
+	Frame* const frame = frames.getBuffer(count);
+
+	for (FB_SIZE_T i = 0; i < count; i++)
+	{
+		frame[i].file = NULL;
+		frame[i].number = 0;
+		frame[i].data = data + i * FRAME_SIZE;
+		frame[i].state = FRAME_FREE;
+		frame[i].stamp = 0;
+	}
+
+	memset(streams, 0, sizeof(streams));
+
+	if (async)
+	{
+		try
+		{
+			Thread::start(workerThread, this, THREAD_medium, &workerHandle);
+		}
+		catch (const Firebird::Exception& ex)
+		{
+			// no background thread, work synchronously
+			iscLogException("TempSpace: cannot start the writer thread", ex);
+			async = false;
+		}
+	}
+}
+
+TempSpace::SpillCache::~SpillCache()
+{
+	if (async)
+	{
+		{	// scope
+			MutexLockGuard guard(mutex, FB_FUNCTION);
+
+			// data is not needed anymore, don't store it
+			jobs.clear();
+			stopping = true;
+		}
+
+		wakeup.release();
+		Thread::waitForCompletion(workerHandle);
+	}
+
+	while (files.hasData())
+		delete files.pop();
+}
+
+//
+// TempSpace::SpillCache::read
+//
+// Reads bytes from the temporary file through the cache
+//
+
+void TempSpace::SpillCache::read(TempFile* file, offset_t offset, void* buffer, FB_SIZE_T length)
+{
+	checkError();
+
+	const offset_t first = offset / FRAME_SIZE;
+	UCHAR* p = static_cast<UCHAR*>(buffer);
+
+	while (length)
+	{
+		const offset_t number = offset / FRAME_SIZE;
+		const FB_SIZE_T start = (FB_SIZE_T) (offset % FRAME_SIZE);
+		const FB_SIZE_T n = MIN(length, FRAME_SIZE - start);
+
+		const Frame* const frame = getFrame(file, number, false, true);
+		memcpy(p, frame->data + start, n);
+
+		p += n;
+		offset += n;
+		length -= n;
+	}
+
+	if (async)
+		readAhead(file, first, (offset - 1) / FRAME_SIZE);
+}
+
+//
+// TempSpace::SpillCache::write
+//
+// Writes bytes to the temporary file through the cache
+//
+
+void TempSpace::SpillCache::write(TempFile* file, offset_t offset, const void* buffer, FB_SIZE_T length)
+{
+	checkError();
+
+	const UCHAR* p = static_cast<const UCHAR*>(buffer);
+
+	while (length)
+	{
+		const offset_t number = offset / FRAME_SIZE;
+		const FB_SIZE_T start = (FB_SIZE_T) (offset % FRAME_SIZE);
+		const FB_SIZE_T n = MIN(length, FRAME_SIZE - start);
+
+		// frame that is overwritten completely needs not to be loaded
+		Frame* const frame = getFrame(file, number, true, n < FRAME_SIZE);
+		memcpy(frame->data + start, p, n);
+
+		MutexLockGuard guard(mutex, FB_FUNCTION);
+
+		// write the frame behind as soon as its end is reached
+		if (async && start + n == FRAME_SIZE)
+			queue(frame, FRAME_STORING);
+		else
+			frame->state = FRAME_DIRTY;
+
+		p += n;
+		offset += n;
+		length -= n;
+	}
+}
+
+//
+// TempSpace::SpillCache::getFrame
+//
+// Returns the frame with the given number, loading it if asked. Frames being
+// loaded in background are waited for, as well as frames being stored if the
+// frame is going to be modified.
+//
+
+TempSpace::SpillCache::Frame* TempSpace::SpillCache::getFrame(TempFile* file, offset_t number,
+	bool modify, bool load)
+{
+	Frame* frame;
+
+	{	// scope
+		MutexLockGuard guard(mutex, FB_FUNCTION);
+
+		while ((frame = findFrame(file, number)))
+		{
+			if (frame->state == FRAME_LOADING || (modify && frame->state == FRAME_STORING))
+			{
+				MutexUnlockGuard cout(mutex, FB_FUNCTION);
+				done.enter();
+				continue;
+			}
+
+			frame->stamp = ++stamp;
+			return frame;
+		}
+
+		frame = getVictim(true);
+		frame->file = file;
+		frame->number = number;
+		frame->state = FRAME_FREE;
+		frame->stamp = ++stamp;
+	}
+
+	// The frame is not visible to anybody until it becomes clean,
+	// so it's loaded without holding the mutex
+
+	if (load)
+		loadFrame(frame, ownerScratch);
+
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+	frame->state = FRAME_CLEAN;
+
+	return frame;
+}
+
+//
+// TempSpace::SpillCache::findFrame
+//
+// Looks for the cached frame, must be called with the mutex locked
+//
+
+TempSpace::SpillCache::Frame* TempSpace::SpillCache::findFrame(TempFile* file, offset_t number)
+{
+	for (Frame* frame = frames.begin(); frame < frames.end(); frame++)
+	{
+		if (frame->state != FRAME_FREE && frame->file == file && frame->number == number)
+			return frame;
+	}
+
+	return NULL;
+}
+
+//
+// TempSpace::SpillCache::getVictim
+//
+// Returns free or the least recently used clean frame, must be called with
+// the mutex locked. If asked to wait, dirty frames are stored to get one.
+//
+
+TempSpace::SpillCache::Frame* TempSpace::SpillCache::getVictim(bool wait)
+{
+	while (true)
+	{
+		Frame* clean = NULL;
+		Frame* dirty = NULL;
+
+		for (Frame* frame = frames.begin(); frame < frames.end(); frame++)
+		{
+			if (frame->state == FRAME_FREE)
+				return frame;
+
+			if (frame->state == FRAME_CLEAN && (!clean || frame->stamp < clean->stamp))
+				clean = frame;
+			else if (frame->state == FRAME_DIRTY && (!dirty || frame->stamp < dirty->stamp))
+				dirty = frame;
+		}
+
+		if (clean || !wait)
+			return clean;
+
+		if (dirty)
+		{
+			if (async)
+			{
+				queue(dirty, FRAME_STORING);
+				continue;
+			}
+
+			{	// scope
+				MutexUnlockGuard cout(mutex, FB_FUNCTION);
+				storeFrame(dirty, ownerScratch);
+			}
+
+			dirty->state = FRAME_CLEAN;
+			return dirty;
+		}
+
+		// all frames are processed by the worker
+		MutexUnlockGuard cout(mutex, FB_FUNCTION);
+		done.enter();
+	}
+}
+
+//
+// TempSpace::SpillCache::readAhead
+//
+// Starts loading the frames following the ones just read, if the reader
+// continues from the place where it stopped before
+//
+
+void TempSpace::SpillCache::readAhead(TempFile* file, offset_t first, offset_t last)
+{
+	Stream* stream = NULL;
+
+	for (unsigned i = 0; i < MAX_STREAMS; i++)
+	{
+		if (streams[i].file == file &&
+			(streams[i].last == first || streams[i].last + 1 == first))
+		{
+			stream = &streams[i];
+			break;
+		}
+	}
+
+	if (!stream)
+	{
+		// remember the new reader instead of the oldest one
+		stream = &streams[nextStream++ % MAX_STREAMS];
+		stream->file = file;
+		stream->last = last;
+		return;
+	}
+
+	stream->last = last;
+
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	for (offset_t number = last + 1; number <= last + READ_AHEAD_FRAMES; number++)
+	{
+		if (findFrame(file, number))
+			continue;
+
+		// never stored frames are not worth reading
+		if (!getLength(file, number))
+			break;
+
+		Frame* const frame = getVictim(false);
+		if (!frame)
+			break;
+
+		frame->file = file;
+		frame->number = number;
+		frame->stamp = ++stamp;
+		queue(frame, FRAME_LOADING);
+	}
+}
+
+//
+// TempSpace::SpillCache::getLength
+//
+// Returns the stored length of the frame, must be called with the mutex locked
+//
+
+USHORT TempSpace::SpillCache::getLength(TempFile* file, offset_t number)
+{
+	for (FB_SIZE_T i = 0; i < files.getCount(); i++)
+	{
+		if (files[i]->file == file)
+		{
+			const Firebird::Array<USHORT>& lengths = files[i]->lengths;
+			return (number < lengths.getCount()) ? lengths[number] : 0;
+		}
+	}
+
+	return 0;
+}
+
+//
+// TempSpace::SpillCache::setLength
+//
+// Remembers the stored length of the frame
+//
+
+void TempSpace::SpillCache::setLength(TempFile* file, offset_t number, USHORT length)
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	FileFrames* fileFrames = NULL;
+
+	for (FB_SIZE_T i = 0; i < files.getCount(); i++)
+	{
+		if (files[i]->file == file)
+		{
+			fileFrames = files[i];
+			break;
+		}
+	}
+
+	if (!fileFrames)
+	{
+		fileFrames = FB_NEW_POOL(pool) FileFrames(pool);
+		fileFrames->file = file;
+		files.add(fileFrames);
+	}
+
+	Firebird::Array<USHORT>& lengths = fileFrames->lengths;
+
+	if (number >= lengths.getCount())
+		lengths.resize((FB_SIZE_T) number + 1, 0);
+
+	lengths[(FB_SIZE_T) number] = length;
+}
+
+//
+// TempSpace::SpillCache::storeFrame
+//
+// Compresses the frame if possible and writes it into its place in the file
+//
+
+void TempSpace::SpillCache::storeFrame(Frame* frame, Firebird::Array<UCHAR>& scratch)
+{
+	const UCHAR* data = frame->data;
+	FB_SIZE_T length = FRAME_SIZE;
+
+	if (compress)
+	{
+		const Jrd::LzCompressor packer(pool, FRAME_SIZE, frame->data, FRAME_SIZE);
+
+		if (packer.getPackedLength())
+		{
+			length = packer.getPackedLength();
+			UCHAR* const packed = scratch.getBuffer(length);
+			packer.pack(packed);
+			data = packed;
+		}
+	}
+
+	{	// scope
+		MutexLockGuard guard(fileMutex, FB_FUNCTION);
+		frame->file->write(frame->number * FRAME_SIZE, data, length);
+	}
+
+	setLength(frame->file, frame->number, (USHORT) length);
+}
+
+//
+// TempSpace::SpillCache::loadFrame
+//
+// Reads the frame from the file and decompresses it if needed
+//
+
+void TempSpace::SpillCache::loadFrame(Frame* frame, Firebird::Array<UCHAR>& scratch)
+{
+	USHORT length;
+
+	{	// scope
+		MutexLockGuard guard(mutex, FB_FUNCTION);
+		length = getLength(frame->file, frame->number);
+	}
+
+	if (!length)
+	{
+		// never stored, the file contains zeroes here
+		memset(frame->data, 0, FRAME_SIZE);
+		return;
+	}
+
+	UCHAR* const data = (length == FRAME_SIZE) ? frame->data : scratch.getBuffer(length);
+
+	{	// scope
+		MutexLockGuard guard(fileMutex, FB_FUNCTION);
+		frame->file->read(frame->number * FRAME_SIZE, data, length);
+	}
+
+	if (length < FRAME_SIZE)
+	{
+		if (Jrd::LzCompressor::getUnpackedLength(length, data) != FRAME_SIZE ||
+			Jrd::LzCompressor::unpack(length, data, FRAME_SIZE, frame->data) != frame->data + FRAME_SIZE)
+		{
+			Firebird::fatal_exception::raise("Corrupted frame of temporary file");
+		}
+	}
+}
+
+//
+// TempSpace::SpillCache::queue
+//
+// Passes the frame to the worker thread, must be called with the mutex locked
+//
+
+void TempSpace::SpillCache::queue(Frame* frame, FrameState state)
+{
+	frame->state = state;
+	jobs.add(frame);
+	wakeup.release();
+}
+
+//
+// TempSpace::SpillCache::checkError
+//
+// Raises the error happened while storing a frame in background
+//
+
+void TempSpace::SpillCache::checkError()
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	if (failed)
+		Firebird::status_exception::raise(error.value());
+}
+
+//
+// TempSpace::SpillCache::worker
+//
+// Stores and loads queued frames in background
+//
+
+THREAD_ENTRY_DECLARE TempSpace::SpillCache::workerThread(THREAD_ENTRY_PARAM arg)
+{
+	static_cast<SpillCache*>(arg)->worker();
+	return 0;
+}
+
+void TempSpace::SpillCache::worker()
+{
+	while (true)
+	{
+		wakeup.enter();
+
+		Frame* frame;
+		FrameState state;
+
+		{	// scope
+			MutexLockGuard guard(mutex, FB_FUNCTION);
+
+			if (stopping)
+				break;
+
+			if (jobs.isEmpty())
+				continue;
+
+			frame = jobs[0];
+			jobs.remove((FB_SIZE_T) 0);
+			state = frame->state;
+		}
+
+		bool success = true;
+
+		try
+		{
+			if (state == FRAME_STORING)
+				storeFrame(frame, workerScratch);
+			else
+				loadFrame(frame, workerScratch);
+		}
+		catch (const Firebird::Exception& ex)
+		{
+			success = false;
+
+			// failed read ahead is ignored, the owner is going to read the frame itself
+			if (state == FRAME_STORING)
+			{
+				MutexLockGuard guard(mutex, FB_FUNCTION);
+
+				if (!failed)
+				{
+					ex.stuffException(error);
+					failed = true;
+				}
+			}
+		}
+
+		{	// scope
+			MutexLockGuard guard(mutex, FB_FUNCTION);
+			frame->state = (success || state == FRAME_STORING) ? FRAME_CLEAN : FRAME_FREE;
+		}
+
+		done.release();
+	}
+}
+
 //
 // TempSpace::TempSpace
 //
@@ -101,9 +648,9 @@ FB_SIZE_T TempSpace::FileBlock::write(offset_t offset, const void* buffer, FB_SI
 TempSpace::TempSpace(MemoryPool& p, const Firebird::PathName& prefix, bool dynamic)
 		: pool(p), filePrefix(p, prefix),
 		  logicalSize(0), physicalSize(0), localCacheUsage(0),
-		  head(NULL), tail(NULL), tempFiles(p),
-		  initialBuffer(p), initiallyDynamic(dynamic),
-		  freeSegments(p)
+		  head(NULL), tail(NULL), tempFiles(p), spillCache(NULL),
+		  initialBuffer(p), initiallyDynamic(dynamic), memoryExposed(false),
+		  workMemory(Jrd::WorkMemory::getCurrent()), freeSegments(p)
 {
 	if (!tempDirs)
 	{
@@ -118,6 +665,9 @@ TempSpace::TempSpace(MemoryPool& p, const Firebird::PathName& prefix, bool dynam
 				minBlockSize = MIN_TEMP_BLOCK_SIZE;
 			else
 				minBlockSize = FB_ALIGN(minBlockSize, MIN_TEMP_BLOCK_SIZE);
+
+			spillCompression = Config::getTempCompression();
+			spillAsyncIO = Config::getTempAsyncIO();
 		}
 	}
 }
@@ -139,6 +689,12 @@ TempSpace::~TempSpace()
 
 	globalCacheUsage -= localCacheUsage;
 
+	if (workMemory)
+		workMemory->release(localCacheUsage);
+
+	// the cache may still write into the files
+	delete spillCache;
+
 	while (tempFiles.getCount())
 	{
 		delete tempFiles.pop();
@@ -275,7 +831,12 @@ void TempSpace::extend(FB_SIZE_T size)
 
 		Block* block = NULL;
 
-		if (globalCacheUsage + size <= size_t(Config::getTempCacheLimit()))
+		// give the memory back if the attachment holds more than granted
+		if (workMemory && workMemory->isOverdrawn())
+			spillMemory();
+
+		if (globalCacheUsage + size <= size_t(Config::getTempCacheLimit()) &&
+			(!workMemory || workMemory->acquire(size)))
 		{
 			try
 			{
@@ -287,6 +848,8 @@ void TempSpace::extend(FB_SIZE_T size)
 			catch (const Firebird::BadAlloc&)
 			{
 				// not enough memory
+				if (workMemory)
+					workMemory->release(size);
 			}
 		}
 
@@ -295,16 +858,23 @@ void TempSpace::extend(FB_SIZE_T size)
 		// logical/physical size already increased while allocation has in fact failed.
 		if (!block)
 		{
+			if (!spillCache && (spillCompression || spillAsyncIO))
+				spillCache = FB_NEW_POOL(pool) SpillCache(pool, spillCompression, spillAsyncIO);
+
 			// allocate block in the temp file
 			TempFile* const file = setupFile(size);
 			fb_assert(file);
-			if (tail && tail->sameFile(file))
+
+			if (workMemory)
+				workMemory->spilled(size);
+
+			if (tail && tail->endsAt(file, file->getSize() - size))
 			{
 				fb_assert(!initialSize);
 				tail->size += size;
 				return;
 			}
-			block = FB_NEW_POOL(pool) FileBlock(file, tail, size);
+			block = FB_NEW_POOL(pool) FileBlock(file, spillCache, tail, size);
 		}
 
 		// preserve the initial contents, if any
@@ -400,7 +970,13 @@ TempFile* TempSpace::setupFile(FB_SIZE_T size)
 				tempFiles.add(file);
 			}
 
-			file->extend(size);
+			if (spillCache)
+			{
+				MutexLockGuard guard(spillCache->getFileMutex(), FB_FUNCTION);
+				file->extend(size);
+			}
+			else
+				file->extend(size);
 		}
 		catch (const Firebird::system_error& ex)
 		{
@@ -420,6 +996,74 @@ TempFile* TempSpace::setupFile(FB_SIZE_T size)
 	return NULL; // compiler silencer
 }
 
+//
+// TempSpace::spillMemory
+//
+// Moves cached blocks into the temporary file until the attachment
+// fits its work memory grant again
+//
+
+void TempSpace::spillMemory()
+{
+	fb_assert(workMemory);
+
+	// the blocks can't be moved while the callers may point into them
+	if (memoryExposed || initialBuffer.getCount())
+		return;
+
+	for (Block* block = head; block && localCacheUsage; block = block->next)
+	{
+		if (!workMemory->isOverdrawn())
+			break;
+
+		const UCHAR* const memory = block->inMemory(0, block->size);
+
+		if (!memory)
+			continue;
+
+		const FB_SIZE_T size = static_cast<FB_SIZE_T>(block->size);
+		Block* fileBlock = NULL;
+
+		try
+		{
+			if (!spillCache && (spillCompression || spillAsyncIO))
+				spillCache = FB_NEW_POOL(pool) SpillCache(pool, spillCompression, spillAsyncIO);
+
+			TempFile* const file = setupFile(size);
+			fileBlock = FB_NEW_POOL(pool) FileBlock(file, spillCache, NULL, size);
+			fileBlock->write(0, memory, size);
+		}
+		catch (const Firebird::Exception&)
+		{
+			// no room on disk, keep the data in memory
+			delete fileBlock;
+			return;
+		}
+
+		// replace the memory block in the chain
+		fileBlock->prev = block->prev;
+		fileBlock->next = block->next;
+
+		if (block->prev)
+			block->prev->next = fileBlock;
+		else
+			head = fileBlock;
+
+		if (block->next)
+			block->next->prev = fileBlock;
+		else
+			tail = fileBlock;
+
+		delete block;
+		block = fileBlock;
+
+		localCacheUsage -= size;
+		globalCacheUsage -= size;
+		workMemory->release(size);
+		workMemory->spilled(size);
+	}
+}
+
 //
 // TempSpace::allocateSpace
 //
@@ -648,6 +1292,7 @@ ULONG TempSpace::allocateBatch(ULONG count, FB_SIZE_T minSize, FB_SIZE_T maxSize
 			seg.position = freeSeek;
 			seg.size = freeMem;
 			segments.add(seg);
+			memoryExposed = true;
 
 			freeSpace->position += freeMem;
 			freeSpace->size -= freeMem;
@@ -30,6 +30,15 @@
 #include "../common/config/dir_list.h"
 #include "../common/classes/init.h"
 #include "../common/classes/tree.h"
+#include "../common/classes/locks.h"
+#include "../common/classes/semaphore.h"
+#include "../common/ThreadStart.h"
+#include "../common/StatusHolder.h"
+
+namespace Jrd
+{
+	class WorkMemory;
+}
 
 class TempSpace : public Firebird::File
 {
@@ -54,6 +63,12 @@ public:
 
 	UCHAR* inMemory(offset_t offset, size_t size) const;
 
+	// the caller keeps pointers returned by inMemory(), the memory cannot be spilled anymore
+	void keepMemory()
+	{
+		memoryExposed = true;
+	}
+
 	struct SegmentInMemory
 	{
 		UCHAR* memory;
@@ -68,6 +83,94 @@ public:
 	bool validate(offset_t& freeSize) const;
 private:
 
+	// Cache of temporary file frames. It's used when spilled data is compressed
+	// or written behind and read ahead by the background thread. Every frame
+	// keeps its own place in the file, compression saves I/O but not space.
+	class SpillCache
+	{
+	public:
+		SpillCache(MemoryPool& pool, bool compress, bool async);
+		~SpillCache();
+
+		void read(Firebird::TempFile* file, offset_t offset, void* buffer, FB_SIZE_T length);
+		void write(Firebird::TempFile* file, offset_t offset, const void* buffer, FB_SIZE_T length);
+
+		Firebird::Mutex& getFileMutex()
+		{
+			return fileMutex;
+		}
+
+	private:
+		enum FrameState {FRAME_FREE, FRAME_CLEAN, FRAME_DIRTY, FRAME_STORING, FRAME_LOADING};
+
+		struct Frame
+		{
+			Firebird::TempFile* file;
+			offset_t number;
+			UCHAR* data;
+			FrameState state;
+			ULONG stamp;
+		};
+
+		// stored lengths of frames of a single file, zero means never stored
+		struct FileFrames
+		{
+			explicit FileFrames(MemoryPool& pool)
+				: file(NULL), lengths(pool)
+			{}
+
+			Firebird::TempFile* file;
+			Firebird::Array<USHORT> lengths;
+		};
+
+		// recent positions of sequential readers
+		struct Stream
+		{
+			Firebird::TempFile* file;
+			offset_t last;
+		};
+
+		static const unsigned MAX_STREAMS = 16;
+
+		Frame* getFrame(Firebird::TempFile* file, offset_t number, bool modify, bool load);
+		Frame* findFrame(Firebird::TempFile* file, offset_t number);
+		Frame* getVictim(bool wait);
+		void readAhead(Firebird::TempFile* file, offset_t first, offset_t last);
+
+		USHORT getLength(Firebird::TempFile* file, offset_t number);
+		void setLength(Firebird::TempFile* file, offset_t number, USHORT length);
+
+		void storeFrame(Frame* frame, Firebird::Array<UCHAR>& scratch);
+		void loadFrame(Frame* frame, Firebird::Array<UCHAR>& scratch);
+		void queue(Frame* frame, FrameState state);
+		void checkError();
+
+		static THREAD_ENTRY_DECLARE workerThread(THREAD_ENTRY_PARAM arg);
+		void worker();
+
+		MemoryPool& pool;
+		const bool compress;
+		bool async;
+		Firebird::Array<UCHAR> memory;
+		Firebird::Array<Frame> frames;
+		Firebird::Array<FileFrames*> files;
+		Firebird::Array<Frame*> jobs;
+		Firebird::Array<UCHAR> ownerScratch;
+		Firebird::Array<UCHAR> workerScratch;
+		Stream streams[MAX_STREAMS];
+		unsigned nextStream;
+		ULONG stamp;
+
+		Firebird::Mutex mutex;			// protects frame states, jobs and lengths
+		Firebird::Mutex fileMutex;		// serializes I/O of temporary files
+		Firebird::Semaphore wakeup;		// signals the worker about new jobs
+		Firebird::Semaphore done;		// signals the owner about finished jobs
+		Thread::Handle workerHandle;
+		bool stopping;
+		Firebird::DynamicStatusVector error;	// failure to store a frame, raised to the owner
+		bool failed;
+	};
+
 	// Generic space block
 	class Block
 	{
@@ -88,7 +191,7 @@ private:
 		virtual FB_SIZE_T write(offset_t offset, const void* buffer, FB_SIZE_T length) = 0;
 
 		virtual UCHAR* inMemory(offset_t offset, size_t size) const = 0;
-		virtual bool sameFile(const Firebird::TempFile* file) const = 0;
+		virtual bool endsAt(const Firebird::TempFile* file, offset_t position) const = 0;
 
 		Block *prev;
 		Block *next;
@@ -118,7 +221,7 @@ private:
 			return NULL;
 		}
 
-		bool sameFile(const Firebird::TempFile*) const
+		bool endsAt(const Firebird::TempFile*, offset_t) const
 		{
 			return false;
 		}
@@ -143,8 +246,8 @@ private:
 	class FileBlock : public Block
 	{
 	public:
-		FileBlock(Firebird::TempFile* f, Block* tail, size_t length)
-			: Block(tail, length), file(f)
+		FileBlock(Firebird::TempFile* f, SpillCache* c, Block* tail, size_t length)
+			: Block(tail, length), file(f), cache(c)
 		{
 			fb_assert(file);
 
@@ -163,18 +266,20 @@ private:
 			return NULL;
 		}
 
-		bool sameFile(const Firebird::TempFile* aFile) const
+		bool endsAt(const Firebird::TempFile* aFile, offset_t position) const
 		{
-			return (aFile == this->file);
+			return (aFile == this->file) && (seek + this->size == position);
 		}
 
 	private:
 		Firebird::TempFile* file;
+		SpillCache* cache;
 		offset_t seek;
 	};
 
 	Block* findBlock(offset_t& offset) const;
 	Firebird::TempFile* setupFile(FB_SIZE_T size);
+	void spillMemory();
 
 	UCHAR* findMemory(offset_t& begin, offset_t end, size_t size) const;
 
@@ -206,8 +311,11 @@ private:
 	Block* head;
 	Block* tail;
 	Firebird::Array<Firebird::TempFile*> tempFiles;
+	SpillCache* spillCache;
 	Firebird::Array<UCHAR> initialBuffer;
 	bool initiallyDynamic;
+	bool memoryExposed;
+	Jrd::WorkMemory* const workMemory;
 
 	typedef Firebird::BePlusTree<Segment, offset_t, MemoryPool, Segment> FreeSegmentTree;
 	FreeSegmentTree freeSegments;
@@ -216,6 +324,8 @@ private:
 	static Firebird::TempDirectoryList* tempDirs;
 	static FB_SIZE_T minBlockSize;
 	static offset_t globalCacheUsage;
+	static bool spillCompression;
+	static bool spillAsyncIO;
 };
 
 #endif // JRD_TEMP_SPACE_H
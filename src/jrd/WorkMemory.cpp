@@ -0,0 +1,196 @@
+/*
+ *	PROGRAM:		JRD Access Method
+ *	MODULE:			WorkMemory.cpp
+ *	DESCRIPTION:	Work memory broker
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "../common/config/config.h"
+#include "../jrd/jrd.h"
+#include "../jrd/Attachment.h"
+
+#include "../jrd/WorkMemory.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+// Part of the memory which is never lent above the fair shares, so that
+// the newly active attachments get some memory at once
+const FB_UINT64 RESERVE_RATIO = 8;
+
+
+WorkMemoryBroker::WorkMemoryBroker()
+	: m_limit(Config::getTempCacheLimit()),
+	  m_quota(Config::getTempCacheQuota()),
+	  m_reserve(m_limit / RESERVE_RATIO),
+	  m_used(0), m_active(0), m_pressure(false)
+{
+}
+
+bool WorkMemoryBroker::acquire(WorkMemory* account, FB_UINT64 size, bool force)
+{
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	if (!force)
+	{
+		const FB_UINT64 wanted = account->m_used + size;
+
+		if (m_quota && wanted > m_quota)
+			return false;
+
+		const FB_UINT64 share = getShare(account);
+
+		if (m_used + size > m_limit)
+		{
+			// The memory is exhausted. If the requester stays within its share,
+			// the attachments above their shares have to give memory back.
+
+			if (wanted <= share)
+				m_pressure = true;
+
+			return false;
+		}
+
+		// Memory above the share is lent only while nobody is short
+		// of memory and it doesn't touch the reserve
+
+		if (wanted > share && (m_pressure || m_used + size > m_limit - m_reserve))
+			return false;
+	}
+
+	if (!account->m_used && size)
+		m_active++;
+
+	account->m_used += size;
+	m_used += size;
+
+	return true;
+}
+
+void WorkMemoryBroker::release(WorkMemory* account, FB_UINT64 size)
+{
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	fb_assert(size <= account->m_used && account->m_used <= m_used);
+	size = MIN(size, account->m_used);
+
+	account->m_used -= size;
+	m_used -= size;
+
+	if (!account->m_used && size)
+	{
+		fb_assert(m_active);
+		m_active--;
+	}
+
+	checkPressure();
+}
+
+FB_UINT64 WorkMemoryBroker::getShare(const WorkMemory* account) const
+{
+	// Count the attachment itself if it holds nothing yet
+	const ULONG count = m_active + (account->m_used ? 0 : 1);
+	const FB_UINT64 share = (m_limit - m_reserve) / count;
+
+	return (m_quota && m_quota < share) ? m_quota : share;
+}
+
+FB_UINT64 WorkMemoryBroker::getGrant(const WorkMemory* account) const
+{
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	const FB_UINT64 share = getShare(account);
+
+	if (m_pressure)
+		return share;
+
+	// The attachment may also borrow the memory which is not used by others
+
+	const FB_UINT64 lendable = m_limit - m_reserve;
+	FB_UINT64 grant = account->m_used + (m_used < lendable ? lendable - m_used : 0);
+
+	if (grant < share)
+		grant = share;
+
+	return (m_quota && m_quota < grant) ? m_quota : grant;
+}
+
+void WorkMemoryBroker::checkPressure()
+{
+	// The pressure is gone as soon as the reserve is free again
+
+	if (m_pressure && m_used + m_reserve <= m_limit)
+		m_pressure = false;
+}
+
+
+WorkMemory::~WorkMemory()
+{
+	// Return whatever was not released by its users
+	if (m_used)
+		m_broker->release(this, m_used);
+}
+
+WorkMemory* WorkMemory::getCurrent()
+{
+	thread_db* const tdbb = JRD_get_thread_data();
+
+	if (tdbb && tdbb->getType() == ThreadData::tddDBB)
+	{
+		Jrd::Attachment* const attachment = tdbb->getAttachment();
+
+		if (attachment)
+			return &attachment->att_work_memory;
+	}
+
+	return NULL;
+}
+
+void WorkMemory::spilled(FB_UINT64 size)
+{
+	MutexLockGuard guard(m_broker->m_mutex, FB_FUNCTION);
+	m_spilled += size;
+}
+
+bool WorkMemory::isOverdrawn() const
+{
+	MutexLockGuard guard(m_broker->m_mutex, FB_FUNCTION);
+	return m_broker->m_pressure && m_used > m_broker->getShare(this);
+}
+
+FB_UINT64 WorkMemory::getUsed() const
+{
+	MutexLockGuard guard(m_broker->m_mutex, FB_FUNCTION);
+	return m_used;
+}
+
+FB_UINT64 WorkMemory::getGrant() const
+{
+	return m_broker->getGrant(this);
+}
+
+FB_UINT64 WorkMemory::getSpilled() const
+{
+	MutexLockGuard guard(m_broker->m_mutex, FB_FUNCTION);
+	return m_spilled;
+}
@@ -0,0 +1,119 @@
+/*
+ *	PROGRAM:		JRD Access Method
+ *	MODULE:			WorkMemory.h
+ *	DESCRIPTION:	Work memory broker
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef JRD_WORK_MEMORY_H
+#define JRD_WORK_MEMORY_H
+
+#include "firebird.h"
+#include "../common/classes/locks.h"
+
+namespace Jrd {
+
+class WorkMemory;
+
+// Database-wide broker of the work memory, i.e. sort buffers, hash tables and
+// cached temporary space. The memory is limited by TempCacheLimit and shared
+// fairly between the attachments using it at the moment. An attachment may
+// take more than its share while the memory is plentiful, but when another
+// attachment is refused memory within its own share, the ones above their
+// shares are asked to give memory back by spilling their data to disk.
+
+class WorkMemoryBroker
+{
+	friend class WorkMemory;
+
+public:
+	WorkMemoryBroker();
+
+private:
+	bool acquire(WorkMemory* account, FB_UINT64 size, bool force);
+	void release(WorkMemory* account, FB_UINT64 size);
+
+	FB_UINT64 getShare(const WorkMemory* account) const;
+	FB_UINT64 getGrant(const WorkMemory* account) const;
+	void checkPressure();
+
+	mutable Firebird::Mutex m_mutex;
+	const FB_UINT64 m_limit;		// memory shared by all attachments
+	const FB_UINT64 m_quota;		// memory available to an attachment, zero if not limited
+	const FB_UINT64 m_reserve;		// memory kept for the attachments below their shares
+	FB_UINT64 m_used;				// memory granted to all attachments
+	ULONG m_active;					// attachments holding some memory
+	bool m_pressure;				// an attachment was refused memory within its share
+};
+
+// Work memory of an attachment
+
+class WorkMemory
+{
+	friend class WorkMemoryBroker;
+
+public:
+	explicit WorkMemory(WorkMemoryBroker* broker)
+		: m_broker(broker), m_used(0), m_spilled(0)
+	{}
+
+	~WorkMemory();
+
+	// Work memory of the current attachment, if any
+	static WorkMemory* getCurrent();
+
+	// Request memory, it's refused if it exceeds the grant
+	bool acquire(FB_UINT64 size)
+	{
+		return m_broker->acquire(this, size, false);
+	}
+
+	// Account memory which can't be refused or spilled
+	void charge(FB_UINT64 size)
+	{
+		m_broker->acquire(this, size, true);
+	}
+
+	void release(FB_UINT64 size)
+	{
+		m_broker->release(this, size);
+	}
+
+	// Account data that went to disk instead of memory
+	void spilled(FB_UINT64 size);
+
+	// Whether the attachment holds more memory than it's granted now
+	bool isOverdrawn() const;
+
+	FB_UINT64 getUsed() const;
+	FB_UINT64 getGrant() const;
+	FB_UINT64 getSpilled() const;
+
+private:
+	WorkMemoryBroker* const m_broker;
+	FB_UINT64 m_used;
+	FB_UINT64 m_spilled;
+};
+
+} // namespace Jrd
+
+#endif // JRD_WORK_MEMORY_H
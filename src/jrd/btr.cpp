@@ -31,6 +31,8 @@
 #include "memory_routines.h"
 #include "../common/classes/vector.h"
 #include "../common/classes/VaryStr.h"
+#include "../common/classes/ClumpletWriter.h"
+#include "../common/utils_proto.h"
 #include <stdio.h>
 #include "../jrd/jrd.h"
 #include "../jrd/ods.h"
@@ -40,6 +42,7 @@
 #include "../jrd/req.h"
 #include "../jrd/tra.h"
 #include "../jrd/intl.h"
+#include "../jrd/Collation.h"
 #include "gen/iberror.h"
 #include "../jrd/lck.h"
 #include "../jrd/cch.h"
@@ -183,6 +186,158 @@ namespace
 		temporary_key jumpKey;
 	};
 
+	// Tags of the clumplets stored in RDB$INDICES.RDB$HISTOGRAM
+
+	const UCHAR dist_rows			= 1;
+	const UCHAR dist_distinct		= 2;
+	const UCHAR dist_selectivity	= 3;
+	const UCHAR dist_value			= 4;	// key of a common value...
+	const UCHAR dist_value_count	= 5;	// ... and its number of occurrences
+	const UCHAR dist_bound			= 6;	// key of a histogram bound...
+	const UCHAR dist_bound_count	= 7;	// ... and the number of keys preceding it
+
+	inline int compareKeys(const UCHAR* key1, USHORT length1, const UCHAR* key2, USHORT length2)
+	{
+		const int result = memcmp(key1, key2, MIN(length1, length2));
+		return result ? result : (int) length1 - (int) length2;
+	}
+
+	// Collects the most common values and the equi-depth histogram of the leading
+	// index segment while the leaf level is walked in key order. As the number of
+	// keys isn't known in advance, a bound is taken every "step" keys and half of the
+	// bounds are thrown away (doubling the step) each time the list gets full.
+
+	class DistributionCollector
+	{
+	public:
+		DistributionCollector(MemoryPool& pool, USHORT segments, bool descending)
+			: m_segments(segments),
+			  m_leader(descending ? 255 - segments : segments),
+			  m_current(pool),
+			  m_runLength(0),
+			  m_rows(0),
+			  m_distinct(0),
+			  m_step(1),
+			  m_common(pool),
+			  m_bounds(pool)
+		{
+		}
+
+		void add(const UCHAR* key, USHORT length)
+		{
+			length = getLeadingLength(key, length);
+
+			if (m_runLength && length == m_current.getCount() &&
+				!memcmp(key, m_current.begin(), length))
+			{
+				++m_runLength;
+			}
+			else
+			{
+				flush();
+				m_current.assign(key, length);
+				m_runLength = 1;
+				++m_distinct;
+			}
+
+			if (++m_rows % m_step)
+				return;
+
+			if (m_bounds.getCount() == 2 * IndexDistribution::MAX_BOUNDS)
+			{
+				for (FB_SIZE_T i = 0; i < IndexDistribution::MAX_BOUNDS; i++)
+					m_bounds.remove(i);
+
+				m_step *= 2;
+
+				if (m_rows % m_step)
+					return;
+			}
+
+			IndexDistribution::Entry& bound = m_bounds.add();
+			bound.key.assign(key, MIN(length, IndexDistribution::MAX_KEY_LENGTH));
+			bound.count = m_rows - 1;
+		}
+
+		void finish(IndexDistribution& distribution, float selectivity)
+		{
+			flush();
+
+			distribution.clear();
+			distribution.selectivity = selectivity;
+
+			if (!m_rows)
+				return;
+
+			distribution.rows = m_rows;
+			distribution.distinct = m_distinct;
+
+			// Keep only the values that are more common than the average one
+
+			for (FB_SIZE_T i = 0; i < m_common.getCount(); i++)
+			{
+				if (m_common[i].count * m_distinct > m_rows)
+					distribution.commonValues.add(m_common[i]);
+			}
+
+			for (FB_SIZE_T i = 0; i < m_bounds.getCount(); i++)
+				distribution.bounds.add(m_bounds[i]);
+		}
+
+	private:
+		// For compound indices, the leading segment is made of the chunks
+		// marked with its segment number
+		USHORT getLeadingLength(const UCHAR* key, USHORT length) const
+		{
+			if (m_segments == 1)
+				return length;
+
+			USHORT pos = 0;
+
+			while (pos < length && key[pos] == m_leader)
+				pos += STUFF_COUNT + 1;
+
+			return MIN(pos, length);
+		}
+
+		void flush()
+		{
+			if (m_runLength < 2 || m_current.getCount() > IndexDistribution::MAX_KEY_LENGTH)
+				return;
+
+			IndexDistribution::Entry* entry = NULL;
+
+			if (m_common.getCount() < IndexDistribution::MAX_COMMON_VALUES)
+				entry = &m_common.add();
+			else
+			{
+				// Replace the least common value, if it's less common than the current one
+
+				for (FB_SIZE_T i = 0; i < m_common.getCount(); i++)
+				{
+					if (m_common[i].count < m_runLength && (!entry || m_common[i].count < entry->count))
+						entry = &m_common[i];
+				}
+
+				if (!entry)
+					return;
+			}
+
+			entry->key.assign(m_current);
+			entry->count = m_runLength;
+		}
+
+		const USHORT m_segments;
+		const UCHAR m_leader;
+		Array<UCHAR> m_current;
+		FB_UINT64 m_runLength;
+		FB_UINT64 m_rows;
+		FB_UINT64 m_distinct;
+		FB_UINT64 m_step;
+		ObjectsArray<IndexDistribution::Entry> m_common;
+		ObjectsArray<IndexDistribution::Entry> m_bounds;
+	};
+
 } // namespace
 
 static ULONG add_node(thread_db*, WIN*, index_insertion*, temporary_key*, RecordNumber*,
@@ -193,6 +348,7 @@ static void copy_key(const temporary_key*, temporary_key*);
 static contents delete_node(thread_db*, WIN*, UCHAR*);
 static void delete_tree(thread_db*, USHORT, USHORT, PageNumber, PageNumber);
 static DSC* eval(thread_db*, const ValueExprNode*, DSC*, bool*);
+static void evaluate_trigrams(thread_db*, const IndexRetrieval*, RecordBitmap**, RecordBitmap*);
 static ULONG fast_load(thread_db*, IndexCreation&, SelectivityList&);
 
 static index_root_page* fetch_root(thread_db*, WIN*, const jrd_rel*, const RelationPages*);
@@ -216,6 +372,8 @@ static INT64_KEY make_int64_key(SINT64, SSHORT);
 #ifdef DEBUG_INDEXKEY
 static void print_int64_key(SINT64, SSHORT, INT64_KEY);
 #endif
+static bool make_leading_key(thread_db*, const index_desc*, const dsc*, temporary_key*);
+static void make_trigrams(thread_db*, USHORT, const UCHAR*, ULONG, bool, TrigramList&);
 static string print_key(thread_db*, jrd_rel*, index_desc*, Record*);
 static contents remove_node(thread_db*, index_insertion*, WIN*);
 static contents remove_leaf_node(thread_db*, index_insertion*, WIN*);
@@ -682,6 +840,12 @@ void BTR_evaluate(thread_db* tdbb, const IndexRetrieval* retrieval, RecordBitmap
  **************************************/
 	SET_TDBB(tdbb);
 
+	if (retrieval->irb_generic & irb_trigram)
+	{
+		evaluate_trigrams(tdbb, retrieval, bitmap, bitmap_and);
+		return;
+	}
+
 	// Remove ignore_nulls flag for older ODS
 	//const Database* dbb = tdbb->getDatabase();
 
@@ -1359,6 +1523,10 @@ USHORT BTR_key_length(thread_db* tdbb, jrd_rel* relation, index_desc* idx)
  **************************************/
 	SET_TDBB(tdbb);
 
+	// Trigram index keeps small fixed size keys regardless of the field length
+	if (idx->idx_flags & idx_trigram)
+		return TrigramKey::MAX_LENGTH;
+
 	// hvlad: in ODS11 key of descending index can be prefixed with
 	//		  one byte value. See comments in compress
 	const SLONG prefix = (idx->idx_flags & idx_descending) ? 1 : 0;
@@ -1472,6 +1640,56 @@ USHORT BTR_key_length(thread_db* tdbb, jrd_rel* relation, index_desc* idx)
 }
 
 
+idx_e BTR_trigrams(thread_db* tdbb, jrd_rel* relation, Record* record, index_desc* idx,
+				   TrigramList& trigrams)
+{
+/**************************************
+ *
+ *	B T R _ t r i g r a m s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Compute the list of distinct keys stored for a record
+ *	in a trigram index. NULL value produces no keys at all,
+ *	any other value produces the marker key and its trigrams.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	trigrams.clear();
+
+	dsc desc;
+	if (!EVL_field(relation, record, idx->idx_rpt[0].idx_field, &desc))
+		return idx_e_ok;
+
+	TrigramKey marker;
+	marker.length = 1;
+	marker.data[0] = TrigramKey::MARKER;
+	trigrams.add(marker);
+
+	try
+	{
+		const USHORT ttype = INTL_TEXT_TYPE(desc);
+
+		MoveBuffer buffer;
+		UCHAR* address;
+		const ULONG length = MOV_make_string2(tdbb, &desc, ttype, &address, buffer);
+
+		make_trigrams(tdbb, ttype, address, length, false, trigrams);
+	}
+	catch (const Exception& ex)
+	{
+		ex.stuffException(tdbb->tdbb_status_vector);
+		trigrams.clear();
+
+		return (tdbb->tdbb_flags & TDBB_sys_error) ? idx_e_interrupt : idx_e_conversion;
+	}
+
+	return idx_e_ok;
+}
+
+
 bool BTR_lookup(thread_db* tdbb, jrd_rel* relation, USHORT id, index_desc* buffer,
 				  RelationPages* relPages)
 {
@@ -2014,7 +2232,8 @@ void BTR_reserve_slot(thread_db* tdbb, IndexCreation& creation)
 }
 
 
-void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity)
+void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity,
+					 IndexDistribution* distribution)
 {
 /**************************************
  *
@@ -2028,6 +2247,8 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
  *	without visiting data pages. Thus the
  *	effects of uncommitted transactions
  *	will be included in the calculation.
+ *	If requested, the distribution of the
+ *	leading segment values is gathered too.
  *
  **************************************/
 
@@ -2076,6 +2297,13 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 	duplicatesList.grow(segments);
 	memset(duplicatesList.begin(), 0, segments * sizeof(FB_UINT64));
 
+	AutoPtr<DistributionCollector> collector;
+	if (distribution)
+	{
+		MemoryPool& pool = *tdbb->getDefaultPool();
+		collector = FB_NEW_POOL(pool) DistributionCollector(pool, segments, descending);
+	}
+
 	//const Database* dbb = tdbb->getDatabase();
 
 	// go through all the leaf nodes and count them;
@@ -2189,6 +2417,10 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 			// keep the key value current for comparison with the next key
 			key.key_length = l;
 			memcpy(key.key_data + node.prefix, node.data, node.length);
+
+			if (collector)
+				collector->add(key.key_data, key.key_length);
+
 			pointer = node.readNode(pointer, true);
 		}
 
@@ -2218,6 +2450,226 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 	CCH_MARK(tdbb, &window);
 	update_selectivity(root, id, selectivity);
 	CCH_RELEASE(tdbb, &window);
+
+	if (collector)
+		collector->finish(*distribution, selectivity[0]);
+}
+
+
+void IndexDistribution::parse(const UCHAR* data, ULONG length)
+{
+/**************************************
+ *
+ *	p a r s e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Load the distribution from the contents
+ *	of RDB$INDICES.RDB$HISTOGRAM.
+ *
+ **************************************/
+	clear();
+
+	ClumpletReader reader(ClumpletReader::WideUnTagged, data, length);
+
+	for (reader.rewind(); !reader.isEof(); reader.moveNext())
+	{
+		switch (reader.getClumpTag())
+		{
+			case dist_rows:
+				rows = reader.getBigInt();
+				break;
+
+			case dist_distinct:
+				distinct = reader.getBigInt();
+				break;
+
+			case dist_selectivity:
+				if (reader.getClumpLength() == sizeof(selectivity))
+					memcpy(&selectivity, reader.getBytes(), sizeof(selectivity));
+				break;
+
+			case dist_value:
+				commonValues.add().key.assign(reader.getBytes(), reader.getClumpLength());
+				break;
+
+			case dist_bound:
+				bounds.add().key.assign(reader.getBytes(), reader.getClumpLength());
+				break;
+
+			case dist_value_count:
+				if (commonValues.hasData())
+					commonValues.back()->count = reader.getBigInt();
+				break;
+
+			case dist_bound_count:
+				if (bounds.hasData())
+					bounds.back()->count = reader.getBigInt();
+				break;
+		}
+	}
+}
+
+
+void IndexDistribution::generate(UCharBuffer& buffer) const
+{
+/**************************************
+ *
+ *	g e n e r a t e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Make the contents of RDB$INDICES.RDB$HISTOGRAM.
+ *
+ **************************************/
+	ClumpletWriter writer(ClumpletReader::WideUnTagged, MAX_ULONG);
+
+	writer.insertBigInt(dist_rows, rows);
+	writer.insertBigInt(dist_distinct, distinct);
+	writer.insertBytes(dist_selectivity, &selectivity, sizeof(selectivity));
+
+	for (FB_SIZE_T i = 0; i < commonValues.getCount(); i++)
+	{
+		writer.insertBytes(dist_value, commonValues[i].key.begin(), commonValues[i].key.getCount());
+		writer.insertBigInt(dist_value_count, commonValues[i].count);
+	}
+
+	for (FB_SIZE_T i = 0; i < bounds.getCount(); i++)
+	{
+		writer.insertBytes(dist_bound, bounds[i].key.begin(), bounds[i].key.getCount());
+		writer.insertBigInt(dist_bound_count, bounds[i].count);
+	}
+
+	buffer.assign(writer.getBuffer(), writer.getBufferLength());
+}
+
+
+bool IndexDistribution::estimateEquality(thread_db* tdbb, const index_desc* idx, const dsc* value,
+	double& fraction) const
+{
+/**************************************
+ *
+ *	e s t i m a t e E q u a l i t y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Estimate the fraction of the index keys having
+ *	the leading segment equal to the given value.
+ *
+ **************************************/
+	temporary_key key;
+
+	if (isEmpty() || !make_leading_key(tdbb, idx, value, &key))
+		return false;
+
+	FB_UINT64 commonRows = 0;
+
+	for (FB_SIZE_T i = 0; i < commonValues.getCount(); i++)
+	{
+		const Entry& entry = commonValues[i];
+
+		if (!compareKeys(entry.key.begin(), entry.key.getCount(), key.key_data, key.key_length))
+		{
+			fraction = (double) entry.count / rows;
+			return true;
+		}
+
+		commonRows += entry.count;
+	}
+
+	// Not a common value, so assume it shares the remaining keys
+	// evenly with the other values that are not common
+
+	const FB_UINT64 commonCount = commonValues.getCount();
+	const FB_UINT64 others = (distinct > commonCount) ? distinct - commonCount : 1;
+
+	fraction = (double) (rows - MIN(commonRows, rows)) / rows / others;
+	return true;
+}
+
+
+bool IndexDistribution::estimateRange(thread_db* tdbb, const index_desc* idx,
+	const dsc* lower, const dsc* upper, double& fraction) const
+{
+/**************************************
+ *
+ *	e s t i m a t e R a n g e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Estimate the fraction of the index keys having
+ *	the leading segment between the given values.
+ *	Missing value means the range is not bounded.
+ *
+ **************************************/
+	if (isEmpty() || bounds.isEmpty())
+		return false;
+
+	// Keys of the descending indices go in the reverse order
+
+	const bool descending = (idx->idx_flags & idx_descending);
+	double lowerPosition = descending ? 1 : 0;
+	double upperPosition = descending ? 0 : 1;
+
+	temporary_key key;
+
+	if (lower)
+	{
+		if (!make_leading_key(tdbb, idx, lower, &key))
+			return false;
+
+		lowerPosition = getPosition(key);
+	}
+
+	if (upper)
+	{
+		if (!make_leading_key(tdbb, idx, upper, &key))
+			return false;
+
+		upperPosition = getPosition(key);
+	}
+
+	fraction = MAX(fabs(upperPosition - lowerPosition), 1.0 / rows);
+	return true;
+}
+
+
+double IndexDistribution::getPosition(const temporary_key& key) const
+{
+/**************************************
+ *
+ *	g e t P o s i t i o n
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return the estimated fraction of the
+ *	index keys preceding the given one.
+ *
+ **************************************/
+	FB_SIZE_T lo = 0, hi = bounds.getCount();
+
+	while (lo < hi)
+	{
+		const FB_SIZE_T mid = (lo + hi) / 2;
+		const Entry& bound = bounds[mid];
+
+		if (compareKeys(bound.key.begin(), bound.key.getCount(), key.key_data, key.key_length) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	// The key is somewhere between the two neighbour bounds
+
+	const FB_UINT64 before = lo ? bounds[lo - 1].count : 0;
+	const FB_UINT64 after = (lo < bounds.getCount()) ? bounds[lo].count : rows;
+
+	return (before + after) / 2.0 / rows;
 }
 
 
@@ -3256,6 +3708,78 @@ static DSC* eval(thread_db* tdbb, const ValueExprNode* node, DSC* temp, bool* is
 }
 
 
+static void evaluate_trigrams(thread_db* tdbb, const IndexRetrieval* retrieval,
+							  RecordBitmap** bitmap, RecordBitmap* bitmap_and)
+{
+/**************************************
+ *
+ *	e v a l u a t e _ t r i g r a m s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Look up the trigrams of a CONTAINING or LIKE pattern
+ *	and return the records having all of them. Such records
+ *	are candidates only, the boolean is re-checked later.
+ *
+ **************************************/
+	jrd_rel* const relation = retrieval->irb_relation;
+	const index_desc* const idx = &retrieval->irb_desc;
+
+	DSC temp;
+	bool isNull;
+	const DSC* const desc = eval(tdbb, retrieval->irb_value[0], &temp, &isNull);
+
+	if (isNull)
+		return;
+
+	const Format* const format = MET_current(tdbb, relation);
+	const USHORT ttype = INTL_TEXT_TYPE(format->fmt_desc[idx->idx_rpt[0].idx_field]);
+
+	MoveBuffer buffer;
+	UCHAR* address;
+	const ULONG length = MOV_make_string2(tdbb, desc, ttype, &address, buffer);
+
+	TrigramList trigrams;
+	make_trigrams(tdbb, ttype, address, length, (retrieval->irb_generic & irb_trigram_like), trigrams);
+
+	// Pattern without trigrams matches any not NULL value
+	if (trigrams.isEmpty())
+	{
+		TrigramKey marker;
+		marker.length = 1;
+		marker.data[0] = TrigramKey::MARKER;
+		trigrams.add(marker);
+	}
+
+	// Every lookup is filtered by the result of the previous one,
+	// the last one adds its records into the caller's bitmap.
+	RecordBitmap* candidates = bitmap_and;
+
+	for (FB_SIZE_T i = 0; i < trigrams.getCount(); i++)
+	{
+		const bool last = (i == trigrams.getCount() - 1);
+
+		temporary_key key;
+		trigrams[i].makeKey(&key);
+
+		IndexRetrieval lookup(relation, idx, 1, &key);
+		lookup.irb_generic = irb_equality;
+
+		RecordBitmap* found = NULL;
+		BTR_evaluate(tdbb, &lookup, last ? bitmap : &found, candidates);
+
+		if (candidates != bitmap_and)
+			delete candidates;
+
+		candidates = found;
+
+		if (!last && !candidates)
+			break;
+	}
+}
+
+
 static ULONG fast_load(thread_db* tdbb,
 					   IndexCreation& creation,
 					   SelectivityList& selectivity)
@@ -5901,6 +6425,132 @@ static INT64_KEY make_int64_key(SINT64 q, SSHORT scale)
 }
 
 
+static bool make_leading_key(thread_db* tdbb, const index_desc* idx, const dsc* desc,
+							 temporary_key* key)
+{
+/**************************************
+ *
+ *	m a k e _ l e a d i n g _ k e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Make the key of the leading index segment
+ *	like BTR_make_key does for an equality
+ *	lookup, but from a known value. Return
+ *	false if the value cannot be converted.
+ *
+ **************************************/
+	const bool descending = (idx->idx_flags & idx_descending);
+	const USHORT keyType = (idx->idx_flags & idx_unique) ? INTL_KEY_UNIQUE : INTL_KEY_SORT;
+
+	key->key_flags = 0;
+	key->key_nulls = 0;
+	key->key_length = 0;
+
+	try
+	{
+		if (idx->idx_count == 1)
+			compress(tdbb, desc, key, idx->idx_rpt[0].idx_itype, false, descending, keyType);
+		else
+		{
+			temporary_key temp;
+			temp.key_flags = 0;
+			temp.key_length = 0;
+
+			compress(tdbb, desc, &temp, idx->idx_rpt[0].idx_itype, false, descending, keyType);
+
+			if ((ULONG) ((temp.key_length + STUFF_COUNT - 1) / STUFF_COUNT * (STUFF_COUNT + 1)) > MAX_KEY)
+				return false;
+
+			UCHAR* p = key->key_data;
+
+			for (USHORT pos = 0; pos < temp.key_length; pos += STUFF_COUNT)
+			{
+				const USHORT length = MIN(temp.key_length - pos, STUFF_COUNT);
+
+				*p++ = idx->idx_count;
+				memcpy(p, temp.key_data + pos, length);
+				memset(p + length, 0, STUFF_COUNT - length);
+				p += STUFF_COUNT;
+			}
+
+			key->key_length = p - key->key_data;
+		}
+	}
+	catch (const Exception&)
+	{
+		fb_utils::init_status(tdbb->tdbb_status_vector);
+		return false;
+	}
+
+	if (descending)
+		BTR_complement_key(key);
+
+	return true;
+}
+
+
+static void make_trigrams(thread_db* tdbb, USHORT ttype, const UCHAR* str, ULONG length,
+						  bool like, TrigramList& trigrams)
+{
+/**************************************
+ *
+ *	m a k e _ t r i g r a m s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Add the distinct trigrams of the upper cased canonical
+ *	string to the list. Wildcards of a LIKE pattern split it
+ *	into parts and trigrams never cross their boundaries.
+ *
+ **************************************/
+	TextType* const textType = INTL_texttype_lookup(tdbb, ttype);
+	const BYTE width = textType->getCanonicalWidth();
+
+	if (!width || width > sizeof(ULONG))
+		return;
+
+	HalfStaticArray<UCHAR, BUFFER_MEDIUM> upper;
+	length = textType->str_to_upper(length, str, length, upper.getBuffer(length));
+
+	HalfStaticArray<UCHAR, BUFFER_MEDIUM> canonical;
+	const ULONG canonicalLength = length / textType->getCharSet()->minBytesPerChar() * width;
+	const ULONG count = textType->canonical(length, upper.begin(), canonicalLength,
+		canonical.getBuffer(canonicalLength));
+
+	const UCHAR* const matchAny = textType->getCanonicalChar(TextType::CHAR_SQL_MATCH_ANY);
+	const UCHAR* const matchOne = textType->getCanonicalChar(TextType::CHAR_SQL_MATCH_ONE);
+
+	const UCHAR* const chars = canonical.begin();
+	ULONG run = 0;
+
+	for (ULONG i = 0; i < count; i++)
+	{
+		const UCHAR* const p = chars + i * width;
+
+		if (like && (!memcmp(p, matchAny, width) || !memcmp(p, matchOne, width)))
+		{
+			run = 0;
+			continue;
+		}
+
+		if (++run < 3)
+			continue;
+
+		TrigramKey trigram;
+		trigram.length = 1 + 3 * width;
+		trigram.data[0] = TrigramKey::TRIGRAM;
+		memcpy(trigram.data + 1, p - 2 * width, 3 * width);
+
+		FB_SIZE_T pos;
+		if (!trigrams.find(trigram, pos))
+			trigrams.insert(pos, trigram);
+	}
+}
+
+
 #ifdef DEBUG_INDEXKEY
 static void print_int64_key(SINT64 value, SSHORT scale, INT64_KEY key)
 {
@@ -29,6 +29,7 @@
 
 #include "../jrd/constants.h"
 #include "../common/classes/array.h"
+#include "../common/classes/objects_array.h"
 #include "../include/fb_blk.h"
 
 #include "../jrd/err_proto.h"    // Index error types
@@ -44,10 +45,12 @@ class jrd_rel;
 class jrd_tra;
 template <typename T> class vec;
 class JrdStatement;
+class jrd_req;
 struct temporary_key;
 class jrd_tra;
 class BtrPageGCLock;
 class Sort;
+class thread_db;
 
 // Index descriptor block -- used to hold info from index root page
 
@@ -114,6 +117,7 @@ const int idx_in_progress	= 4;
 const int idx_foreign		= 8;
 const int idx_primary		= 16;
 const int idx_expressn		= 32;
+const int idx_trigram		= 64;
 
 // these flags are for idx_runtime_flags
 
@@ -155,6 +159,37 @@ struct temporary_key
 };
 
 
+// Trigram index key -- three consecutive characters of the upper cased and
+// canonical value. Every not NULL value also stores the marker key, so the
+// index can find all candidates when the searched pattern has no trigrams.
+
+struct TrigramKey
+{
+	static const UCHAR MARKER = 0;
+	static const UCHAR TRIGRAM = 1;
+	static const unsigned MAX_LENGTH = 1 + 3 * sizeof(ULONG);
+
+	UCHAR length;
+	UCHAR data[MAX_LENGTH];
+
+	bool operator>(const TrigramKey& other) const
+	{
+		const int result = memcmp(data, other.data, MIN(length, other.length));
+		return result ? result > 0 : length > other.length;
+	}
+
+	void makeKey(temporary_key* key) const
+	{
+		memcpy(key->key_data, data, length);
+		key->key_length = length;
+		key->key_flags = 0;
+		key->key_nulls = 0;
+	}
+};
+
+typedef Firebird::SortedArray<TrigramKey, Firebird::InlineStorage<TrigramKey, 64> > TrigramList;
+
+
 // Index Sort Record -- fix part of sort record for index fast load
 
 // hvlad: index_sort_record structure is stored in sort scratch file so we
@@ -225,9 +260,73 @@ const int irb_ignore_null_value_key  = 8;	// if lower bound is specified and upp
 const int irb_descending	= 16;			// Base index uses descending order
 const int irb_exclude_lower	= 32;			// exclude lower bound keys while scanning index
 const int irb_exclude_upper	= 64;			// exclude upper bound keys while scanning index
+const int irb_trigram		= 128;			// CONTAINING pattern looked up in a trigram index
+const int irb_trigram_like	= 256;			// LIKE pattern looked up in a trigram index
 
 typedef Firebird::HalfStaticArray<float, 4> SelectivityList;
 
+// Distribution of the leading segment values of an index. It's gathered
+// together with the selectivity and stored in RDB$INDICES.RDB$HISTOGRAM, so
+// the optimizer may estimate skewed data better than the selectivity allows.
+
+class IndexDistribution
+{
+public:
+	static const unsigned MAX_COMMON_VALUES = 32;	// most common values kept
+	static const unsigned MAX_BOUNDS = 64;			// equi-depth histogram buckets
+	static const unsigned MAX_KEY_LENGTH = 255;		// longer keys are truncated or skipped
+
+	struct Entry
+	{
+		explicit Entry(MemoryPool& p)
+			: key(p), count(0)
+		{}
+
+		Entry(MemoryPool& p, const Entry& other)
+			: key(p), count(other.count)
+		{
+			key.assign(other.key);
+		}
+
+		Firebird::Array<UCHAR> key;		// leading segment key
+		FB_UINT64 count;				// occurrences of a common value or keys preceding a bound
+	};
+
+	explicit IndexDistribution(MemoryPool& p)
+		: commonValues(p), bounds(p), rows(0), distinct(0), selectivity(0)
+	{}
+
+	bool isEmpty() const
+	{
+		return !rows;
+	}
+
+	void clear()
+	{
+		commonValues.clear();
+		bounds.clear();
+		rows = distinct = 0;
+	}
+
+	void parse(const UCHAR* data, ULONG length);
+	void generate(Firebird::UCharBuffer& buffer) const;
+
+	// Estimated fractions of the index keys matching the leading segment value(s)
+	bool estimateEquality(thread_db* tdbb, const index_desc* idx, const dsc* value,
+		double& fraction) const;
+	bool estimateRange(thread_db* tdbb, const index_desc* idx, const dsc* lower, const dsc* upper,
+		double& fraction) const;
+
+	Firebird::ObjectsArray<Entry> commonValues;	// most common values
+	Firebird::ObjectsArray<Entry> bounds;		// equi-depth histogram bounds, in key order
+	FB_UINT64 rows;								// keys in the index
+	FB_UINT64 distinct;							// distinct leading segment values
+	float selectivity;							// leading segment selectivity stored in the root page
+
+private:
+	double getPosition(const temporary_key& key) const;
+};
+
 class BtrPageGCLock : public Lock
 {
 	// This class assumes that the static part of the lock key (Lock::lck_key)
@@ -254,6 +353,44 @@ struct IndexCreation
 	Firebird::AutoPtr<Sort> sort;
 };
 
+// Keys of records stored by a batch INSERT. Keys of indices that don't check
+// anything (not unique, not foreign) are collected into a sort per index and
+// put into the b-trees in key order when the batch is done.
+
+class DeferredIndexKeys
+{
+public:
+	DeferredIndexKeys(MemoryPool& pool, jrd_tra* transaction);
+	~DeferredIndexKeys();
+
+	bool accept(const jrd_req* request, jrd_rel* relation);
+	bool put(thread_db* tdbb, index_desc* idx, const temporary_key& key, RecordNumber number);
+
+	void confirm(thread_db* tdbb);	// keys of the last record go to the sorts
+	void discard();					// last record is undone, forget its keys
+	void flush(thread_db* tdbb);
+
+	static bool isDeferred(const index_desc* idx)
+	{
+		return !(idx->idx_flags & (idx_unique | idx_primary | idx_foreign | idx_trigram));
+	}
+
+private:
+	struct Index
+	{
+		USHORT id;
+		USHORT keyLength;
+		Sort* sort;
+	};
+
+	Index* getIndex(thread_db* tdbb, index_desc* idx);
+
+	jrd_tra* const m_transaction;
+	jrd_rel* m_relation;
+	Firebird::HalfStaticArray<Index, 8> m_indices;
+	Firebird::HalfStaticArray<UCHAR, 1024> m_pending;	// keys of the last record
+};
+
 // Class used to report any index related errors
 
 class IndexErrorContext
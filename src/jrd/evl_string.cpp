@@ -0,0 +1,152 @@
+/*
+ *	PROGRAM:		JRD Access Method
+ *	MODULE:			evl_string.cpp
+ *	DESCRIPTION:	Substring search for streamed string functions
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ */
+
+#include "firebird.h"
+#include <string.h>
+#include "gen/iberror.h"
+#include "../common/StatusArg.h"
+#include "../jrd/evl_string.h"
+#include "../common/classes/CpuFeatures.h"
+
+using namespace Firebird;
+
+namespace
+{
+	typedef SLONG (*search_func_t)(const UCHAR* data, SLONG data_len,
+		const UCHAR* pattern, SLONG pattern_len);
+
+	SLONG searchBasic(const UCHAR* data, SLONG data_len, const UCHAR* pattern, SLONG pattern_len)
+	{
+		const UCHAR* p = data;
+		const UCHAR* const last = data + data_len - pattern_len;
+
+		while (p <= last)
+		{
+			p = static_cast<const UCHAR*>(memchr(p, pattern[0], last - p + 1));
+
+			if (!p)
+				break;
+
+			if (memcmp(p + 1, pattern + 1, pattern_len - 1) == 0)
+				return p - data;
+
+			p++;
+		}
+
+		return -1;
+	}
+
+#ifdef FB_CPU_SSE2
+
+	// Every position where both the first and the last pattern bytes
+	// match is verified with memcmp
+
+	SLONG searchSSE2(const UCHAR* data, SLONG data_len, const UCHAR* pattern, SLONG pattern_len)
+	{
+		const SLONG last = pattern_len - 1;
+		const __m128i first_c = _mm_set1_epi8((char) pattern[0]);
+		const __m128i last_c = _mm_set1_epi8((char) pattern[last]);
+
+		SLONG pos = 0;
+
+		for (; pos + last + 16 <= data_len; pos += 16)
+		{
+			const __m128i first_b = _mm_loadu_si128((const __m128i*) (data + pos));
+			const __m128i last_b = _mm_loadu_si128((const __m128i*) (data + pos + last));
+			unsigned mask = _mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(first_c, first_b), _mm_cmpeq_epi8(last_c, last_b)));
+
+			while (mask)
+			{
+				const SLONG found = pos + lowestBit(mask);
+
+				if (last < 2 || memcmp(data + found + 1, pattern + 1, last - 1) == 0)
+					return found;
+
+				mask &= mask - 1;
+			}
+		}
+
+		const SLONG found = searchBasic(data + pos, data_len - pos, pattern, pattern_len);
+		return (found < 0) ? -1 : pos + found;
+	}
+
+	FB_TARGET_AVX2 SLONG searchAVX2(const UCHAR* data, SLONG data_len,
+		const UCHAR* pattern, SLONG pattern_len)
+	{
+		const SLONG last = pattern_len - 1;
+		const __m256i first_c = _mm256_set1_epi8((char) pattern[0]);
+		const __m256i last_c = _mm256_set1_epi8((char) pattern[last]);
+
+		SLONG pos = 0;
+
+		for (; pos + last + 32 <= data_len; pos += 32)
+		{
+			const __m256i first_b = _mm256_loadu_si256((const __m256i*) (data + pos));
+			const __m256i last_b = _mm256_loadu_si256((const __m256i*) (data + pos + last));
+			unsigned mask = (unsigned) _mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(first_c, first_b), _mm256_cmpeq_epi8(last_c, last_b)));
+
+			while (mask)
+			{
+				const SLONG found = pos + lowestBit(mask);
+
+				if (last < 2 || memcmp(data + found + 1, pattern + 1, last - 1) == 0)
+					return found;
+
+				mask &= mask - 1;
+			}
+		}
+
+		const SLONG found = searchSSE2(data + pos, data_len - pos, pattern, pattern_len);
+		return (found < 0) ? -1 : pos + found;
+	}
+
+	search_func_t searchFunc = cpuSupportsAVX2() ? searchAVX2 : searchSSE2;
+
+#else	// FB_CPU_SSE2
+
+	search_func_t searchFunc = searchBasic;
+
+#endif	// FB_CPU_SSE2
+} // namespace
+
+
+namespace Firebird {
+
+SLONG searchBytes(const UCHAR* data, SLONG data_len, const UCHAR* pattern, SLONG pattern_len)
+{
+	if (pattern_len <= 0)
+		return 0;
+
+	if (data_len < pattern_len)
+		return -1;
+
+	return searchFunc(data, data_len, pattern, pattern_len);
+}
+
+} // namespace Firebird
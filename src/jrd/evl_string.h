@@ -45,8 +45,72 @@ const int STATIC_PATTERN_BUFFER		= 16;
 const int STATIC_PATTERN_BUFFER		= 256;
 #endif
 
+// Patterns that long are searched with Boyer-Moore-Horspool algorithm
+const SLONG BMH_MIN_PATTERN		= 32;
+
 namespace Firebird {
 
+// Position of the first occurrence of pattern in data or -1 if not found.
+// Candidates are found comparing first and last pattern bytes using
+// vector instructions when available.
+SLONG searchBytes(const UCHAR* data, SLONG data_len, const UCHAR* pattern, SLONG pattern_len);
+
+template <typename CharType>
+inline SLONG searchPattern(const CharType* data, SLONG data_len,
+	const CharType* pattern, SLONG pattern_len)
+{
+	const CharType first = pattern[0];
+
+	for (SLONG pos = 0; pos <= data_len - pattern_len; pos++)
+	{
+		if (data[pos] == first &&
+			memcmp(data + pos + 1, pattern + 1, (pattern_len - 1) * sizeof(CharType)) == 0)
+		{
+			return pos;
+		}
+	}
+
+	return -1;
+}
+
+template <>
+inline SLONG searchPattern<UCHAR>(const UCHAR* data, SLONG data_len,
+	const UCHAR* pattern, SLONG pattern_len)
+{
+	return searchBytes(data, data_len, pattern, pattern_len);
+}
+
+template <typename CharType>
+static void preBmh(const CharType* x, int m, SLONG bmhSkip[])
+{
+	// Shift table is indexed by the low byte of character, for wide
+	// characters colliding ones share the smallest shift
+	for (int i = 0; i < 256; i++)
+		bmhSkip[i] = m;
+
+	for (int i = 0; i < m - 1; i++)
+		bmhSkip[(UCHAR) x[i]] = m - 1 - i;
+}
+
+template <typename CharType>
+static SLONG searchBmh(const CharType* data, SLONG data_len,
+	const CharType* x, SLONG m, const SLONG bmhSkip[])
+{
+	const SLONG last = m - 1;
+
+	for (SLONG pos = 0; pos <= data_len - m; )
+	{
+		const CharType c = data[pos + last];
+
+		if (c == x[last] && memcmp(data + pos, x, last * sizeof(CharType)) == 0)
+			return pos;
+
+		pos += bmhSkip[(UCHAR) c];
+	}
+
+	return -1;
+}
+
 template <typename CharType>
 static void preKmp(const CharType *x, int m, SLONG kmpNext[])
 {
@@ -171,6 +235,14 @@ public:
 		pattern_str = temp;
 		kmpNext = static_cast<SLONG*>(alloc((_pattern_len + 1) * sizeof(SLONG)));
 		preKmp<CharType>(_pattern_str, _pattern_len, kmpNext);
+
+		bmhSkip = NULL;
+		if (_pattern_len >= BMH_MIN_PATTERN || (sizeof(CharType) > 1 && _pattern_len > 1))
+		{
+			bmhSkip = static_cast<SLONG*>(alloc(256 * sizeof(SLONG)));
+			preBmh<CharType>(_pattern_str, _pattern_len, bmhSkip);
+		}
+
 		reset();
 	}
 
@@ -192,6 +264,45 @@ public:
 			return false;
 
 		SLONG data_pos = 0;
+
+		// Long chunk is searched for the whole pattern at once. Only first
+		// pattern_len - 1 characters may complete the match started in the
+		// previous chunk and only the last pattern_len - 1 characters may
+		// start the match completed in the next one, so KMP is used for them.
+
+		const SLONG tail = data_len - (pattern_len - 1);
+
+		if (tail > pattern_len)
+		{
+			if (offset > 0)
+			{
+				while (data_pos < pattern_len - 1)
+				{
+					while (offset > -1 && pattern_str[offset] != data[data_pos])
+						offset = kmpNext[offset];
+					offset++;
+					data_pos++;
+					if (offset >= pattern_len) {
+						result = true;
+						return false;
+					}
+				}
+			}
+
+			const SLONG found = bmhSkip ?
+				searchBmh<CharType>(data, data_len, pattern_str, pattern_len, bmhSkip) :
+				searchPattern<CharType>(data, data_len, pattern_str, pattern_len);
+
+			if (found >= 0)
+			{
+				result = true;
+				return false;
+			}
+
+			data_pos = tail;
+			offset = 0;
+		}
+
 		while (data_pos < data_len)
 		{
 			while (offset > -1 && pattern_str[offset] != data[data_pos])
@@ -212,6 +323,7 @@ private:
 	SLONG offset;
 	bool result;
 	SLONG *kmpNext;
+	SLONG *bmhSkip;
 };
 
 enum PatternItemType
@@ -490,6 +602,26 @@ bool LikeEvaluator<CharType>::processNextChunk(const CharType* data, SLONG data_
 
 	while (data_pos < data_len)
 	{
+		// Single branch looking for a substring from its start may skip
+		// right to the next occurrence of it. If there is no one in this
+		// chunk only its tail may start the match.
+
+		if (branches.getCount() == 1 && branches[0].pattern->type == piSearch &&
+			branches[0].offset == 0)
+		{
+			const PatternItem* const search = branches[0].pattern;
+			const SLONG found = searchPattern<CharType>(data + data_pos, data_len - data_pos,
+				search->str.data, search->str.length);
+
+			if (found >= 0)
+				data_pos += found;
+			else
+				data_pos = MAX(data_pos, data_len - (search->str.length - 1));
+
+			if (data_pos >= data_len)
+				break;
+		}
+
 		FB_SIZE_T branch_number = 0;
 		while (branch_number < branches.getCount())
 		{
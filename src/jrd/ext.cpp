@@ -61,6 +61,20 @@
 #include "../common/isc_f_proto.h"
 #include "../common/os/os_utils.h"
 
+#ifdef WIN_NT
+#include <windows.h>
+#include <io.h>
+#endif
+
+// SSE2 is always present on x86-64
+#if defined(_M_X64) || defined(__x86_64__)
+#define EXT_SIMD
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 #if defined _MSC_VER && _MSC_VER < 1400
 // NS: in VS2003 these only work with static CRT
 extern "C" {
@@ -124,6 +138,10 @@ namespace {
 #endif
 	static const char* const FOPEN_READ_ONLY	= "rb";
 
+	// Initial and maximum size of the delimited file read buffer
+	const ULONG EXT_BUFFER_SIZE = 64 * 1024;
+	const ULONG EXT_BUFFER_LIMIT = 1024 * 1024 * 1024;
+
 	FILE* ext_fopen(Database* dbb, ExternalFile* ext_file)
 	{
 		const char* file_name = ext_file->ext_filename;
@@ -156,6 +174,332 @@ namespace {
 
 		return ext_file->ext_ifi;
 	}
+
+	FB_UINT64 ext_fsize(FILE* ifi)
+	{
+#ifdef WIN_NT
+		struct __stat64 statistics;
+		if (!_fstat64(_fileno(ifi), &statistics))
+#else
+		struct STAT statistics;
+		if (!os_utils::fstat(fileno(ifi), &statistics))
+#endif
+		{
+			return statistics.st_size;
+		}
+
+		return 0;
+	}
+
+	// Read the file data at the given offset and return the number of bytes read.
+	// Positioned reads don't move the shared file pointer, and reading past
+	// the end of file (possibly truncated by somebody meanwhile) is not an error.
+
+	ULONG ext_read(const ExternalFile* ext_file, FB_UINT64 offset, UCHAR* buffer, ULONG length)
+	{
+		ULONG total = 0;
+
+		while (total < length)
+		{
+#ifdef WIN_NT
+			const FB_UINT64 current = offset + total;
+
+			OVERLAPPED overlapped;
+			memset(&overlapped, 0, sizeof(overlapped));
+			overlapped.Offset = (DWORD) current;
+			overlapped.OffsetHigh = (DWORD) (current >> 32);
+
+			DWORD bytes = 0;
+
+			if (!ReadFile((HANDLE) _get_osfhandle(_fileno(ext_file->ext_ifi)),
+					buffer + total, length - total, &bytes, &overlapped))
+			{
+				const DWORD error = GetLastError();
+
+				if (error == ERROR_HANDLE_EOF)
+					break;
+
+				ERR_post(Arg::Gds(isc_io_error) << Arg::Str("ReadFile") << Arg::Str(ext_file->ext_filename) <<
+						 Arg::Gds(isc_io_read_err) << SYS_ERR(error));
+			}
+#else
+			const ssize_t bytes = os_utils::pread(fileno(ext_file->ext_ifi),
+				buffer + total, length - total, offset + total);
+
+			if (bytes < 0)
+			{
+				if (SYSCALL_INTERRUPTED(errno))
+					continue;
+
+				ERR_post(Arg::Gds(isc_io_error) << Arg::Str("pread") << Arg::Str(ext_file->ext_filename) <<
+						 Arg::Gds(isc_io_read_err) << SYS_ERR(errno));
+			}
+#endif
+
+			if (!bytes)
+				break;
+
+			total += (ULONG) bytes;
+		}
+
+		return total;
+	}
+
+	void ext_fill(const ExternalFile* ext_file, ExternalBuffer* buffer, FB_UINT64 position, ULONG size)
+	{
+		UCHAR* const data = buffer->ext_data.getBuffer(size);
+		const ULONG length = ext_read(ext_file, position, data, size);
+
+		buffer->ext_data.shrink(length);
+		buffer->ext_offset = position;
+		buffer->ext_eof = (length < size);
+	}
+
+	void ext_fclose(ExternalFile* ext_file)
+	{
+		fclose(ext_file->ext_ifi);
+		ext_file->ext_ifi = NULL;
+	}
+
+	// Return position of the first delimiter or line feed, or end
+
+	const UCHAR* ext_scan(const UCHAR* p, const UCHAR* const end, const UCHAR delimiter)
+	{
+#ifdef EXT_SIMD
+		const __m128i d = _mm_set1_epi8((char) delimiter);
+		const __m128i n = _mm_set1_epi8('\n');
+
+		while (end - p >= 16)
+		{
+			const __m128i v = _mm_loadu_si128((const __m128i*) p);
+			const unsigned mask = _mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, n)));
+
+			if (mask)
+			{
+#ifdef _MSC_VER
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return p + index;
+#else
+				return p + __builtin_ctz(mask);
+#endif
+			}
+
+			p += 16;
+		}
+#endif
+
+		while (p < end && *p != delimiter && *p != '\n')
+			p++;
+
+		return p;
+	}
+
+	// Return position of the line feed ending the line, or NULL if the line
+	// doesn't end before end. Line feeds inside quoted values are skipped.
+
+	const UCHAR* ext_line_end(const UCHAR* p, const UCHAR* const end, const UCHAR delimiter)
+	{
+		while (p < end)
+		{
+			if (*p == '"')
+			{
+				do
+				{
+					p = static_cast<const UCHAR*>(memchr(p + 1, '"', end - p - 1));
+
+					if (!p)
+						return NULL;
+
+					p++;
+				} while (p < end && *p == '"');
+			}
+
+			p = ext_scan(p, end, delimiter);
+
+			if (p == end)
+				return NULL;
+
+			if (*p == '\n')
+				return p;
+
+			p++;
+		}
+
+		return NULL;
+	}
+
+	// Parse values of the line ending at end into the record
+
+	void ext_parse_line(thread_db* tdbb, record_param* rpb, const UCHAR* p, const UCHAR* const end)
+	{
+		jrd_rel* const relation = rpb->rpb_relation;
+		const UCHAR delimiter = relation->rel_file->ext_delimiter;
+		Record* const record = rpb->rpb_record;
+		const Format* const format = record->getFormat();
+
+		HalfStaticArray<UCHAR, BUFFER_MEDIUM> unquoted;
+		bool endOfLine = false;
+
+		Format::fmt_desc_const_iterator desc_ptr = format->fmt_desc.begin();
+		vec<jrd_fld*>::iterator itr = relation->rel_fields->begin();
+
+		for (USHORT i = 0; i < format->fmt_count; ++i, ++itr, ++desc_ptr)
+		{
+			const jrd_fld* field = *itr;
+
+			record->setNull(i);
+
+			if (!desc_ptr->dsc_length || !field || field->fld_computation || endOfLine)
+				continue;
+
+			const UCHAR* value = p;
+			ULONG length;
+			bool quoted = false;
+
+			if (p < end && *p == '"')
+			{
+				// Quoted value may contain delimiters and line breaks,
+				// doubled quote stands for the quote itself
+
+				quoted = true;
+				unquoted.clear();
+				p++;
+
+				while (p < end)
+				{
+					const UCHAR* quote = static_cast<const UCHAR*>(memchr(p, '"', end - p));
+
+					if (!quote)
+					{
+						unquoted.add(p, end - p);
+						p = end;
+						break;
+					}
+
+					unquoted.add(p, quote - p);
+					p = quote + 1;
+
+					if (p < end && *p == '"')
+					{
+						unquoted.add('"');
+						p++;
+					}
+					else
+						break;
+				}
+
+				value = unquoted.begin();
+				length = unquoted.getCount();
+
+				p = ext_scan(p, end, delimiter);
+			}
+			else
+			{
+				p = ext_scan(p, end, delimiter);
+				length = p - value;
+			}
+
+			if (p < end && *p == delimiter)
+				p++;
+			else
+			{
+				endOfLine = true;
+
+				if (!quoted && length && value[length - 1] == '\r')
+					length--;
+			}
+
+			// Empty unquoted value is NULL
+
+			if (!quoted && !length)
+				continue;
+
+			dsc desc = *desc_ptr;
+			desc.dsc_address = record->getData() + (IPTR) desc.dsc_address;
+
+			// No field can hold that much, don't let a descriptor cut it silently
+
+			if (length > MAX_USHORT)
+			{
+				ERR_post(Arg::Gds(isc_arith_except) << Arg::Gds(isc_string_truncation) <<
+						 Arg::Gds(isc_trunc_limits) << Arg::Num(desc.getStringLength()) << Arg::Num(length));
+			}
+
+			dsc text;
+			text.makeText((USHORT) length,
+				desc.isText() ? desc.getTextType() : (USHORT) ttype_ascii, const_cast<UCHAR*>(value));
+
+			MOV_move(tdbb, &text, &desc);
+			record->clearNull(i);
+		}
+	}
+
+	bool ext_get_delimited(thread_db* tdbb, record_param* rpb, FB_UINT64& position, ExternalBuffer* buffer)
+	{
+		const ExternalFile* const file = rpb->rpb_relation->rel_file;
+		fb_assert(buffer);
+
+		ULONG size = MAX(EXT_BUFFER_SIZE, (ULONG) buffer->ext_data.getCapacity());
+
+		if (buffer->ext_data.isEmpty() || position < buffer->ext_offset ||
+			position > buffer->ext_offset + buffer->ext_data.getCount())
+		{
+			ext_fill(file, buffer, position, size);
+		}
+
+		for (;;)
+		{
+			const UCHAR* const start = buffer->ext_data.begin() + (position - buffer->ext_offset);
+			const UCHAR* const end = buffer->ext_data.end();
+
+			// Skip empty lines
+
+			const UCHAR* p = start;
+
+			while (p < end && (*p == '\n' || *p == '\r'))
+				p++;
+
+			position += p - start;
+
+			if (p < end)
+			{
+				// The last line may miss the line feed.
+				// Extra values after the record fields are skipped.
+
+				const UCHAR* lineEnd = ext_line_end(p, end, file->ext_delimiter);
+
+				if (!lineEnd && buffer->ext_eof)
+					lineEnd = end;
+
+				if (lineEnd)
+				{
+					ext_parse_line(tdbb, rpb, p, lineEnd);
+					position += lineEnd - p + (lineEnd < end ? 1 : 0);
+					return true;
+				}
+			}
+			else if (buffer->ext_eof)
+				return false;
+
+			// Read the rest of the file starting with the current line.
+			// If the line doesn't fit the buffer, enlarge it.
+
+			if (position == buffer->ext_offset)
+			{
+				if (size > EXT_BUFFER_LIMIT / 2)
+				{
+					ERR_post(Arg::Gds(isc_io_error) << Arg::Str("read") << Arg::Str(file->ext_filename) <<
+							 Arg::Gds(isc_io_read_err) << Arg::Gds(isc_random) << "Line is too long");
+				}
+
+				size *= 2;
+			}
+
+			ext_fill(file, buffer, position, size);
+		}
+	}
 } // namespace
 
 
@@ -183,24 +527,38 @@ double EXT_cardinality(thread_db* tdbb, jrd_rel* relation)
 			must_close = true;
 		}
 
-		FB_UINT64 file_size = 0;
+		const FB_UINT64 file_size = ext_fsize(file->ext_ifi);
 
-#ifdef WIN_NT
-		struct __stat64 statistics;
-		if (!_fstat64(_fileno(file->ext_ifi), &statistics))
-#else
-		struct STAT statistics;
-		if (!os_utils::fstat(fileno(file->ext_ifi), &statistics))
-#endif
+		if (file->ext_delimiter)
 		{
-			file_size = statistics.st_size;
+			// Estimate the average line length using the file head
+
+			const ULONG SAMPLE_SIZE = 64 * 1024;
+			HalfStaticArray<UCHAR, BUFFER_MEDIUM> sample;
+			UCHAR* const start = sample.getBuffer(SAMPLE_SIZE);
+			const ULONG sample_size = ext_read(file, 0, start, SAMPLE_SIZE);
+
+			const UCHAR* p = start;
+			const UCHAR* const end = start + sample_size;
+			ULONG lines = 0;
+
+			while (p < end && (p = static_cast<const UCHAR*>(memchr(p, '\n', end - p))))
+			{
+				lines++;
+				p++;
+			}
+
+			if (must_close)
+				ext_fclose(file);
+
+			if (!lines)
+				return file_size ? 1 : 0;
+
+			return (double) file_size * lines / sample_size;
 		}
 
 		if (must_close)
-		{
-			fclose(file->ext_ifi);
-			file->ext_ifi = NULL;
-		}
+			ext_fclose(file);
 
 		const Format* const format = MET_current(tdbb, relation);
 		fb_assert(format && format->fmt_length);
@@ -235,8 +593,7 @@ void EXT_erase(record_param*, jrd_tra*)
 }
 
 
-// Third param is unused.
-ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name) //, bid* description)
+ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name, UCHAR delimiter)
 {
 /**************************************
  *
@@ -246,6 +603,8 @@ ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name) //, bid* descri
  *
  * Functional description
  *	Create a file block for external file access.
+ *	Non-zero delimiter means the file contains delimited text
+ *	lines rather than fixed length records.
  *
  **************************************/
 	Database* dbb = GET_DBB();
@@ -310,6 +669,7 @@ ExternalFile* EXT_file(jrd_rel* relation, const TEXT* file_name) //, bid* descri
 	strcpy(file->ext_filename, file_name);
 	file->ext_flags = 0;
 	file->ext_ifi = NULL;
+	file->ext_delimiter = delimiter;
 
 	return file;
 }
@@ -331,10 +691,7 @@ void EXT_fini(jrd_rel* relation, bool close_only)
 	{
 		ExternalFile* file = relation->rel_file;
 		if (file->ext_ifi)
-		{
-			fclose(file->ext_ifi);
-			file->ext_ifi = NULL;
-		}
+			ext_fclose(file);
 
 		// before zeroing out the rel_file we need to deallocate the memory
 		if (!close_only)
@@ -346,7 +703,7 @@ void EXT_fini(jrd_rel* relation, bool close_only)
 }
 
 
-bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position)
+bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position, ExternalBuffer* buffer)
 {
 /**************************************
  *
@@ -362,6 +719,9 @@ bool EXT_get(thread_db* tdbb, record_param* rpb, FB_UINT64& position)
 	ExternalFile* const file = relation->rel_file;
 	fb_assert(file->ext_ifi);
 
+	if (file->ext_delimiter)
+		return ext_get_delimited(tdbb, rpb, position, buffer);
+
 	Record* const record = rpb->rpb_record;
 	const Format* const format = record->getFormat();
 
@@ -502,6 +862,14 @@ void EXT_store(thread_db* tdbb, record_param* rpb)
 	Record* record = rpb->rpb_record;
 	const Format* const format = record->getFormat();
 
+	// Delimited files are read only
+	if (file->ext_delimiter)
+	{
+		ERR_post(Arg::Gds(isc_io_error) << Arg::Str("insert") << Arg::Str(file->ext_filename) <<
+				 Arg::Gds(isc_io_write_err) <<
+				 Arg::Gds(isc_ext_readonly_err));
+	}
+
 	if (!file->ext_ifi) {
 		ext_fopen(tdbb->getDatabase(), file);
 	}
@@ -612,8 +980,5 @@ void EXT_tra_detach(ExternalFile* file, jrd_tra*)
 
 	file->ext_tra_cnt--;
 	if (!file->ext_tra_cnt && file->ext_ifi)
-	{
-		fclose(file->ext_ifi);
-		file->ext_ifi = NULL;
-	}
+		ext_fclose(file);
 }
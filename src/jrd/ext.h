@@ -25,6 +25,7 @@
 #define JRD_EXT_H
 
 #include <stdio.h>
+#include "../common/classes/array.h"
 
 namespace Jrd {
 
@@ -36,9 +37,26 @@ public:
 	USHORT	ext_flags;			// Misc and cruddy flags
 	USHORT	ext_tra_cnt;		// How many transactions used the file
 	FILE*	ext_ifi;			// Internal file identifier
+	UCHAR	ext_delimiter;		// Field delimiter of text file, zero for fixed length records
 	char	ext_filename[1];
 };
 
+// Read buffer of a delimited file scan. The file is read with positioned reads,
+// so the scans sharing the file don't disturb each other and a file truncated
+// in the middle of a scan just ends earlier.
+
+class ExternalBuffer
+{
+public:
+	explicit ExternalBuffer(MemoryPool& pool)
+		: ext_data(pool), ext_offset(0), ext_eof(false)
+	{}
+
+	Firebird::Array<UCHAR> ext_data;	// Data read from the file
+	FB_UINT64 ext_offset;				// File offset of the data
+	bool ext_eof;						// Data reaches the end of file
+};
+
 const int EXT_readonly		= 1;	// File could only be opened for read
 const int EXT_last_read		= 2;	// last operation was read
 const int EXT_last_write	= 4;	// last operation was write
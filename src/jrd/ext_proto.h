@@ -26,6 +26,7 @@
 
 namespace Jrd {
 	class ExternalFile;
+	class ExternalBuffer;
 	class jrd_tra;
 	class RecordSource;
 	class jrd_rel;
@@ -36,9 +37,9 @@ namespace Jrd {
 
 double	EXT_cardinality(Jrd::thread_db*, Jrd::jrd_rel*);
 void	EXT_erase(Jrd::record_param*, Jrd::jrd_tra*);
-Jrd::ExternalFile*	EXT_file(Jrd::jrd_rel*, const TEXT*); //, Jrd::bid*);
+Jrd::ExternalFile*	EXT_file(Jrd::jrd_rel*, const TEXT*, UCHAR);
 void	EXT_fini(Jrd::jrd_rel*, bool);
-bool	EXT_get(Jrd::thread_db*, Jrd::record_param*, FB_UINT64&);
+bool	EXT_get(Jrd::thread_db*, Jrd::record_param*, FB_UINT64&, Jrd::ExternalBuffer*);
 void	EXT_modify(Jrd::record_param*, Jrd::record_param*, Jrd::jrd_tra*);
 
 void	EXT_open(Jrd::Database*, Jrd::ExternalFile*);
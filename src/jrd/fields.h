@@ -200,3 +200,6 @@
 	FIELD(fld_idle_timer	, nam_idle_timer	, dtype_timestamp, TIMESTAMP_SIZE			, 0							, NULL		, true)
 	FIELD(fld_stmt_timeout	, nam_stmt_timeout	, dtype_long	, sizeof(SLONG)				, 0							, NULL		, false)
 	FIELD(fld_stmt_timer	, nam_stmt_timer	, dtype_timestamp, TIMESTAMP_SIZE			, 0							, NULL		, true)
+
+	FIELD(fld_histogram		, nam_histogram		, dtype_blob	, BLOB_SIZE					, isc_blob_untyped			, NULL		, true)
+	FIELD(fld_gen_cache		, nam_gen_cache		, dtype_long	, sizeof(SLONG)				, 0							, NULL		, true)
@@ -64,6 +64,7 @@
 #include "../jrd/vio_proto.h"
 #include "../jrd/tra_proto.h"
 #include "../jrd/Collation.h"
+#include "../jrd/Function.h"
 
 
 using namespace Jrd;
@@ -83,9 +84,13 @@ static idx_e check_duplicates(thread_db*, Record*, index_desc*, index_insertion*
 static idx_e check_foreign_key(thread_db*, Record*, jrd_rel*, jrd_tra*, index_desc*, IndexErrorContext&);
 static idx_e check_partner_index(thread_db*, jrd_rel*, Record*, jrd_tra*, index_desc*, jrd_rel*, USHORT);
 static bool duplicate_key(const UCHAR*, const UCHAR*, void*);
+static index_root_page* garbage_collect_trigrams(thread_db*, WIN*, index_insertion*, RecordStack&, RecordStack&,
+	IndexErrorContext&);
 static PageNumber get_root_page(thread_db*, jrd_rel*);
 static int index_block_flush(void*);
 static idx_e insert_key(thread_db*, jrd_rel*, Record*, jrd_tra*, WIN *, index_insertion*, IndexErrorContext&);
+static idx_e insert_trigrams(thread_db*, jrd_rel*, Record*, jrd_tra*, WIN *, index_insertion*, IndexErrorContext&,
+	const TrigramList&);
 static bool key_equal(const temporary_key*, const temporary_key*);
 static void release_index_block(thread_db*, IndexBlock*);
 static void signal_index_deletion(thread_db*, jrd_rel*, USHORT);
@@ -105,6 +110,274 @@ static inline USHORT getNullSegment(const temporary_key& key)
 	return MAX_USHORT;
 }
 
+static inline void excludeTrigrams(TrigramList& trigrams, const TrigramList& other)
+{
+	for (FB_SIZE_T n = trigrams.getCount(); n--;)
+	{
+		FB_SIZE_T pos;
+		if (other.find(trigrams[n], pos))
+			trigrams.remove(n);
+	}
+}
+
+
+// DeferredIndexKeys class
+
+// Pending key layout: index position, record number, key length, key data
+static const FB_SIZE_T PENDING_KEY_HEADER = sizeof(USHORT) + sizeof(SINT64) + sizeof(USHORT);
+
+DeferredIndexKeys::DeferredIndexKeys(MemoryPool& pool, jrd_tra* transaction)
+	: m_transaction(transaction),
+	  m_relation(NULL),
+	  m_indices(pool),
+	  m_pending(pool)
+{
+}
+
+DeferredIndexKeys::~DeferredIndexKeys()
+{
+	for (Index* index = m_indices.begin(); index < m_indices.end(); ++index)
+		delete index->sort;
+}
+
+// Whether the routines called by the statement may read the relation.
+// External routines and legacy UDFs can't be looked into, so they are
+// supposed to read anything, as are the routines nested too deep.
+static bool callsReader(const JrdStatement* statement, const jrd_rel* relation, unsigned depth)
+{
+	const unsigned MAX_CALL_DEPTH = 16;
+
+	if (depth > MAX_CALL_DEPTH)
+		return true;
+
+	const ResourceList& resources = statement->resources;
+
+	for (const Resource* resource = resources.begin(); resource < resources.end(); ++resource)
+	{
+		const Routine* const routine = resource->rsc_routine;
+		bool external;
+
+		if (resource->rsc_type == Resource::rsc_function)
+			external = (static_cast<const Function*>(routine)->fun_external != NULL);
+		else if (resource->rsc_type == Resource::rsc_procedure)
+			external = (static_cast<const jrd_prc*>(routine)->getExternal() != NULL);
+		else
+			continue;
+
+		const JrdStatement* const routineStatement = routine->getStatement();
+
+		if (external || !routineStatement)
+			return true;
+
+		const ResourceList& routineResources = routineStatement->resources;
+
+		for (const Resource* item = routineResources.begin(); item < routineResources.end(); ++item)
+		{
+			if (item->rsc_type == Resource::rsc_relation && item->rsc_rel == relation)
+				return true;
+		}
+
+		if (callsReader(routineStatement, relation, depth + 1))
+			return true;
+	}
+
+	return false;
+}
+
+// Keys may be deferred only while nobody could look for the stored records
+// using the index: the request has no stream except the stored relation
+// (no sub-queries, no MERGE or UPDATE OR INSERT matching), the routines it
+// calls don't read the relation and the relation has no triggers.
+bool DeferredIndexKeys::accept(const jrd_req* request, jrd_rel* relation)
+{
+	if (request->req_transaction != m_transaction || request->req_rpb.getCount() != 1 ||
+		relation->rel_pre_store || relation->rel_post_store ||
+		callsReader(request->getStatement(), relation, 0))
+	{
+		return false;
+	}
+
+	if (!m_relation)
+		m_relation = relation;
+
+	return m_relation == relation;
+}
+
+bool DeferredIndexKeys::put(thread_db* tdbb, index_desc* idx, const temporary_key& key,
+	RecordNumber number)
+{
+	const Index* const index = getIndex(tdbb, idx);
+
+	if (key.key_length > index->keyLength)
+		return false;
+
+	const USHORT position = index - m_indices.begin();
+	const SINT64 value = number.getValue();
+
+	const FB_SIZE_T offset = m_pending.getCount();
+	UCHAR* p = m_pending.getBuffer(offset + PENDING_KEY_HEADER + key.key_length) + offset;
+
+	memcpy(p, &position, sizeof(position));
+	p += sizeof(position);
+	memcpy(p, &value, sizeof(value));
+	p += sizeof(value);
+	memcpy(p, &key.key_length, sizeof(key.key_length));
+	p += sizeof(key.key_length);
+	memcpy(p, key.key_data, key.key_length);
+
+	return true;
+}
+
+void DeferredIndexKeys::confirm(thread_db* tdbb)
+{
+	Database* const dbb = tdbb->getDatabase();
+
+	for (const UCHAR* p = m_pending.begin(); p < m_pending.end();)
+	{
+		USHORT position, length;
+		SINT64 number;
+
+		memcpy(&position, p, sizeof(position));
+		p += sizeof(position);
+		memcpy(&number, p, sizeof(number));
+		p += sizeof(number);
+		memcpy(&length, p, sizeof(length));
+		p += sizeof(length);
+
+		Index& index = m_indices[position];
+
+		if (!index.sort)
+		{
+			sort_key_def key_desc[2];
+			// Key sort description
+			key_desc[0].setSkdLength(SKD_bytes, index.keyLength);
+			key_desc[0].skd_flags = SKD_ascending;
+			key_desc[0].setSkdOffset();
+			key_desc[0].skd_vary_offset = 0;
+			// RecordNumber sort description
+			key_desc[1].setSkdLength(SKD_int64, sizeof(RecordNumber));
+			key_desc[1].skd_flags = SKD_ascending;
+			key_desc[1].setSkdOffset(key_desc);
+			key_desc[1].skd_vary_offset = 0;
+
+			index.sort = FB_NEW_POOL(m_transaction->tra_sorts.getPool())
+				Sort(dbb, &m_transaction->tra_sorts, index.keyLength + sizeof(index_sort_record),
+					 2, 1, key_desc, NULL, NULL);
+		}
+
+		UCHAR* record;
+		index.sort->put(tdbb, reinterpret_cast<ULONG**>(&record));
+
+		memcpy(record, p, length);
+		memset(record + length, 0, index.keyLength - length);
+		p += length;
+
+		index_sort_record* const isr = (index_sort_record*) (record + index.keyLength);
+		isr->isr_record_number = number;
+		isr->isr_key_length = length;
+		isr->isr_flags = 0;
+	}
+
+	m_pending.clear();
+}
+
+void DeferredIndexKeys::discard()
+{
+	m_pending.clear();
+}
+
+// Insert collected keys into the indices. Keys are sorted, so consecutive
+// insertions mostly hit the same already cached leaf page. The keys are
+// not covered by the undo of the records, so if some of them can't be
+// inserted, the transaction is invalidated rather than let the records
+// be committed with the incomplete indices.
+void DeferredIndexKeys::flush(thread_db* tdbb)
+{
+	fb_assert(m_pending.isEmpty());
+
+	if (!m_relation)
+		return;
+
+	RelationPages* const relPages = m_relation->getPages(tdbb);
+
+	temporary_key key;
+	key.key_flags = 0;
+	key.key_nulls = 0;
+
+	index_desc idx;
+
+	index_insertion insertion;
+	insertion.iib_relation = m_relation;
+	insertion.iib_key = &key;
+	insertion.iib_descriptor = &idx;
+	insertion.iib_transaction = m_transaction;
+	insertion.iib_btr_level = 0;
+
+	try
+	{
+		for (Index* index = m_indices.begin(); index < m_indices.end(); ++index)
+		{
+			if (!index->sort)
+				continue;
+
+			AutoPtr<Sort> scb(index->sort);
+			index->sort = NULL;
+
+			scb->sort(tdbb);
+
+			while (true)
+			{
+				UCHAR* record;
+				scb->get(tdbb, reinterpret_cast<ULONG**>(&record));
+
+				if (!record)
+					break;
+
+				const index_sort_record* const isr = (index_sort_record*) (record + index->keyLength);
+				key.key_length = isr->isr_key_length;
+				memcpy(key.key_data, record, key.key_length);
+				insertion.iib_number.setValue(isr->isr_record_number);
+
+				WIN window(relPages->rel_pg_space_id, relPages->rel_index_root);
+				index_root_page* const root = (index_root_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+				// The index is gone, nothing to maintain
+				if (!BTR_description(tdbb, m_relation, root, &idx, index->id))
+				{
+					CCH_RELEASE(tdbb, &window);
+					break;
+				}
+
+				BTR_insert(tdbb, &window, &insertion);
+
+				if (--tdbb->tdbb_quantum < 0)
+					JRD_reschedule(tdbb, 0, true);
+			}
+		}
+	}
+	catch (const Exception&)
+	{
+		m_transaction->tra_flags |= TRA_invalidated;
+		throw;
+	}
+}
+
+DeferredIndexKeys::Index* DeferredIndexKeys::getIndex(thread_db* tdbb, index_desc* idx)
+{
+	for (Index* index = m_indices.begin(); index < m_indices.end(); ++index)
+	{
+		if (index->id == idx->idx_id)
+			return index;
+	}
+
+	Index index;
+	index.id = idx->idx_id;
+	index.keyLength = ROUNDUP(BTR_key_length(tdbb, m_relation, idx), sizeof(SINT64));
+	index.sort = NULL;
+
+	return m_indices.begin() + m_indices.add(index);
+}
+
 
 void IDX_check_access(thread_db* tdbb, CompilerScratch* csb, jrd_rel* view, jrd_rel* relation)
 {
@@ -274,6 +547,7 @@ void IDX_create_index(thread_db* tdbb,
 	const bool isDescending = (idx->idx_flags & idx_descending);
 	const bool isPrimary = (idx->idx_flags & idx_primary);
 	const bool isForeign = (idx->idx_flags & idx_foreign);
+	const bool isTrigram = (idx->idx_flags & idx_trigram);
 
 	// hvlad: in ODS11 empty string and NULL values can have the same binary
 	// representation in index keys. BTR can distinguish it by the key_length
@@ -361,7 +635,9 @@ void IDX_create_index(thread_db* tdbb,
 	IndexErrorContext context(relation, idx, index_name);
 
 	// Loop thru the relation computing index keys.  If there are old versions, find them, too.
+	// Trigram index puts a sort record for every distinct key of the record.
 	temporary_key key;
+	TrigramList trigrams;
 	while (DPM_next(tdbb, &primary, LCK_read, false))
 	{
 		if (!VIO_garbage_collect(tdbb, &primary, transaction))
@@ -396,7 +672,13 @@ void IDX_create_index(thread_db* tdbb,
 		{
 			Record* record = stack.pop();
 
-			result = BTR_key(tdbb, relation, record, idx, &key, false);
+			if (isTrigram)
+			{
+				result = BTR_trigrams(tdbb, relation, record, idx, trigrams);
+				key.key_length = 0;
+			}
+			else
+				result = BTR_key(tdbb, relation, record, idx, &key, false);
 
 			if (result == idx_e_ok)
 			{
@@ -447,8 +729,40 @@ void IDX_create_index(thread_db* tdbb,
 				context.raise(tdbb, idx_e_keytoobig, record);
 			}
 
-			UCHAR* p;
-			scb->put(tdbb, reinterpret_cast<ULONG**>(&p));
+			const FB_SIZE_T keyCount = isTrigram ? trigrams.getCount() : 1;
+
+			for (FB_SIZE_T n = 0; n < keyCount; n++)
+			{
+				if (isTrigram)
+					trigrams[n].makeKey(&key);
+
+				UCHAR* p;
+				scb->put(tdbb, reinterpret_cast<ULONG**>(&p));
+
+				if (nullIndLen)
+					*p++ = (key.key_length == 0) ? 0 : 1;
+
+				if (key.key_length > 0)
+				{
+					memcpy(p, key.key_data, key.key_length);
+					p += key.key_length;
+				}
+
+				int l = int(key_length) - nullIndLen - key.key_length;	// must be signed
+
+				if (l > 0)
+				{
+					memset(p, pad, l);
+					p += l;
+				}
+
+				const bool key_is_null = (key.key_nulls == (1 << idx->idx_count) - 1);
+
+				index_sort_record* isr = (index_sort_record*) p;
+				isr->isr_record_number = primary.rpb_number.getValue();
+				isr->isr_key_length = key.key_length;
+				isr->isr_flags = (stack.hasData() ? ISR_secondary : 0) | (key_is_null ? ISR_null : 0);
+			}
 
 			// try to catch duplicates early
 
@@ -462,29 +776,6 @@ void IDX_create_index(thread_db* tdbb,
 				break;
 			}
 
-			if (nullIndLen)
-				*p++ = (key.key_length == 0) ? 0 : 1;
-
-			if (key.key_length > 0)
-			{
-				memcpy(p, key.key_data, key.key_length);
-				p += key.key_length;
-			}
-
-			int l = int(key_length) - nullIndLen - key.key_length;	// must be signed
-
-			if (l > 0)
-			{
-				memset(p, pad, l);
-				p += l;
-			}
-
-			const bool key_is_null = (key.key_nulls == (1 << idx->idx_count) - 1);
-
-			index_sort_record* isr = (index_sort_record*) p;
-			isr->isr_record_number = primary.rpb_number.getValue();
-			isr->isr_key_length = key.key_length;
-			isr->isr_flags = (stack.hasData() ? ISR_secondary : 0) | (key_is_null ? ISR_null : 0);
 			if (record != gc_record)
 				delete record;
 		}
@@ -736,6 +1027,12 @@ void IDX_garbage_collect(thread_db* tdbb, record_param* rpb, RecordStack& going,
 		{
 			IndexErrorContext context(rpb->rpb_relation, &idx);
 
+			if (idx.idx_flags & idx_trigram)
+			{
+				root = garbage_collect_trigrams(tdbb, &window, &insertion, going, staying, context);
+				continue;
+			}
+
 			for (RecordStack::iterator stack1(going); stack1.hasData(); ++stack1)
 			{
 				Record* const rec1 = stack1.object();
@@ -843,6 +1140,8 @@ void IDX_modify(thread_db* tdbb,
 	insertion.iib_transaction = transaction;
 	insertion.iib_btr_level = 0;
 
+	TrigramList trigrams1, trigrams2;
+
 	RelationPages* relPages = org_rpb->rpb_relation->getPages(tdbb);
 	WIN window(relPages->rel_pg_space_id, -1);
 
@@ -851,6 +1150,35 @@ void IDX_modify(thread_db* tdbb,
 		IndexErrorContext context(new_rpb->rpb_relation, &idx);
 		idx_e error_code;
 
+		if (idx.idx_flags & idx_trigram)
+		{
+			// Insert only the keys the original record version doesn't have
+
+			if ((error_code = BTR_trigrams(tdbb, new_rpb->rpb_relation,
+					new_rpb->rpb_record, &idx, trigrams1)))
+			{
+				CCH_RELEASE(tdbb, &window);
+				context.raise(tdbb, error_code, new_rpb->rpb_record);
+			}
+
+			if ((error_code = BTR_trigrams(tdbb, org_rpb->rpb_relation,
+					org_rpb->rpb_record, &idx, trigrams2)))
+			{
+				CCH_RELEASE(tdbb, &window);
+				context.raise(tdbb, error_code, org_rpb->rpb_record);
+			}
+
+			excludeTrigrams(trigrams1, trigrams2);
+
+			if ((error_code = insert_trigrams(tdbb, new_rpb->rpb_relation, new_rpb->rpb_record,
+											  transaction, &window, &insertion, context, trigrams1)))
+			{
+				context.raise(tdbb, error_code, new_rpb->rpb_record);
+			}
+
+			continue;
+		}
+
 		if ((error_code = BTR_key(tdbb, new_rpb->rpb_relation,
 				new_rpb->rpb_record, &idx, &key1, false)))
 		{
@@ -952,7 +1280,8 @@ void IDX_modify_check_constraints(thread_db* tdbb,
 }
 
 
-void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity)
+void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityList& selectivity,
+					IndexDistribution* distribution)
 {
 /**************************************
  *
@@ -962,17 +1291,17 @@ void IDX_statistics(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityLi
  *
  * Functional description
  *	Scan index pages recomputing
- *	selectivity.
+ *	selectivity and values distribution.
  *
  **************************************/
 
 	SET_TDBB(tdbb);
 
-	BTR_selectivity(tdbb, relation, id, selectivity);
+	BTR_selectivity(tdbb, relation, id, selectivity, distribution);
 }
 
 
-void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
+void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction, DeferredIndexKeys* deferredKeys)
 {
 /**************************************
  *
@@ -984,6 +1313,8 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
  *	Update the various indices after a STORE operation.  If a duplicate
  *	index is violated, return the index number.  If successful, return
  *	-1.
+ *	If deferred keys are passed, keys of the indices that check nothing
+ *	are collected there instead of being inserted now.
  *
  **************************************/
 	SET_TDBB(tdbb);
@@ -1001,6 +1332,8 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 	insertion.iib_transaction = transaction;
 	insertion.iib_btr_level = 0;
 
+	TrigramList trigrams;
+
 	RelationPages* relPages = rpb->rpb_relation->getPages(tdbb);
 	WIN window(relPages->rel_pg_space_id, -1);
 
@@ -1009,12 +1342,35 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 		IndexErrorContext context(rpb->rpb_relation, &idx);
 		idx_e error_code;
 
+		if (idx.idx_flags & idx_trigram)
+		{
+			if ((error_code = BTR_trigrams(tdbb, rpb->rpb_relation, rpb->rpb_record, &idx, trigrams)))
+			{
+				CCH_RELEASE(tdbb, &window);
+				context.raise(tdbb, error_code, rpb->rpb_record);
+			}
+
+			if ((error_code = insert_trigrams(tdbb, rpb->rpb_relation, rpb->rpb_record, transaction,
+											  &window, &insertion, context, trigrams)))
+			{
+				context.raise(tdbb, error_code, rpb->rpb_record);
+			}
+
+			continue;
+		}
+
 		if ( (error_code = BTR_key(tdbb, rpb->rpb_relation, rpb->rpb_record, &idx, &key, false)) )
 		{
 			CCH_RELEASE(tdbb, &window);
 			context.raise(tdbb, error_code, rpb->rpb_record);
 		}
 
+		if (deferredKeys && DeferredIndexKeys::isDeferred(&idx) &&
+			deferredKeys->put(tdbb, &idx, key, rpb->rpb_number))
+		{
+			continue;
+		}
+
 		if ( (error_code = insert_key(tdbb, rpb->rpb_relation, rpb->rpb_record, transaction,
 									  &window, &insertion, context)) )
 		{
@@ -1384,6 +1740,103 @@ static bool duplicate_key(const UCHAR* record1, const UCHAR* record2, void* ifl_
 }
 
 
+static index_root_page* garbage_collect_trigrams(thread_db* tdbb,
+												 WIN* window,
+												 index_insertion* insertion,
+												 RecordStack& going,
+												 RecordStack& staying,
+												 IndexErrorContext& context)
+{
+/**************************************
+ *
+ *	g a r b a g e _ c o l l e c t _ t r i g r a m s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Garbage collect a trigram index. Key of a going record
+ *	is removed only if no other going or staying record
+ *	produces it. Return the re-fetched index root page.
+ *
+ **************************************/
+	jrd_rel* const relation = insertion->iib_relation;
+	index_desc* const idx = insertion->iib_descriptor;
+	index_root_page* root = (index_root_page*) window->win_buffer;
+
+	TrigramList stayingTrigrams, trigrams1, trigrams2;
+
+	for (RecordStack::iterator stack3(staying); stack3.hasData(); ++stack3)
+	{
+		Record* const rec3 = stack3.object();
+
+		const idx_e result = BTR_trigrams(tdbb, relation, rec3, idx, trigrams2);
+		if (result != idx_e_ok)
+		{
+			if (result == idx_e_conversion)
+				continue;
+
+			CCH_RELEASE(tdbb, window);
+			context.raise(tdbb, result, rec3);
+		}
+
+		for (const TrigramKey* trigram = trigrams2.begin(); trigram != trigrams2.end(); ++trigram)
+		{
+			FB_SIZE_T pos;
+			if (!stayingTrigrams.find(*trigram, pos))
+				stayingTrigrams.insert(pos, *trigram);
+		}
+	}
+
+	for (RecordStack::iterator stack1(going); stack1.hasData(); ++stack1)
+	{
+		Record* const rec1 = stack1.object();
+
+		idx_e result = BTR_trigrams(tdbb, relation, rec1, idx, trigrams1);
+		if (result != idx_e_ok)
+		{
+			if (result == idx_e_conversion)
+				continue;
+
+			CCH_RELEASE(tdbb, window);
+			context.raise(tdbb, result, rec1);
+		}
+
+		// Keys shared with the remaining going records are removed along with them
+
+		RecordStack::iterator stack2(stack1);
+		for (++stack2; stack2.hasData() && trigrams1.hasData(); ++stack2)
+		{
+			Record* const rec2 = stack2.object();
+
+			result = BTR_trigrams(tdbb, relation, rec2, idx, trigrams2);
+			if (result != idx_e_ok)
+			{
+				if (result == idx_e_conversion)
+					continue;
+
+				CCH_RELEASE(tdbb, window);
+				context.raise(tdbb, result, rec2);
+			}
+
+			excludeTrigrams(trigrams1, trigrams2);
+		}
+
+		excludeTrigrams(trigrams1, stayingTrigrams);
+
+		for (const TrigramKey* trigram = trigrams1.begin(); trigram != trigrams1.end(); ++trigram)
+		{
+			trigram->makeKey(insertion->iib_key);
+
+			BTR_remove(tdbb, window, insertion);
+			root = (index_root_page*) CCH_FETCH(tdbb, window, LCK_read, pag_root);
+			BTR_description(tdbb, relation, root, idx, idx->idx_id);
+		}
+	}
+
+	return root;
+}
+
+
 static PageNumber get_root_page(thread_db* tdbb, jrd_rel* relation)
 {
 /**************************************
@@ -1565,6 +2018,54 @@ void IDX_modify_flag_uk_modified(thread_db* tdbb,
 }
 
 
+static idx_e insert_trigrams(thread_db* tdbb,
+							 jrd_rel* relation,
+							 Record* record,
+							 jrd_tra* transaction,
+							 WIN * window_ptr,
+							 index_insertion* insertion,
+							 IndexErrorContext& context,
+							 const TrigramList& trigrams)
+{
+/**************************************
+ *
+ *	i n s e r t _ t r i g r a m s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert the keys of a record into a trigram index.
+ *	Index root page is released by every insertion, so
+ *	re-fetch it and the index description before the next one.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	index_desc* const idx = insertion->iib_descriptor;
+
+	for (const TrigramKey* trigram = trigrams.begin(); trigram != trigrams.end(); ++trigram)
+	{
+		if (trigram != trigrams.begin())
+		{
+			index_root_page* const root =
+				(index_root_page*) CCH_FETCH(tdbb, window_ptr, LCK_read, pag_root);
+
+			if (!BTR_description(tdbb, relation, root, idx, idx->idx_id))
+				break;
+		}
+
+		trigram->makeKey(insertion->iib_key);
+
+		const idx_e result = insert_key(tdbb, relation, record, transaction, window_ptr, insertion, context);
+
+		if (result != idx_e_ok)
+			return result;
+	}
+
+	return idx_e_ok;
+}
+
+
 static bool key_equal(const temporary_key* key1, const temporary_key* key2)
 {
 /**************************************
@@ -178,6 +178,7 @@ enum irq_type_t
 
 	irq_linger,				// get database linger value
 	irq_dbb_ss_definer,		// get database sql security value
+	irq_l_histogram,		// lookup index values distribution
 
 	irq_MAX
 };
@@ -6747,6 +6747,11 @@ static JAttachment* initAttachment(thread_db* tdbb, const PathName& expanded_nam
 			dbb->dbb_flags |= DBB_gc_cooperative;
 	}
 
+	// set an encoding of the new records
+
+	if (dbb->dbb_config->getRecordCompression() == RecordCompressionLZ)
+		dbb->dbb_flags |= DBB_lz_records;
+
 	return jAtt;
 }
 
@@ -6989,10 +6994,12 @@ static void release_attachment(thread_db* tdbb, Jrd::Attachment* attachment)
 	sync.lock(SYNC_EXCLUSIVE);
 
 	// stop the crypt thread if we release last regular attachment
+	// crypt thread helpers are waited for by crypt thread and never stop it
 	Jrd::Attachment* crypt_att = NULL;
 	CRYPT_DEBUG(fprintf(stderr, "\nrelease attachment=%p\n", attachment));
 
-	for (Jrd::Attachment* att = dbb->dbb_attachments; att; att = att->att_next)
+	Jrd::Attachment* const first = (attachment->att_flags & ATT_crypt_thread) ? NULL : dbb->dbb_attachments;
+	for (Jrd::Attachment* att = first; att; att = att->att_next)
 	{
 		CRYPT_DEBUG(fprintf(stderr, "att=%p crypt_att=%p F=%c ", att, crypt_att, att->att_flags & ATT_crypt_thread ? '1' : '0'));
 
@@ -7236,6 +7243,8 @@ bool JRD_shutdown_database(Database* dbb, const unsigned flags)
 		LCK_release(tdbb, dbb->dbb_retaining_lock);
 
 	dbb->dbb_shared_counter.shutdown(tdbb);
+	dbb->dbb_format_cache.shutdown(tdbb);
+	dbb->dbb_gen_cache.shutdown(tdbb);
 
 	if (dbb->dbb_sweep_lock)
 		LCK_release(tdbb, dbb->dbb_sweep_lock);
@@ -124,6 +124,7 @@ class jrd_rel;
 class ExternalFile;
 class ViewContext;
 class IndexBlock;
+class IndexDistribution;
 class IndexLock;
 class ArrayField;
 struct sort_context;
@@ -290,6 +291,7 @@ public:
 	JrdStatement* idb_expression_statement;	// statement for index expression evaluation
 	dsc			idb_expression_desc;		// descriptor for expression result
 	Lock*		idb_lock;					// lock to synchronize changes to index
+	IndexDistribution* idb_distribution;	// values distribution of the leading segment
 	USHORT		idb_id;
 };
 
@@ -549,6 +549,8 @@ static lck_owner_t get_owner_type(enum lck_t lock_type)
 	case LCK_sweep:
 	case LCK_crypt:
 	case LCK_crypt_status:
+	case LCK_rel_formats:
+	case LCK_gen_cache:
 		owner_type = LCK_OWNER_database;
 		break;
 
@@ -70,7 +70,9 @@ enum lck_t {
 	LCK_rel_rescan,				// Relation forced rescan lock
 	LCK_crypt,					// Crypt lock for single crypt thread
 	LCK_crypt_status,			// Notifies about changed database encryption status
-	LCK_record_gc				// Record-level GC lock
+	LCK_record_gc,				// Record-level GC lock
+	LCK_rel_formats,			// Relation formats cache lock
+	LCK_gen_cache				// Cached generator values lock
 };
 
 // Lock owner types
@@ -26,16 +26,13 @@
  *
  */
 
+#include "firebird.h"
+#include "gen/iberror.h"
+#include "../common/StatusArg.h"
 #include "../common/classes/alloc.h"
 #include <assert.h>
 
-const isc_like_escape_invalid = 1;
-
-void ERR_post(...) {
-	throw Firebird::LongJump();
-}
-
-#include "evl_string.h"
+#include "../jrd/evl_string.h"
 
 using namespace Firebird;
 
@@ -43,7 +40,8 @@ class StringLikeEvaluator : public LikeEvaluator<char>
 {
 public:
 	StringLikeEvaluator(MemoryPool *pool, const char *pattern, char escape_char)
-		: LikeEvaluator<char>(*pool, pattern, (SSHORT) strlen(pattern), escape_char, '%', '_')
+		: LikeEvaluator<char>(*pool, pattern, (SSHORT) strlen(pattern), escape_char,
+			escape_char != 0, '%', '_')
 	{}
 
 	void process(const char *data, bool more, bool result)
@@ -58,8 +56,8 @@ public:
 class StringStartsEvaluator : public StartsEvaluator<char>
 {
 public:
-	StringStartsEvaluator(const char *pattern)
-		: StartsEvaluator<char>(pattern, (SSHORT)strlen(pattern))
+	StringStartsEvaluator(MemoryPool *pool, const char *pattern)
+		: StartsEvaluator<char>(*pool, pattern, (SSHORT)strlen(pattern))
 	{}
 
 	void process(const char *data, bool more, bool result)
@@ -87,6 +85,166 @@ public:
 	}
 };
 
+// Reference search for the checks of the optimized ones
+template <typename CharType>
+SLONG naiveSearch(const CharType* data, SLONG data_len, const CharType* pattern, SLONG pattern_len)
+{
+	for (SLONG pos = 0; pos <= data_len - pattern_len; pos++)
+	{
+		if (memcmp(data + pos, pattern, pattern_len * sizeof(CharType)) == 0)
+			return pos;
+	}
+
+	return -1;
+}
+
+// Feed the data to CONTAINING in chunks of the given length
+template <typename CharType>
+bool containsChunked(MemoryPool* pool, const CharType* data, SLONG data_len,
+	const CharType* pattern, SLONG pattern_len, SLONG chunk)
+{
+	ContainsEvaluator<CharType> evaluator(*pool, pattern, pattern_len);
+
+	for (SLONG pos = 0; pos < data_len; pos += chunk)
+	{
+		if (!evaluator.processNextChunk(data + pos, MIN(chunk, data_len - pos)))
+			break;
+	}
+
+	return evaluator.getResult();
+}
+
+// Same for LIKE '%pattern%'
+bool likeChunked(MemoryPool* pool, const UCHAR* data, SLONG data_len,
+	const UCHAR* pattern, SLONG pattern_len, SLONG chunk)
+{
+	UCHAR like[128];
+	like[0] = '%';
+	memcpy(like + 1, pattern, pattern_len);
+	like[pattern_len + 1] = '%';
+
+	LikeEvaluator<UCHAR> evaluator(*pool, like, pattern_len + 2, 0, false, '%', '_');
+
+	for (SLONG pos = 0; pos < data_len; pos += chunk)
+	{
+		if (!evaluator.processNextChunk(data + pos, MIN(chunk, data_len - pos)))
+			break;
+	}
+
+	return evaluator.getResult();
+}
+
+// Check substring search paths: vector search of bytes (16 and 32 bytes
+// per step), Boyer-Moore-Horspool for long and wide patterns and chunked
+// evaluation, where matches may straddle the chunks
+void testSearch(MemoryPool* p)
+{
+	const SLONG TEXT_LEN = 100;
+	const SLONG MAX_PATTERN = 40;
+	UCHAR text[TEXT_LEN];
+	UCHAR pattern[MAX_PATTERN];
+
+	for (SLONG i = 0; i < MAX_PATTERN; i++)
+		pattern[i] = 'A' + i;
+
+	// Empty pattern and patterns longer than the text
+	assert(searchBytes(text, 0, pattern, 0) == 0);
+	assert(searchBytes(pattern, 5, pattern, 6) == -1);
+	assert(searchBytes(pattern, 0, pattern, 1) == -1);
+	assert(!containsChunked(p, pattern, 5, pattern, 6, 5));
+
+	for (SLONG len = 1; len <= MAX_PATTERN; len++)
+	{
+		// Match at every position, including the ones around 16 and 32 byte
+		// boundaries and at the very end of the text
+		for (SLONG pos = 0; pos + len <= TEXT_LEN; pos++)
+		{
+			memset(text, '.', TEXT_LEN);
+			memcpy(text + pos, pattern, len);
+
+			assert(searchBytes(text, TEXT_LEN, pattern, len) == pos);
+			assert(searchBytes(text, pos + len, pattern, len) == pos);
+			assert(searchBytes(text, pos + len - 1, pattern, len) == -1);
+
+			// Matches straddling the chunks
+			const SLONG chunks[] = {1, 7, 16, 17, 32, 33, pos + 1, pos + len / 2 + 1};
+			for (unsigned i = 0; i < FB_NELEM(chunks); i++)
+			{
+				assert(containsChunked(p, text, TEXT_LEN, pattern, len, chunks[i]));
+				assert(likeChunked(p, text, TEXT_LEN, pattern, len, chunks[i]));
+			}
+		}
+
+		// Candidates with the first and the last byte matching but not the middle
+		// ones, and a partial match at the end of the chunk, then the real match
+		memset(text, '.', TEXT_LEN);
+		for (SLONG pos = 0; pos + len <= TEXT_LEN; pos += len + 1)
+		{
+			memcpy(text + pos, pattern, len);
+			if (len > 2)
+				text[pos + len / 2] = '#';
+			else if (len == 2)
+				text[pos + 1] = '#';
+			else
+				text[pos] = '#';
+		}
+
+		assert(searchBytes(text, TEXT_LEN, pattern, len) == -1);
+		assert(!containsChunked(p, text, TEXT_LEN, pattern, len, 16));
+		assert(!containsChunked(p, text, TEXT_LEN, pattern, len, TEXT_LEN));
+		assert(!likeChunked(p, text, TEXT_LEN, pattern, len, 32));
+
+		memcpy(text + TEXT_LEN - len, pattern, len);
+		assert(searchBytes(text, TEXT_LEN, pattern, len) ==
+			naiveSearch<UCHAR>(text, TEXT_LEN, pattern, len));
+		assert(containsChunked(p, text, TEXT_LEN, pattern, len, 16));
+		assert(containsChunked(p, text, TEXT_LEN, pattern, len, TEXT_LEN));
+		assert(likeChunked(p, text, TEXT_LEN, pattern, len, 32));
+	}
+
+	// Single character patterns in repetitive text
+	memset(text, 'a', TEXT_LEN);
+	assert(searchBytes(text, TEXT_LEN, (const UCHAR*) "b", 1) == -1);
+	text[TEXT_LEN - 1] = 'b';
+	assert(searchBytes(text, TEXT_LEN, (const UCHAR*) "b", 1) == TEXT_LEN - 1);
+	assert(containsChunked(p, text, TEXT_LEN, (const UCHAR*) "b", 1, 16));
+
+	// Self-overlapping long pattern, BMH must not skip past the match
+	UCHAR overlap[MAX_PATTERN];
+	memset(overlap, 'a', MAX_PATTERN);
+	overlap[MAX_PATTERN - 1] = 'b';
+	memset(text, 'a', TEXT_LEN);
+	text[TEXT_LEN - 3] = 'b';
+	assert(containsChunked(p, text, TEXT_LEN, overlap, MAX_PATTERN, TEXT_LEN));
+	assert(containsChunked(p, text, TEXT_LEN, overlap, MAX_PATTERN, 33));
+	text[TEXT_LEN - 3] = 'c';
+	assert(!containsChunked(p, text, TEXT_LEN, overlap, MAX_PATTERN, TEXT_LEN));
+
+	// Wide characters always use BMH with the shift table indexed by low byte,
+	// characters differing in high byte only must not be confused
+	USHORT wideText[TEXT_LEN];
+	USHORT widePattern[MAX_PATTERN];
+
+	for (SLONG i = 0; i < MAX_PATTERN; i++)
+		widePattern[i] = 0x100 + 'A' + i;
+
+	for (SLONG len = 2; len <= MAX_PATTERN; len += 7)
+	{
+		for (SLONG pos = 0; pos + len <= TEXT_LEN; pos += 3)
+		{
+			for (SLONG i = 0; i < TEXT_LEN; i++)
+				wideText[i] = 'A' + i % len;
+
+			assert(!containsChunked<USHORT>(p, wideText, TEXT_LEN, widePattern, len, TEXT_LEN));
+
+			memcpy(wideText + pos, widePattern, len * sizeof(USHORT));
+			assert(containsChunked<USHORT>(p, wideText, TEXT_LEN, widePattern, len, TEXT_LEN));
+			assert(containsChunked<USHORT>(p, wideText, TEXT_LEN, widePattern, len, 16));
+			assert(containsChunked<USHORT>(p, wideText, TEXT_LEN, widePattern, len, pos + 1));
+		}
+	}
+}
+
 int main()
 {
 	MemoryPool *p = MemoryPool::createPool();
@@ -173,7 +331,7 @@ int main()
     t13.process("t", false, true);
 
 	// Test STARTS
-	StringStartsEvaluator t14("test");
+	StringStartsEvaluator t14(p, "test");
 	t14.process("test", false, true);
 	t14.reset();
 	t14.process("te!", false, false);
@@ -197,5 +355,7 @@ int main()
 		"4. Painting with flare and style...tips, dos, and don'ts from an expert at PARA Paints.\n"
 		"5.  The facts on zoo animal diets.", true, false);
 
+	testSearch(p);
+
 	return 0;
 }
@@ -0,0 +1,259 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+/*
+ * Regression test for the compiled conjuncts of filtered streams.
+ * Comparisons of a column with a literal are evaluated straight from the
+ * record buffer, everything else goes through the generic row path.
+ * Every filter below is run both ways: as written, and with the column
+ * wrapped into COALESCE(col, col), which keeps its type but isn't a field
+ * reference, so the compiled path is never used. The results must match
+ * for every type, operator and operand order, with NULLs in the data,
+ * with literals that can't be converted to the column type, and for
+ * records stored in older formats after the table is altered.
+ *
+ * Run with: isql -q -i filter_terms_test.sql
+ * The script fails with an exception if any filter returns other rows.
+ */
+
+create database 'filter_terms_test.fdb';
+
+create table t (
+	id integer,
+	s smallint,
+	i integer,
+	b bigint,
+	n numeric(18, 2),
+	n4 numeric(9, 4),
+	d double precision,
+	dt date,
+	tm time,
+	ts timestamp,
+	df16 decfloat(16),
+	df34 decfloat(34)
+);
+
+create table ops (
+	op varchar(2)
+);
+
+create table cases (
+	col varchar(31),
+	lit varchar(60)
+);
+
+create exception ex_filter_terms 'Filter mismatch';
+
+insert into ops values ('=');
+insert into ops values ('<>');
+insert into ops values ('<');
+insert into ops values ('<=');
+insert into ops values ('>');
+insert into ops values ('>=');
+
+-- Literals of the column type, of other exact types and scales,
+-- lossy and out of range ones that must be left to the row path
+
+insert into cases values ('s', '0');
+insert into cases values ('s', '-10');
+insert into cases values ('s', '9');
+insert into cases values ('s', '5.00');
+insert into cases values ('s', '5.5');
+insert into cases values ('s', '100000');
+insert into cases values ('i', '0');
+insert into cases values ('i', '-25');
+insert into cases values ('i', '3');
+insert into cases values ('i', '2.50');
+insert into cases values ('i', '5000000000');
+insert into cases values ('b', '0');
+insert into cases values ('b', '5000000000');
+insert into cases values ('b', '-7');
+insert into cases values ('n', '0');
+insert into cases values ('n', '2.25');
+insert into cases values ('n', '-5');
+insert into cases values ('n', '2.255');
+insert into cases values ('n4', '1.25');
+insert into cases values ('n4', '-0.1250');
+insert into cases values ('n4', '3');
+insert into cases values ('d', '0');
+insert into cases values ('d', '1.5');
+insert into cases values ('d', '-7');
+insert into cases values ('d', '2.5e0');
+insert into cases values ('dt', 'date ''2020-01-15''');
+insert into cases values ('dt', 'date ''2019-12-31''');
+insert into cases values ('tm', 'time ''12:00:00''');
+insert into cases values ('tm', 'time ''00:00:00''');
+insert into cases values ('ts', 'timestamp ''2020-01-05 12:00:00''');
+insert into cases values ('ts', 'timestamp ''2020-01-05 12:00:00.5''');
+insert into cases values ('df16', '1.25');
+insert into cases values ('df16', '-3');
+insert into cases values ('df34', '1.25');
+insert into cases values ('df34', '12345678901234567890.25');
+
+set term ^;
+
+create procedure fill (first_id integer, last_id integer)
+as
+	declare k integer;
+begin
+	k = first_id;
+
+	while (k <= last_id) do
+	begin
+		insert into t (id, s, i, b, n, n4, d, dt, tm, ts, df16, df34)
+			values (:k,
+				iif(mod(:k, 7) = 0, null, mod(:k, 20) - 10),
+				iif(mod(:k, 8) = 0, null, mod(:k, 50) - 25),
+				iif(mod(:k, 9) = 0, null, (mod(:k, 10) - 5) * 1000000000 - mod(:k, 3) - 5),
+				iif(mod(:k, 10) = 0, null, (mod(:k, 40) - 20) / 4.00),
+				iif(mod(:k, 11) = 0, null, (mod(:k, 40) - 20) / 8.0000),
+				iif(mod(:k, 12) = 0, null, (mod(:k, 30) - 15) / 2e0),
+				iif(mod(:k, 13) = 0, null, date '2020-01-01' + mod(:k, 30)),
+				iif(mod(:k, 14) = 0, null, time '00:00:00' + mod(:k, 48) * 1800),
+				iif(mod(:k, 15) = 0, null, timestamp '2020-01-01 00:00:00' + mod(:k, 40) / 4.0),
+				iif(mod(:k, 16) = 0, null, cast(mod(:k, 30) - 15 as decfloat(16)) / 4),
+				iif(mod(:k, 17) = 0, null,
+					cast(mod(:k, 30) - 15 as decfloat(34)) / 4 + iif(mod(:k, 5) = 0, 12345678901234567890.25, 0)));
+
+		k = k + 1;
+	end
+end^
+
+-- Compares the filter as written with its row path version,
+-- alone and AND-ed with another comparison on a nullable column
+
+create procedure check_filters (pass varchar(30))
+as
+	declare col varchar(31);
+	declare lit varchar(60);
+	declare op varchar(2);
+	declare fast_filter varchar(300);
+	declare slow_filter varchar(300);
+	declare fast_cnt integer;
+	declare fast_sum bigint;
+	declare slow_cnt integer;
+	declare slow_sum bigint;
+begin
+	for select c.col, c.lit, o.op from cases c cross join ops o into :col, :lit, :op do
+	begin
+		-- field <op> literal
+
+		fast_filter = col || ' ' || op || ' ' || lit;
+		slow_filter = 'coalesce(' || col || ', ' || col || ') ' || op || ' ' || lit;
+
+		execute statement 'select count(*), sum(id) from t where ' || fast_filter
+			into :fast_cnt, :fast_sum;
+		execute statement 'select count(*), sum(id) from t where ' || slow_filter
+			into :slow_cnt, :slow_sum;
+
+		if (fast_cnt <> slow_cnt or fast_sum is distinct from slow_sum) then
+			exception ex_filter_terms pass || ': ' || fast_filter;
+
+		-- literal <op> field
+
+		fast_filter = lit || ' ' || op || ' ' || col;
+		slow_filter = lit || ' ' || op || ' coalesce(' || col || ', ' || col || ')';
+
+		execute statement 'select count(*), sum(id) from t where ' || fast_filter
+			into :fast_cnt, :fast_sum;
+		execute statement 'select count(*), sum(id) from t where ' || slow_filter
+			into :slow_cnt, :slow_sum;
+
+		if (fast_cnt <> slow_cnt or fast_sum is distinct from slow_sum) then
+			exception ex_filter_terms pass || ': ' || fast_filter;
+
+		-- conjunction with a compiled term and a residual one
+
+		fast_filter = col || ' ' || op || ' ' || lit || ' and s > -5 and i + 0 < 20';
+		slow_filter = 'coalesce(' || col || ', ' || col || ') ' || op || ' ' || lit ||
+			' and coalesce(s, s) > -5 and i + 0 < 20';
+
+		execute statement 'select count(*), sum(id) from t where ' || fast_filter
+			into :fast_cnt, :fast_sum;
+		execute statement 'select count(*), sum(id) from t where ' || slow_filter
+			into :slow_cnt, :slow_sum;
+
+		if (fast_cnt <> slow_cnt or fast_sum is distinct from slow_sum) then
+			exception ex_filter_terms pass || ': ' || fast_filter;
+	end
+end^
+
+-- Compiled before the table is altered, so it keeps the old format
+
+create procedure count_old_format
+returns (fast_cnt integer, slow_cnt integer)
+as
+begin
+	select count(*) from t where i < 3 and s >= 0 into :fast_cnt;
+	select count(*) from t where coalesce(i, i) < 3 and coalesce(s, s) >= 0 into :slow_cnt;
+end^
+
+set term ;^
+
+execute procedure fill (1, 1000);
+commit;
+
+execute procedure check_filters ('initial format');
+
+set term ^;
+
+execute block
+as
+	declare fast_cnt integer;
+	declare slow_cnt integer;
+begin
+	execute procedure count_old_format returning_values :fast_cnt, :slow_cnt;
+
+	if (fast_cnt <> slow_cnt) then
+		exception ex_filter_terms 'procedure before ALTER TABLE';
+end^
+
+set term ;^
+
+-- Change the types of the filtered columns. Old records keep the
+-- previous format and must be evaluated through the row path.
+
+alter table t alter s type integer, alter i type bigint, add extra varchar(10);
+commit;
+
+update t set i = i, extra = 'x' where mod(id, 2) = 0;
+execute procedure fill (1001, 1500);
+commit;
+
+execute procedure check_filters ('altered format');
+
+set term ^;
+
+execute block
+as
+	declare fast_cnt integer;
+	declare slow_cnt integer;
+begin
+	execute procedure count_old_format returning_values :fast_cnt, :slow_cnt;
+
+	if (fast_cnt <> slow_cnt) then
+		exception ex_filter_terms 'procedure after ALTER TABLE';
+end^
+
+set term ;^
+
+drop database;
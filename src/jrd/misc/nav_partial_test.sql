@@ -0,0 +1,116 @@
+/*
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+/*
+ * Regression test for partially decompressed records of read-only streams.
+ * A navigational walk rebuilds the index key from each fetched record. When
+ * ORDER BY uses a prefix of a wider index, the remaining segments are not
+ * referenced by the query but must be decompressed anyway, otherwise the
+ * rebuilt key doesn't match the index entry and the row is skipped.
+ *
+ * Run with: isql -q -i nav_partial_test.sql
+ * The script fails with an exception if any query loses rows.
+ */
+
+create database 'nav_partial_test.fdb';
+
+create table t (
+	a integer,
+	b integer,
+	c varchar(200),
+	z integer,
+	w varchar(20)
+);
+
+create index t_bz on t (b, z);
+create descending index t_bz_desc on t (b, z);
+create index t_bw on t computed by (b * 1000 + char_length(w));
+
+create exception ex_nav_partial 'Navigational walk failed';
+
+set term ^;
+
+execute block
+as
+	declare i integer = 0;
+begin
+	while (i < 1000) do
+	begin
+		insert into t (a, b, c, z, w)
+			values (:i, mod(:i, 7), rpad('x', 150, 'y'), 1000 - :i, rpad('w', mod(:i, 13) + 1, 'w'));
+		i = i + 1;
+	end
+end^
+
+commit^
+
+execute block
+as
+	declare total integer;
+	declare cnt integer;
+	declare a integer;
+	declare b integer;
+	declare prev integer;
+begin
+	select count(*) from t into :total;
+
+	-- ascending navigation on the leading segment only
+
+	cnt = 0;
+	prev = null;
+
+	for select a, b from t order by b plan (t order t_bz) into :a, :b do
+	begin
+		if (b < prev) then
+			exception ex_nav_partial 'ORDER BY b (ascending) returned rows out of order';
+
+		prev = b;
+		cnt = cnt + 1;
+	end
+
+	if (cnt <> total) then
+		exception ex_nav_partial 'ORDER BY b (ascending) lost ' || (total - cnt) || ' rows';
+
+	-- descending navigation with a lower bound
+
+	cnt = 0;
+
+	for select a from t where b >= 3 order by b desc plan (t order t_bz_desc) into :a do
+		cnt = cnt + 1;
+
+	if (cnt <> (select count(*) from t where b + 0 >= 3)) then
+		exception ex_nav_partial 'ORDER BY b (descending) lost rows';
+
+	-- navigation over an expression index
+
+	cnt = 0;
+
+	for select a from t order by b * 1000 + char_length(w) plan (t order t_bw) into :a do
+		cnt = cnt + 1;
+
+	if (cnt <> total) then
+		exception ex_nav_partial 'ORDER BY expression lost rows';
+end^
+
+set term ;^
+
+drop database;
@@ -0,0 +1,191 @@
+/*
+ *	PROGRAM:		JRD Access Method
+ *	MODULE:			sqz_test.cpp
+ *	DESCRIPTION:	Tests for LZ record compression
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ *
+ */
+
+#include "firebird.h"
+#include "../common/classes/alloc.h"
+#include "../jrd/sqz.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+void ERR_bugcheck(int, const TEXT*, int)
+{
+	throw Firebird::LongJump();
+}
+
+using namespace Firebird;
+using namespace Jrd;
+
+// Pack the data, unpack it back, compare with the original
+// and return the packed length (zero if it wasn't packed)
+static FB_SIZE_T roundTrip(MemoryPool& pool, const UCHAR* data, FB_SIZE_T length,
+	FB_SIZE_T limit = MAX_USHORT * 2)
+{
+	LzCompressor lz(pool, length, data, limit);
+	const FB_SIZE_T packedLength = lz.getPackedLength();
+
+	if (!packedLength)
+		return 0;
+
+	assert(packedLength < limit);
+
+	UCHAR* const packed = FB_NEW_POOL(pool) UCHAR[packedLength];
+	lz.pack(packed);
+
+	assert(LzCompressor::getUnpackedLength(packedLength, packed) == length);
+
+	UCHAR* const unpacked = FB_NEW_POOL(pool) UCHAR[length + 1];
+	const UCHAR* const end = LzCompressor::unpack(packedLength, packed, length + 1, unpacked);
+	assert(end == unpacked + length);
+	assert(!memcmp(unpacked, data, length));
+
+	// Every prefix is unpacked exactly
+	for (FB_SIZE_T prefix = 0; prefix <= length; prefix += (length < 300 ? 1 : 997))
+	{
+		memset(unpacked, 0xAA, length + 1);
+		const UCHAR* const prefixEnd =
+			LzCompressor::unpackPrefix(packedLength, packed, prefix, unpacked);
+		assert(prefixEnd == unpacked + prefix);
+		assert(!memcmp(unpacked, data, prefix));
+		assert(unpacked[prefix] == 0xAA);
+	}
+
+	// Output buffer shorter than the record is not overrun
+	if (length)
+	{
+		bool failed = false;
+		try
+		{
+			LzCompressor::unpack(packedLength, packed, length - 1, unpacked);
+		}
+		catch (const LongJump&)
+		{
+			failed = true;
+		}
+		assert(failed);
+	}
+
+	// Truncated packed data is detected
+	if (length && packedLength > 3)
+	{
+		bool failed = false;
+		try
+		{
+			LzCompressor::unpack(packedLength - 1, packed, length, unpacked);
+		}
+		catch (const LongJump&)
+		{
+			failed = true;
+		}
+		assert(failed);
+	}
+
+	delete[] unpacked;
+	delete[] packed;
+
+	return packedLength;
+}
+
+static void fillRandom(UCHAR* data, FB_SIZE_T length)
+{
+	for (FB_SIZE_T i = 0; i < length; i++)
+		data[i] = (UCHAR) (rand() >> 7);
+}
+
+int main()
+{
+	MemoryPool& pool = *getDefaultMemoryPool();
+	srand(1);
+
+	UCHAR* const data = FB_NEW_POOL(pool) UCHAR[MAX_USHORT + 1];
+
+	// Empty record
+	assert(roundTrip(pool, data, 0) == 3);
+
+	// Limit not exceeding the header gives up at once
+	memset(data, 'a', 100);
+	assert(roundTrip(pool, data, 100, 2) == 0);
+
+	// Incompressible data can't be packed shorter than itself,
+	// but round trips (long literal run) when the limit allows
+	fillRandom(data, 1000);
+	assert(roundTrip(pool, data, 1000, 1000) == 0);
+	assert(roundTrip(pool, data, 1000) > 1000);
+
+	// Literal runs around the length extension boundaries
+	const FB_SIZE_T literals[] = {1, 3, 4, 14, 15, 16, 269, 270, 271, 524, 525, 526};
+	for (unsigned i = 0; i < FB_NELEM(literals); i++)
+	{
+		fillRandom(data, literals[i]);
+		assert(roundTrip(pool, data, literals[i]));
+	}
+
+	// Matches of the minimal length and around the length extension boundaries,
+	// each one preceded by a literal and reaching the end of the record
+	const FB_SIZE_T matches[] = {4, 5, 18, 19, 20, 273, 274, 275, 528, 529, 530};
+	for (unsigned i = 0; i < FB_NELEM(matches); i++)
+	{
+		fillRandom(data, 8);
+		for (FB_SIZE_T j = 0; j < matches[i]; j++)
+			data[8 + j] = data[j % 8];
+		assert(roundTrip(pool, data, 8 + matches[i]));
+	}
+
+	// Match followed by a single literal, too short to look for matches
+	memcpy(data, "abcdabcdX", 9);
+	assert(roundTrip(pool, data, 9));
+
+	// Three equal bytes are not a match
+	memcpy(data, "abcabcXYZ", 9);
+	assert(roundTrip(pool, data, 9));
+
+	// Overlapping match (offset 1)
+	memset(data, 'z', 1000);
+	assert(roundTrip(pool, data, 1000) < 20);
+
+	// Repeated fragments separated by random gaps
+	fillRandom(data, 32);
+	for (FB_SIZE_T i = 32; i < 5000; i++)
+		data[i] = (i % 100 < 60) ? data[i % 32] : (UCHAR) rand();
+	assert(roundTrip(pool, data, 5000) < 5000);
+
+	// Maximum record length, distant matches near the maximum offset
+	fillRandom(data, MAX_USHORT);
+	memcpy(data + MAX_USHORT - 64, data + 2, 64);
+	assert(roundTrip(pool, data, MAX_USHORT));
+
+	memset(data, 'q', MAX_USHORT);
+	assert(roundTrip(pool, data, MAX_USHORT) < 300);
+
+	// Records longer than the length field are not packed
+	assert(roundTrip(pool, data, MAX_USHORT + 1) == 0);
+
+	delete[] data;
+
+	return 0;
+}
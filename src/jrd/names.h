@@ -416,3 +416,9 @@ NAME("MON$STATEMENT_TIMER", nam_stmt_timer)
 
 NAME("MON$CONNECTION_COMPRESSED", nam_conn_compressed)
 NAME("MON$CONNECTION_ENCRYPTED", nam_conn_encrypted)
+NAME("MON$WORK_MEMORY_USED", nam_work_mem_used)
+NAME("MON$WORK_MEMORY_GRANT", nam_work_mem_grant)
+NAME("MON$WORK_MEMORY_SPILLED", nam_work_mem_spilled)
+
+NAME("RDB$HISTOGRAM", nam_histogram)
+NAME("RDB$GENERATOR_CACHE", nam_gen_cache)
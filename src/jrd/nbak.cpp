@@ -71,6 +71,11 @@ IMPLEMENT_TRACE_ROUTINE(nbak_trace, "NBAK")
 using namespace Jrd;
 using namespace Firebird;
 
+// How far merge reads difference file ahead of the page being merged, in pages,
+// and the longest run of difference pages requested from OS at once
+const ULONG MERGE_READ_AHEAD = 1024;
+const ULONG MERGE_READ_RUN = 128;
+
 
 /******************************** NBackupStateLock ******************************/
 
@@ -535,6 +540,14 @@ void BackupManager::endBackup(thread_db* tdbb, bool recover)
 		NBAK_TRACE(("Merge. Alloc table is actualized."));
 		AllocItemTree::Accessor all(alloc_table);
 
+		// Pages are merged in database page order, and difference pages mostly were
+		// allocated in the same order. Let the second accessor run ahead and request
+		// runs of consecutive difference pages from OS, so they are read with large
+		// sequential I/O in background while we are fetching and marking pages.
+		AllocItemTree::Accessor ahead(alloc_table);
+		bool moreAhead = ahead.getFirst();
+		ULONG aheadPages = 0;
+
 		if (all.getFirst())
 		{
 			int n = 0;
@@ -542,6 +555,22 @@ void BackupManager::endBackup(thread_db* tdbb, bool recover)
 				if (--tdbb->tdbb_quantum < 0)
 					JRD_reschedule(tdbb, QUANTUM, true);
 
+				while (moreAhead && aheadPages < MERGE_READ_AHEAD)
+				{
+					const ULONG runStart = ahead.current().diff_page;
+					ULONG runLength = 0;
+
+					do
+					{
+						runLength++;
+						moreAhead = ahead.getNext();
+					} while (moreAhead && runLength < MERGE_READ_RUN &&
+						ahead.current().diff_page == runStart + runLength);
+
+					PIO_prefetch(diff_file, runStart, runLength, database->dbb_page_size);
+					aheadPages += runLength;
+				}
+
 				WIN window2(DB_PAGE_SPACE, all.current().db_page);
 				NBAK_TRACE(("Merge page %d, diff=%d", all.current().db_page, all.current().diff_page));
 				Ods::pag* page = CCH_FETCH(tdbb, &window2, LCK_write, pag_undefined);
@@ -554,6 +583,9 @@ void BackupManager::endBackup(thread_db* tdbb, bool recover)
 				CCH_RELEASE(tdbb, &window2);
 				NBAK_TRACE(("Merge: page %d is released", all.current().db_page));
 
+				if (aheadPages)
+					aheadPages--;
+
 				if (++n == 512)
 				{
 					CCH_flush(tdbb, FLUSH_SYSTEM, 0);
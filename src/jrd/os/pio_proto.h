@@ -49,6 +49,7 @@ void	PIO_header(Jrd::thread_db*, UCHAR*, int);
 USHORT	PIO_init_data(Jrd::thread_db*, Jrd::jrd_file*, Jrd::FbStatusVector*, ULONG, USHORT);
 Jrd::jrd_file*	PIO_open(Jrd::thread_db*, const Firebird::PathName&,
 						 const Firebird::PathName&);
+void	PIO_prefetch(Jrd::jrd_file*, ULONG, ULONG, USHORT);
 bool	PIO_read(Jrd::thread_db*, Jrd::jrd_file*, Jrd::BufferDesc*, Ods::pag*, Jrd::FbStatusVector*);
 
 #ifdef SUPERSERVER_V2
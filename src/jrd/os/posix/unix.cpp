@@ -738,6 +738,42 @@ jrd_file* PIO_open(thread_db* tdbb,
 }
 
 
+void PIO_prefetch(jrd_file* file, ULONG start, ULONG count, USHORT pageSize)
+{
+/**************************************
+ *
+ *	P I O _ p r e f e t c h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Hint the OS that a run of pages is going to be read
+ *	soon, so it may start large sequential reads in the
+ *	background. This is advisory only, errors are ignored.
+ *
+ **************************************/
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+	for (; file && count; file = file->fil_next)
+	{
+		if (start < file->fil_min_page || start > file->fil_max_page || file->fil_desc == -1)
+			continue;
+
+		const ULONG last = MIN(start + count - 1, file->fil_max_page);
+		const ULONG pages = last - start + 1;
+
+		FB_UINT64 offset = start - file->fil_min_page + file->fil_fudge;
+		offset *= pageSize;
+
+		os_utils::posix_fadvise(file->fil_desc, LSEEK_OFFSET_CAST offset,
+			(FB_UINT64) pages * pageSize, POSIX_FADV_WILLNEED);
+
+		start += pages;
+		count -= pages;
+	}
+#endif
+}
+
+
 bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page, FbStatusVector* status_vector)
 {
 /**************************************
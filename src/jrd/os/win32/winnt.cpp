@@ -591,6 +591,22 @@ jrd_file* PIO_open(thread_db* tdbb,
 }
 
 
+void PIO_prefetch(jrd_file*, ULONG, ULONG, USHORT)
+{
+/**************************************
+ *
+ *	P I O _ p r e f e t c h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Read-ahead hint. Nothing to do here, Windows
+ *	cache manager detects sequential reads itself.
+ *
+ **************************************/
+}
+
+
 bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page, FbStatusVector* status_vector)
 {
 /**************************************
@@ -245,6 +245,24 @@ bool BaseAggWinStream<ThisType, NextType>::aggPass(thread_db* tdbb, jrd_req* req
 	return ret;
 }
 
+// Take the current record out of all the aggregates, returns false if some of them can't do it
+template <typename ThisType, typename NextType>
+bool BaseAggWinStream<ThisType, NextType>::aggRetract(thread_db* tdbb, jrd_req* request,
+	const NestValueArray& sourceList) const
+{
+	const NestConst<ValueExprNode>* const sourceEnd = sourceList.end();
+
+	for (const NestConst<ValueExprNode>* source = sourceList.begin(); source != sourceEnd; ++source)
+	{
+		const AggNode* aggNode = nodeAs<AggNode>(*source);
+
+		if (!aggNode || !aggNode->aggRetract(tdbb, request))
+			return false;
+	}
+
+	return true;
+}
+
 template <typename ThisType, typename NextType>
 void BaseAggWinStream<ThisType, NextType>::aggExecute(thread_db* tdbb, jrd_req* request,
 	const NestValueArray& sourceList, const NestValueArray& targetList) const
@@ -24,6 +24,7 @@
 #include "../jrd/jrd.h"
 #include "../jrd/req.h"
 #include "../jrd/rse.h"
+#include "../jrd/ext.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/ext_proto.h"
 #include "../jrd/met_proto.h"
@@ -58,6 +59,12 @@ void ExternalTableScan::open(thread_db* tdbb) const
 
 	EXT_open(dbb, m_relation->rel_file);
 
+	delete impure->irsb_buffer;
+	impure->irsb_buffer = NULL;
+
+	if (m_relation->rel_file->ext_delimiter)
+		impure->irsb_buffer = FB_NEW_POOL(*tdbb->getDefaultPool()) ExternalBuffer(*tdbb->getDefaultPool());
+
 	VIO_record(tdbb, rpb, MET_current(tdbb, m_relation), request->req_pool);
 
 	impure->irsb_position = 0;
@@ -73,7 +80,12 @@ void ExternalTableScan::close(thread_db* tdbb) const
 	Impure* const impure = request->getImpure<Impure>(m_impure);
 
 	if (impure->irsb_flags & irsb_open)
+	{
 		impure->irsb_flags &= ~irsb_open;
+
+		delete impure->irsb_buffer;
+		impure->irsb_buffer = NULL;
+	}
 }
 
 bool ExternalTableScan::getRecord(thread_db* tdbb) const
@@ -91,7 +103,7 @@ bool ExternalTableScan::getRecord(thread_db* tdbb) const
 		return false;
 	}
 
-	if (EXT_get(tdbb, rpb, impure->irsb_position))
+	if (EXT_get(tdbb, rpb, impure->irsb_position, impure->irsb_buffer))
 	{
 		rpb->rpb_number.increment();
 		rpb->rpb_number.setValid(true);
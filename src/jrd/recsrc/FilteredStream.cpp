@@ -21,27 +21,95 @@
 #include "../jrd/jrd.h"
 #include "../jrd/req.h"
 #include "../dsql/BoolNodes.h"
+#include "../dsql/ExprNodes.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/evl_proto.h"
 #include "../jrd/mov_proto.h"
-#include "../jrd/evl_proto.h"
 
 #include "RecordSource.h"
 
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	template <typename T>
+	inline int compareValues(const T value1, const T value2)
+	{
+		if (value1 == value2)
+			return 0;
+
+		return (value1 > value2) ? 1 : -1;
+	}
+
+	inline bool checkComparison(UCHAR blrOp, int comparison)
+	{
+		switch (blrOp)
+		{
+			case blr_eql:
+				return comparison == 0;
+
+			case blr_neq:
+				return comparison != 0;
+
+			case blr_gtr:
+				return comparison > 0;
+
+			case blr_geq:
+				return comparison >= 0;
+
+			case blr_lss:
+				return comparison < 0;
+
+			case blr_leq:
+				return comparison <= 0;
+		}
+
+		fb_assert(false);
+		return false;
+	}
+
+	// Mirror the comparison operator when the operands are swapped
+	UCHAR swapComparison(UCHAR blrOp)
+	{
+		switch (blrOp)
+		{
+			case blr_gtr:
+				return blr_lss;
+
+			case blr_geq:
+				return blr_leq;
+
+			case blr_lss:
+				return blr_gtr;
+
+			case blr_leq:
+				return blr_geq;
+		}
+
+		return blrOp;
+	}
+}
+
+
 // ------------------------------------
 // Data access: predicate driven filter
 // ------------------------------------
 
 FilteredStream::FilteredStream(CompilerScratch* csb, RecordSource* next, BoolExprNode* boolean)
 	: m_next(next), m_boolean(boolean), m_anyBoolean(NULL),
-	  m_ansiAny(false), m_ansiAll(false), m_ansiNot(false)
+	  m_ansiAny(false), m_ansiAll(false), m_ansiNot(false),
+	  m_terms(csb->csb_pool), m_residual(csb->csb_pool)
 {
 	fb_assert(m_next && m_boolean);
 
 	m_impure = CMP_impure(csb, sizeof(Impure));
+
+	compileTerms(JRD_get_thread_data(), csb, boolean);
+
+	// Nothing to gain if no conjunct could be compiled
+	if (m_terms.isEmpty())
+		m_residual.clear();
 }
 
 void FilteredStream::open(thread_db* tdbb) const
@@ -343,7 +411,7 @@ bool FilteredStream::evaluateBoolean(thread_db* tdbb) const
 	bool result = false;
 	while (m_next->getRecord(tdbb))
 	{
-		if (m_boolean->execute(tdbb, request))
+		if (m_terms.hasData() ? evaluateTerms(tdbb, request) : m_boolean->execute(tdbb, request))
 		{
 			result = true;
 			break;
@@ -358,3 +426,268 @@ bool FilteredStream::evaluateBoolean(thread_db* tdbb) const
 
 	return result;
 }
+
+bool FilteredStream::evaluateTerms(thread_db* tdbb, jrd_req* request) const
+{
+	// Evaluate the compiled conjuncts straight from the record buffers, without
+	// building descriptors and going through EVL_expr / MOV_compare for each of them.
+	// The result and the req_null flag follow the rules of a chain of ANDs, so
+	// the caller can't tell this from m_boolean->execute().
+
+	const DecimalStatus decSt = tdbb->getAttachment()->att_dec_status;
+	bool unknown = false;
+
+	for (const FilterTerm* term = m_terms.begin(); term != m_terms.end(); ++term)
+	{
+		const Record* const record = request->req_rpb[term->stream].rpb_record;
+
+		if (!record)
+			return m_boolean->execute(tdbb, request);
+
+		const Format* const format = record->getFormat();
+
+		if (term->fieldId >= format->fmt_count)
+			return m_boolean->execute(tdbb, request);
+
+		const dsc& desc = format->fmt_desc[term->fieldId];
+
+		if (desc.dsc_dtype != term->dtype || desc.dsc_scale != term->scale || !desc.dsc_address)
+			return m_boolean->execute(tdbb, request);
+
+		if (record->isNull(term->fieldId))
+		{
+			unknown = true;
+			continue;
+		}
+
+		const UCHAR* const p = record->getData() + (IPTR) desc.dsc_address;
+		int comparison;
+
+		switch (term->dtype)
+		{
+			case dtype_short:
+				comparison = compareValues(*(SSHORT*) p, term->value.shortValue);
+				break;
+
+			case dtype_long:
+			case dtype_sql_date:
+				comparison = compareValues(*(SLONG*) p, term->value.longValue);
+				break;
+
+			case dtype_sql_time:
+				comparison = compareValues(*(ULONG*) p, (ULONG) term->value.longValue);
+				break;
+
+			case dtype_int64:
+				comparison = compareValues(*(SINT64*) p, term->value.int64Value);
+				break;
+
+			case dtype_double:
+				comparison = compareValues(*(double*) p, term->value.doubleValue);
+				break;
+
+			case dtype_timestamp:
+				comparison = compareValues(((SLONG*) p)[0], term->value.timestampValue.timestamp_date);
+				if (!comparison)
+					comparison = compareValues(((ULONG*) p)[1], term->value.timestampValue.timestamp_time);
+				break;
+
+			case dtype_dec64:
+				comparison = ((Decimal64*) p)->compare(decSt, *(Decimal64*) term->value.decValue);
+				break;
+
+			case dtype_dec128:
+				comparison = ((Decimal128*) p)->compare(decSt, *(Decimal128*) term->value.decValue);
+				break;
+
+			case dtype_dec_fixed:
+				comparison = ((DecimalFixed*) p)->compare(decSt, *(DecimalFixed*) term->value.decValue);
+				break;
+
+			default:
+				fb_assert(false);
+				return m_boolean->execute(tdbb, request);
+		}
+
+		if (!checkComparison(term->blrOp, comparison))
+		{
+			request->req_flags &= ~req_null;
+			return false;
+		}
+	}
+
+	for (const BoolExprNode* const* node = m_residual.begin(); node != m_residual.end(); ++node)
+	{
+		request->req_flags &= ~req_null;
+
+		if (!(*node)->execute(tdbb, request))
+		{
+			if (!(request->req_flags & req_null))
+				return false;
+
+			unknown = true;
+		}
+	}
+
+	request->req_flags &= ~req_null;
+
+	if (unknown)
+	{
+		request->req_flags |= req_null;
+		return false;
+	}
+
+	return true;
+}
+
+void FilteredStream::compileTerms(thread_db* tdbb, CompilerScratch* csb, const BoolExprNode* boolean)
+{
+	const BinaryBoolNode* const andNode = nodeAs<BinaryBoolNode>(boolean);
+
+	if (andNode && andNode->blrOp == blr_and)
+	{
+		compileTerms(tdbb, csb, andNode->arg1);
+		compileTerms(tdbb, csb, andNode->arg2);
+		return;
+	}
+
+	if (!compileTerm(tdbb, csb, boolean))
+		m_residual.add(boolean);
+}
+
+bool FilteredStream::compileTerm(thread_db* tdbb, CompilerScratch* csb, const BoolExprNode* boolean)
+{
+	// Accept <field> <op> <literal> and <literal> <op> <field> where the field
+	// is a numeric or datetime column of a table and the literal is convertible
+	// to the field type without changing the comparison result
+
+	const ComparativeBoolNode* const cmpNode = nodeAs<ComparativeBoolNode>(boolean);
+
+	if (!cmpNode || cmpNode->arg3)
+		return false;
+
+	UCHAR blrOp = cmpNode->blrOp;
+
+	switch (blrOp)
+	{
+		case blr_eql:
+		case blr_neq:
+		case blr_gtr:
+		case blr_geq:
+		case blr_lss:
+		case blr_leq:
+			break;
+
+		default:
+			return false;
+	}
+
+	const FieldNode* field = nodeAs<FieldNode>(cmpNode->arg1);
+	const LiteralNode* literal = nodeAs<LiteralNode>(cmpNode->arg2);
+
+	if (!field || !literal)
+	{
+		field = nodeAs<FieldNode>(cmpNode->arg2);
+		literal = nodeAs<LiteralNode>(cmpNode->arg1);
+		blrOp = swapComparison(blrOp);
+	}
+
+	if (!field || !literal)
+		return false;
+
+	const CompilerScratch::csb_repeat& tail = csb->csb_rpt[field->fieldStream];
+
+	if (!tail.csb_relation || tail.csb_cursor_number.specified)
+		return false;
+
+	const Format* const format = CMP_format(tdbb, csb, field->fieldStream);
+
+	if (!format || field->fieldId >= format->fmt_count)
+		return false;
+
+	const dsc& fieldDesc = format->fmt_desc[field->fieldId];
+	const dsc& literalDesc = literal->litDesc;
+
+	if (!fieldDesc.dsc_address || literalDesc.isNull())
+		return false;
+
+	FilterTerm term;
+	memset(&term, 0, sizeof(term));
+	term.stream = field->fieldStream;
+	term.fieldId = field->fieldId;
+	term.dtype = fieldDesc.dsc_dtype;
+	term.scale = fieldDesc.dsc_scale;
+	term.blrOp = blrOp;
+
+	switch (fieldDesc.dsc_dtype)
+	{
+		case dtype_short:
+		case dtype_long:
+		case dtype_int64:
+			// Exact numerics are compared at the common scale,
+			// so the conversion must be lossless
+			switch (literalDesc.dsc_dtype)
+			{
+				case dtype_short:
+				case dtype_long:
+				case dtype_int64:
+					break;
+
+				default:
+					return false;
+			}
+			break;
+
+		case dtype_double:
+			// Mixed comparisons with a double are done in double precision anyway
+			switch (literalDesc.dsc_dtype)
+			{
+				case dtype_short:
+				case dtype_long:
+				case dtype_int64:
+				case dtype_double:
+					break;
+
+				default:
+					return false;
+			}
+			break;
+
+		case dtype_sql_date:
+		case dtype_sql_time:
+		case dtype_timestamp:
+		case dtype_dec64:
+		case dtype_dec128:
+		case dtype_dec_fixed:
+			if (literalDesc.dsc_dtype != fieldDesc.dsc_dtype ||
+				literalDesc.dsc_scale != fieldDesc.dsc_scale)
+			{
+				return false;
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	dsc valueDesc = fieldDesc;
+	valueDesc.dsc_flags = 0;
+	valueDesc.dsc_address = (UCHAR*) &term.value;
+
+	try
+	{
+		MOV_move(tdbb, const_cast<dsc*>(&literalDesc), &valueDesc);
+
+		if (valueDesc.isExact() && MOV_compare(tdbb, &valueDesc, &literalDesc) != 0)
+			return false;
+	}
+	catch (const Exception&)
+	{
+		// Literal is out of the field range, leave it to the generic code
+		tdbb->tdbb_status_vector->init();
+		return false;
+	}
+
+	m_terms.add(term);
+	return true;
+}
@@ -93,6 +93,7 @@ static const size_t HASH_SIZE = 1009;
 static const size_t COLLISION_PREALLOCATE_SIZE = 32;			// 256 KB
 static const size_t KEYBUF_PREALLOCATE_SIZE = 64 * 1024; 		// 64 KB
 static const size_t KEYBUF_SIZE_LIMIT = 1024 * 1024 * 1024; 	// 1 GB
+static const FB_UINT64 WORK_MEMORY_STEP = 4096;				// items between memory accounting
 
 class HashJoin::HashTable : public PermanentStorage
 {
@@ -266,6 +267,12 @@ public:
 		delete[] m_collisions;
 	}
 
+	// Approximate memory used by the table for the given number of items
+	FB_UINT64 getMemorySize(FB_UINT64 count) const
+	{
+		return m_streamCount * m_tableSize * sizeof(CollisionList*) + count * sizeof(Collision);
+	}
+
 	void put(size_t stream,
 			 ULONG keyLength, const KeyBuffer* keyBuffer,
 			 ULONG offset, ULONG position)
@@ -411,6 +418,18 @@ void HashJoin::open(thread_db* tdbb) const
 	delete[] impure->irsb_leader_buffer;
 	delete[] impure->irsb_record_counts;
 
+	// The hash table cannot be spilled, but its memory is accounted
+	// as work memory of the attachment, so that other operators
+	// (inner streams buffers in particular) spill earlier
+
+	WorkMemory& workMemory = tdbb->getAttachment()->att_work_memory;
+
+	if (impure->irsb_work_memory)
+	{
+		workMemory.release(impure->irsb_work_memory);
+		impure->irsb_work_memory = 0;
+	}
+
 	MemoryPool& pool = *tdbb->getDefaultPool();
 
 	const size_t argCount = m_args.getCount();
@@ -420,6 +439,8 @@ void HashJoin::open(thread_db* tdbb) const
 	impure->irsb_leader_buffer = FB_NEW_POOL(pool) UCHAR[m_leader.totalKeyLength];
 	impure->irsb_record_counts = FB_NEW_POOL(pool) ULONG[argCount];
 
+	FB_UINT64 itemCount = 0;
+
 	for (FB_SIZE_T i = 0; i < argCount; i++)
 	{
 		// Read and cache the inner streams. While doing that,
@@ -443,10 +464,15 @@ void HashJoin::open(thread_db* tdbb) const
 			impure->irsb_hash_table->put(i, m_args[i].totalKeyLength,
 										 impure->irsb_arg_buffer,
 										 offset, counter++);
+
+			if (++itemCount % WORK_MEMORY_STEP == 0)
+				chargeMemory(impure, workMemory, itemCount);
 		}
 
 	}
 
+	chargeMemory(impure, workMemory, itemCount);
+
 	impure->irsb_hash_table->sort();
 
 	m_leader.source->open(tdbb);
@@ -469,6 +495,12 @@ void HashJoin::close(thread_db* tdbb) const
 		delete impure->irsb_arg_buffer;
 		impure->irsb_arg_buffer = NULL;
 
+		if (impure->irsb_work_memory)
+		{
+			tdbb->getAttachment()->att_work_memory.release(impure->irsb_work_memory);
+			impure->irsb_work_memory = 0;
+		}
+
 		delete[] impure->irsb_leader_buffer;
 		impure->irsb_leader_buffer = NULL;
 
@@ -700,3 +732,15 @@ bool HashJoin::fetchRecord(thread_db* tdbb, Impure* impure, FB_SIZE_T stream) co
 		}
 	}
 }
+
+void HashJoin::chargeMemory(Impure* impure, WorkMemory& workMemory, FB_UINT64 itemCount) const
+{
+	const FB_UINT64 size = impure->irsb_arg_buffer->getCapacity() +
+		impure->irsb_hash_table->getMemorySize(itemCount);
+
+	if (size > impure->irsb_work_memory)
+	{
+		workMemory.charge(size - impure->irsb_work_memory);
+		impure->irsb_work_memory = size;
+	}
+}
@@ -49,6 +49,8 @@ namespace Jrd
 	struct win;
 	class BaseBufferedStream;
 	class BufferedStream;
+	class WorkMemory;
+	class ExternalBuffer;
 
 	enum JoinType { INNER_JOIN, OUTER_JOIN, SEMI_JOIN, ANTI_JOIN };
 
@@ -247,6 +249,7 @@ namespace Jrd
 		struct Impure : public RecordSource::Impure
 		{
 			FB_UINT64 irsb_position;
+			ExternalBuffer* irsb_buffer;
 		};
 
 	public:
@@ -488,7 +491,32 @@ namespace Jrd
 		}
 
 	private:
+		// Comparison of a numeric or datetime field with a literal,
+		// evaluated directly against the record buffer
+		struct FilterTerm
+		{
+			StreamType stream;
+			USHORT fieldId;
+			UCHAR dtype;
+			SCHAR scale;
+			UCHAR blrOp;
+
+			union
+			{
+				SSHORT shortValue;
+				SLONG longValue;
+				SINT64 int64Value;
+				double doubleValue;
+				ISC_TIMESTAMP timestampValue;
+				FB_UINT64 decValue[2];	// Decimal64, Decimal128 or DecimalFixed
+			} value;
+		};
+
 		bool evaluateBoolean(thread_db* tdbb) const;
+		bool evaluateTerms(thread_db* tdbb, jrd_req* request) const;
+
+		void compileTerms(thread_db* tdbb, CompilerScratch* csb, const BoolExprNode* boolean);
+		bool compileTerm(thread_db* tdbb, CompilerScratch* csb, const BoolExprNode* boolean);
 
 		NestConst<RecordSource> m_next;
 		NestConst<BoolExprNode> const m_boolean;
@@ -496,6 +524,8 @@ namespace Jrd
 		bool m_ansiAny;
 		bool m_ansiAll;
 		bool m_ansiNot;
+		Firebird::Array<FilterTerm> m_terms;
+		Firebird::Array<const BoolExprNode*> m_residual;
 	};
 
 	class SortedStream : public RecordSource
@@ -707,6 +737,7 @@ namespace Jrd
 		void aggInit(thread_db* tdbb, jrd_req* request, const MapNode* map) const;
 		bool aggPass(thread_db* tdbb, jrd_req* request,
 			const NestValueArray& sourceList, const NestValueArray& targetList) const;
+		bool aggRetract(thread_db* tdbb, jrd_req* request, const NestValueArray& sourceList) const;
 		void aggExecute(thread_db* tdbb, jrd_req* request,
 			const NestValueArray& sourceList, const NestValueArray& targetList) const;
 		void aggFinish(thread_db* tdbb, jrd_req* request, const MapNode* map) const;
@@ -1034,6 +1065,7 @@ namespace Jrd
 			HashTable* irsb_hash_table;
 			UCHAR* irsb_leader_buffer;
 			ULONG* irsb_record_counts;
+			FB_UINT64 irsb_work_memory;
 		};
 
 	public:
@@ -1060,6 +1092,7 @@ namespace Jrd
 		void computeKeys(thread_db* tdbb, jrd_req* request,
 						 const SubStream& sub, UCHAR* buffer) const;
 		bool fetchRecord(thread_db* tdbb, Impure* impure, FB_SIZE_T stream) const;
+		void chargeMemory(Impure* impure, WorkMemory& workMemory, FB_UINT64 itemCount) const;
 
 		SubStream m_leader;
 		Firebird::Array<SubStream> m_args;
@@ -29,12 +29,97 @@
 #include "../jrd/met_proto.h"
 #include "../jrd/mov_proto.h"
 #include "../jrd/vio_proto.h"
+#include "../common/classes/Hash.h"
 
 #include "RecordSource.h"
 
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	// Direct mapped cache of collation keys built while pumping one sort.
+	// Sorts over repeating strings (DISTINCT, GROUP BY, low cardinality
+	// ORDER BY) don't ask the collation to build the same key again.
+	class SortKeyCache
+	{
+	public:
+		explicit SortKeyCache(MemoryPool& pool)
+			: buffer(pool)
+		{
+			memset(slots, 0, sizeof(slots));
+		}
+
+		void makeKey(thread_db* tdbb, ULONG itemNumber, USHORT idxType, const dsc* from, dsc* to,
+			USHORT keyType);
+
+	private:
+		static const FB_SIZE_T SLOTS = 64;
+		static const USHORT MAX_VALUE_LENGTH = 128;
+		static const USHORT MAX_KEY_LENGTH = 512;
+		static const FB_SIZE_T SLOT_SIZE = MAX_VALUE_LENGTH + MAX_KEY_LENGTH;
+
+		struct Slot
+		{
+			bool used;
+			ULONG itemNumber;
+			USHORT valueLength;
+			USHORT keyLength;
+		};
+
+		Slot slots[SLOTS];
+		Array<UCHAR> buffer;
+	};
+
+	void SortKeyCache::makeKey(thread_db* tdbb, ULONG itemNumber, USHORT idxType, const dsc* from, dsc* to,
+		USHORT keyType)
+	{
+		MoveBuffer temp;
+		UCHAR* address;
+		const USHORT ttype = INTL_INDEX_TO_TEXT(idxType);
+		const USHORT length = MOV_make_string2(tdbb, from, ttype, &address, temp);
+
+		dsc text;
+		text.makeText(length, ttype, address);
+
+		if (length > MAX_VALUE_LENGTH)
+		{
+			INTL_string_to_key(tdbb, idxType, &text, to, keyType);
+			return;
+		}
+
+		Slot& slot = slots[(DefaultHash<UCHAR>::hash(address, length, SLOTS) + itemNumber) % SLOTS];
+
+		if (buffer.isEmpty())
+			buffer.getBuffer(SLOTS * SLOT_SIZE);
+
+		UCHAR* const value = buffer.begin() + (&slot - slots) * SLOT_SIZE;
+		UCHAR* const key = value + MAX_VALUE_LENGTH;
+
+		if (slot.used && slot.itemNumber == itemNumber && slot.valueLength == length &&
+			memcmp(value, address, length) == 0)
+		{
+			fb_assert(slot.keyLength <= to->dsc_length);
+			memcpy(to->dsc_address, key, slot.keyLength);
+			return;
+		}
+
+		const USHORT keyLength = INTL_string_to_key(tdbb, idxType, &text, to, keyType);
+
+		if (keyLength <= MAX_KEY_LENGTH)
+		{
+			slot.used = true;
+			slot.itemNumber = itemNumber;
+			slot.valueLength = length;
+			slot.keyLength = keyLength;
+			memcpy(value, address, length);
+			memcpy(key, to->dsc_address, keyLength);
+		}
+		else
+			slot.used = false;
+	}
+}
+
 // -----------------------------
 // Data access: external sorting
 // -----------------------------
@@ -176,6 +261,7 @@ Sort* SortedStream::init(thread_db* tdbb) const
 	// mapping is done in get_sort().
 
 	dsc to, temp;
+	SortKeyCache keyCache(*tdbb->getDefaultPool());
 
 	while (m_next->getRecord(tdbb))
 	{
@@ -247,8 +333,8 @@ Sort* SortedStream::init(thread_db* tdbb) const
 				if (IS_INTL_DATA(&item->desc) &&
 					(ULONG)(IPTR) item->desc.dsc_address < m_map->keyLength)
 				{
-					INTL_string_to_key(tdbb, INTL_INDEX_TYPE(&item->desc), from, &to,
-						(m_map->flags & FLAG_UNIQUE ? INTL_KEY_UNIQUE : INTL_KEY_SORT));
+					keyCache.makeKey(tdbb, item - m_map->items.begin(), INTL_INDEX_TYPE(&item->desc),
+						from, &to, (m_map->flags & FLAG_UNIQUE ? INTL_KEY_UNIQUE : INTL_KEY_SORT));
 				}
 				else
 				{
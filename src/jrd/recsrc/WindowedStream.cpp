@@ -778,9 +778,35 @@ bool WindowedStream::WindowStream::getRecord(thread_db* tdbb) const
 			// This may be incompatible with some function like LIST, but currently LIST cannot
 			// be used in ordered windows anyway.
 
-			if (!lastWindow.isValid() ||
-				impure->windowBlock.startPosition > lastWindow.startPosition ||
-				impure->windowBlock.endPosition < lastWindow.endPosition)
+			bool reuse = lastWindow.isValid() &&
+				impure->windowBlock.endPosition >= lastWindow.endPosition;
+
+			if (reuse && impure->windowBlock.startPosition > lastWindow.startPosition)
+			{
+				// The frame slides: take the records leaving it out of the aggregates, unless
+				// some of them can't do it or the frames don't overlap at all.
+
+				reuse = impure->windowBlock.startPosition <= lastWindow.endPosition + 1;
+
+				if (reuse)
+				{
+					m_next->locate(tdbb, lastWindow.startPosition);
+					SINT64 pending = impure->windowBlock.startPosition - lastWindow.startPosition;
+
+					while (reuse && pending-- > 0)
+					{
+						if (!m_next->getRecord(tdbb))
+							fb_assert(false);
+
+						reuse = aggRetract(tdbb, request, m_aggSources);
+					}
+				}
+
+				if (reuse)
+					lastWindow.startPosition = impure->windowBlock.startPosition;
+			}
+
+			if (!reuse)
 			{
 				aggInit(tdbb, request, m_windowMap);
 				m_next->locate(tdbb, impure->windowBlock.startPosition);
@@ -99,6 +99,7 @@ RELATION(nam_indices, rel_indices, ODS_8_0, rel_persistent)
 	FIELD(f_idx_exp_blr, nam_exp_blr, fld_value, 1, ODS_8_0)
 	FIELD(f_idx_exp_source, nam_exp_source, fld_source, 1, ODS_8_0)
 	FIELD(f_idx_statistics, nam_statistics, fld_statistics, 1, ODS_8_0)
+	FIELD(f_idx_histogram, nam_histogram, fld_histogram, 1, ODS_13_1)
 END_RELATION
 
 // Relation 5 (RDB$RELATION_FIELDS)
@@ -321,6 +322,7 @@ RELATION(nam_gens, rel_gens, ODS_8_0, rel_persistent)
 	FIELD(f_gen_owner, nam_owner, fld_user, 1, ODS_12_0)
 	FIELD(f_gen_init_val, nam_init_val, fld_gen_val, 1, ODS_12_0)
 	FIELD(f_gen_increment, nam_gen_increment, fld_gen_increment, 1, ODS_12_0)
+	FIELD(f_gen_cache, nam_gen_cache, fld_gen_cache, 1, ODS_13_1)
 END_RELATION
 
 // Relation 21 (RDB$FIELD_DIMENSIONS)
@@ -522,6 +524,9 @@ RELATION(nam_mon_attachments, rel_mon_attachments, ODS_11_1, rel_virtual)
 	FIELD(f_mon_att_stmt_timeout, nam_stmt_timeout, fld_stmt_timeout, 0, ODS_13_0)
 	FIELD(f_mon_att_conn_compressed, nam_conn_compressed, fld_bool, 0, ODS_13_0)
 	FIELD(f_mon_att_conn_encrypted, nam_conn_encrypted, fld_bool, 0, ODS_13_0)
+	FIELD(f_mon_att_work_mem_used, nam_work_mem_used, fld_counter, 0, ODS_13_1)
+	FIELD(f_mon_att_work_mem_grant, nam_work_mem_grant, fld_counter, 0, ODS_13_1)
+	FIELD(f_mon_att_work_mem_spilled, nam_work_mem_spilled, fld_counter, 0, ODS_13_1)
 END_RELATION
 
 // Relation 35 (MON$TRANSACTIONS)
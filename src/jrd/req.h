@@ -50,6 +50,7 @@ class jrd_tra;
 class Savepoint;
 class Cursor;
 class thread_db;
+class DeferredIndexKeys;
 
 // record parameter block
 
@@ -63,7 +64,7 @@ struct record_param
 		  rpb_b_page(0), rpb_b_line(0),
 		  rpb_address(NULL), rpb_length(0),
 		  rpb_flags(0), rpb_stream_flags(0), rpb_runtime_flags(0),
-		  rpb_org_scans(0), rpb_window(DB_PAGE_SPACE, -1)
+		  rpb_org_scans(0), rpb_last_field(0), rpb_window(DB_PAGE_SPACE, -1)
 	{
 	}
 
@@ -90,6 +91,7 @@ struct record_param
 	USHORT rpb_stream_flags;		// stream flags
 	USHORT rpb_runtime_flags;		// runtime flags
 	SSHORT rpb_org_scans;			// relation scan count at stream open
+	USHORT rpb_last_field;			// highest field id referenced by the stream
 
 	inline WIN& getWindow(thread_db* tdbb)
 	{
@@ -117,12 +119,14 @@ const USHORT rpb_damaged		= 128;		// record is busted
 const USHORT rpb_gc_active		= 256;		// garbage collecting dead record version
 const USHORT rpb_uk_modified	= 512;		// record key field values are changed
 const USHORT rpb_long_tranum	= 1024;		// transaction number is 64-bit
+const USHORT rpb_lz				= 2048;		// record data is LZ packed
 
 // Stream flags
 
 const USHORT RPB_s_update	= 0x01;	// input stream fetched for update
 const USHORT RPB_s_no_data	= 0x02;	// nobody is going to access the data
 const USHORT RPB_s_sweeper	= 0x04;	// garbage collector - skip swept pages
+const USHORT RPB_s_partial	= 0x08;	// only fields up to rpb_last_field are accessed
 
 // Runtime flags
 
@@ -180,7 +184,8 @@ public:
 		  req_auto_trans(*req_pool),
 		  req_sorts(*req_pool),
 		  req_rpb(*req_pool),
-		  impureArea(*req_pool)
+		  impureArea(*req_pool),
+		  req_index_keys(NULL)
 	{
 		fb_assert(statement);
 		setAttachment(attachment);
@@ -285,6 +290,7 @@ public:
 
 	StatusXcp req_last_xcp;			// last known exception
 	bool req_batch;
+	DeferredIndexKeys* req_index_keys;	// keys of non-checking indices deferred by the batch
 
 	template <typename T> T* getImpure(unsigned offset)
 	{
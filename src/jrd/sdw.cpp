@@ -517,6 +517,9 @@ void SDW_dump_pages(thread_db* tdbb)
 
 				Pio cryptIo(shadow, window.win_bdb);
 
+				// page number may be used by crypt plugin, make sure it's correct
+				window.win_bdb->bdb_buffer->pag_pageno = window.win_bdb->bdb_page.getPageNum();
+
 				if (!dbb->dbb_crypto_manager->write(tdbb, tdbb->tdbb_status_vector,
 						window.win_bdb->bdb_buffer, &cryptIo))
 				{
@@ -165,7 +165,7 @@ Sort::Sort(Database* dbb,
 		   FPTR_REJECT_DUP_CALLBACK call_back,
 		   void* user_arg,
 		   FB_UINT64 max_records)
-	: m_dbb(dbb), m_last_record(NULL), m_next_pointer(NULL), m_records(0),
+	: m_dbb(dbb), m_work_memory(WorkMemory::getCurrent()), m_last_record(NULL), m_next_pointer(NULL), m_records(0),
 	  m_runs(NULL), m_merge(NULL), m_free_runs(NULL),
 	  m_flags(0), m_merge_pool(NULL),
 	  m_description(owner->getPool(), keys)
@@ -630,14 +630,34 @@ void Sort::sort(thread_db* tdbb)
 
 void Sort::allocateBuffer(MemoryPool& pool)
 {
-	if (m_dbb->dbb_sort_buffers.hasData() && m_max_alloc_size <= MAX_SORT_BUFFER_SIZE)
+	// If the attachment is short of work memory, make do with a smaller
+	// buffer (i.e. shorter runs). The smallest one is taken anyway.
+
+	m_size_memory = m_max_alloc_size;
+
+	if (m_work_memory)
+	{
+		while (!m_work_memory->acquire(m_size_memory))
+		{
+			if (m_size_memory / 2 < m_min_alloc_size)
+			{
+				m_work_memory->charge(m_size_memory);
+				break;
+			}
+
+			m_size_memory /= 2;
+		}
+	}
+
+	const ULONG granted = m_size_memory;
+
+	if (m_dbb->dbb_sort_buffers.hasData() && m_size_memory == MAX_SORT_BUFFER_SIZE)
 	{
 		SyncLockGuard guard(&m_dbb->dbb_sortbuf_sync, SYNC_EXCLUSIVE, "Sort::allocateBuffer");
 
 		if (m_dbb->dbb_sort_buffers.hasData())
 		{
 			// The sort buffer cache has at least one big block, let's use it
-			m_size_memory = MAX_SORT_BUFFER_SIZE;
 			m_memory = m_dbb->dbb_sort_buffers.pop();
 			return;
 		}
@@ -653,28 +673,40 @@ void Sort::allocateBuffer(MemoryPool& pool)
 
 	try
 	{
-		m_size_memory = m_max_alloc_size;
-		m_memory = FB_NEW_POOL(*m_dbb->dbb_permanent) UCHAR[m_size_memory];
-	}
-	catch (const BadAlloc&)
-	{
-		// not enough memory, retry with a smaller buffer
-
-		while (true)
+		try
 		{
-			try
-			{
-				m_size_memory /= 2;
-				m_memory = FB_NEW_POOL(pool) UCHAR[m_size_memory];
-				break;
-			}
-			catch (const BadAlloc&)
+			m_memory = FB_NEW_POOL(*m_dbb->dbb_permanent) UCHAR[m_size_memory];
+		}
+		catch (const BadAlloc&)
+		{
+			// not enough memory, retry with a smaller buffer
+
+			while (true)
 			{
-				if (m_size_memory <= m_min_alloc_size)
-					throw;
+				try
+				{
+					m_size_memory /= 2;
+					m_memory = FB_NEW_POOL(pool) UCHAR[m_size_memory];
+					break;
+				}
+				catch (const BadAlloc&)
+				{
+					if (m_size_memory <= m_min_alloc_size)
+						throw;
+				}
 			}
 		}
 	}
+	catch (const BadAlloc&)
+	{
+		if (m_work_memory)
+			m_work_memory->release(granted);
+
+		throw;
+	}
+
+	if (m_work_memory && m_size_memory < granted)
+		m_work_memory->release(granted - m_size_memory);
 }
 
 
@@ -684,6 +716,9 @@ void Sort::releaseBuffer()
 
 	const size_t MAX_CACHED_SORT_BUFFERS = 8; // 1MB
 
+	if (m_work_memory)
+		m_work_memory->release(m_size_memory);
+
 	SyncLockGuard guard(&m_dbb->dbb_sortbuf_sync, SYNC_EXCLUSIVE, "Sort::releaseBuffer");
 
 	if (m_size_memory == MAX_SORT_BUFFER_SIZE &&
@@ -1417,6 +1452,9 @@ ULONG Sort::allocate(ULONG n, ULONG chunkSize, bool useFreeSpace)
 
 		if (mem)
 		{
+			// the run is merged right from the cache, keep it there
+			m_space->keepMemory();
+
 			run->run_buffer = mem;
 			run->run_record = reinterpret_cast<sort_record*>(mem);
 			run->run_end_buffer = run->run_buffer + run->run_size;
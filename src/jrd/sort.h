@@ -32,6 +32,7 @@ namespace Jrd {
 // Forward declaration
 class Attachment;
 class SortOwner;
+class WorkMemory;
 struct merge_control;
 
 // SORTP is used throughout sort.c as a pointer into arrays of
@@ -295,6 +296,7 @@ private:
 	static void quick(SLONG, SORTP**, ULONG);
 
 	Database* m_dbb;							// Database
+	WorkMemory* const m_work_memory;			// Work memory of the attachment
 	SortOwner* m_owner;							// Sort owner
 	UCHAR* m_memory;							// ALLOC: Memory for sort
 	UCHAR* m_end_memory;						// End of memory
@@ -27,8 +27,135 @@
 #include "../jrd/req.h"
 #include "../jrd/err_proto.h"
 #include "../yvalve/gds_proto.h"
+#include "../common/classes/CpuFeatures.h"
 
 using namespace Jrd;
+using namespace Firebird;
+
+namespace
+{
+	// Both functions return the position where the current run stops:
+	// findRun - first byte starting the run of at least three equal bytes (or end),
+	// skipRepeats - first byte that differs from the *data (or end)
+
+	typedef const UCHAR* (*scan_func_t)(const UCHAR* data, const UCHAR* end);
+
+	const UCHAR* findRunBasic(const UCHAR* data, const UCHAR* end)
+	{
+		for (; end - data > 2; data++)
+		{
+			if (data[0] == data[1] && data[0] == data[2])
+				return data;
+		}
+
+		return end;
+	}
+
+	const UCHAR* skipRepeatsBasic(const UCHAR* data, const UCHAR* end)
+	{
+		const UCHAR c = *data;
+
+		while (++data < end && *data == c)
+			;
+
+		return data;
+	}
+
+#ifdef FB_CPU_SSE2
+
+	const UCHAR* findRunSSE2(const UCHAR* data, const UCHAR* end)
+	{
+		while (end - data >= 18)
+		{
+			const __m128i v0 = _mm_loadu_si128((const __m128i*) data);
+			const __m128i v1 = _mm_loadu_si128((const __m128i*) (data + 1));
+			const __m128i v2 = _mm_loadu_si128((const __m128i*) (data + 2));
+			const unsigned mask = _mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(v0, v1), _mm_cmpeq_epi8(v0, v2)));
+
+			if (mask)
+				return data + lowestBit(mask);
+
+			data += 16;
+		}
+
+		return findRunBasic(data, end);
+	}
+
+	const UCHAR* skipRepeatsSSE2(const UCHAR* data, const UCHAR* end)
+	{
+		const __m128i c = _mm_set1_epi8((char) *data);
+		const UCHAR* p = data + 1;
+
+		while (end - p >= 16)
+		{
+			const unsigned mask = ~_mm_movemask_epi8(
+				_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) p), c)) & 0xFFFF;
+
+			if (mask)
+				return p + lowestBit(mask);
+
+			p += 16;
+		}
+
+		while (p < end && *p == *data)
+			p++;
+
+		return p;
+	}
+
+	FB_TARGET_AVX2 const UCHAR* findRunAVX2(const UCHAR* data, const UCHAR* end)
+	{
+		while (end - data >= 34)
+		{
+			const __m256i v0 = _mm256_loadu_si256((const __m256i*) data);
+			const __m256i v1 = _mm256_loadu_si256((const __m256i*) (data + 1));
+			const __m256i v2 = _mm256_loadu_si256((const __m256i*) (data + 2));
+			const unsigned mask = (unsigned) _mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(v0, v1), _mm256_cmpeq_epi8(v0, v2)));
+
+			if (mask)
+				return data + lowestBit(mask);
+
+			data += 32;
+		}
+
+		return findRunSSE2(data, end);
+	}
+
+	FB_TARGET_AVX2 const UCHAR* skipRepeatsAVX2(const UCHAR* data, const UCHAR* end)
+	{
+		const __m256i c = _mm256_set1_epi8((char) *data);
+		const UCHAR* p = data + 1;
+
+		while (end - p >= 32)
+		{
+			const unsigned mask = ~(unsigned) _mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) p), c));
+
+			if (mask)
+				return p + lowestBit(mask);
+
+			p += 32;
+		}
+
+		while (p < end && *p == *data)
+			p++;
+
+		return p;
+	}
+
+	const bool useAVX2 = cpuSupportsAVX2();
+	scan_func_t findRun = useAVX2 ? findRunAVX2 : findRunSSE2;
+	scan_func_t skipRepeats = useAVX2 ? skipRepeatsAVX2 : skipRepeatsSSE2;
+
+#else	// FB_CPU_SSE2
+
+	scan_func_t findRun = findRunBasic;
+	scan_func_t skipRepeats = skipRepeatsBasic;
+
+#endif	// FB_CPU_SSE2
+} // namespace
 
 
 Compressor::Compressor(MemoryPool& pool, FB_SIZE_T length, const UCHAR* data)
@@ -41,26 +168,11 @@ Compressor::Compressor(MemoryPool& pool, FB_SIZE_T length, const UCHAR* data)
 	FB_SIZE_T max;
 	while ( (count = end - data) )
 	{
-		const UCHAR* start = data;
-
 		// Find length of non-compressable run
 
-		if ((max = count - 1) > 1)
-		{
-			do {
-				if (data[0] != data[1] || data[0] != data[2])
-				{
-					data++;
-				}
-				else
-				{
-					count = data - start;
-					break;
-				}
-			} while (--max > 1);
-		}
-
-		data = start + count;
+		const UCHAR* start = data;
+		data = findRun(data, end);
+		count = data - start;
 
 		// Non-compressable runs are limited to 127 bytes
 
@@ -77,15 +189,7 @@ Compressor::Compressor(MemoryPool& pool, FB_SIZE_T length, const UCHAR* data)
 		if ((max = MIN(128, end - data)) >= 3)
 		{
 			start = data;
-			const UCHAR c = *data;
-			do
-			{
-				if (*data != c)
-				{
-					break;
-				}
-				++data;
-			} while (--max);
+			data = skipRepeats(data, data + max);
 
 			*control++ = (UCHAR) (start - data);
 			m_length += 2;
@@ -283,7 +387,14 @@ UCHAR* Compressor::unpack(FB_SIZE_T inLength,
 			}
 
 			const UCHAR c = *input++;
-			memset(output, c, (-1 * len));
+#ifdef FB_CPU_SSE2
+			// Short runs are expanded with single store, bytes past the run
+			// are overwritten by the next ones or left in unused buffer space
+			if (len >= -16 && output_end - output >= 16)
+				_mm_storeu_si128((__m128i*) output, _mm_set1_epi8((char) c));
+			else
+#endif
+				memset(output, c, (-1 * len));
 			output -= len;
 		}
 		else
@@ -292,7 +403,12 @@ UCHAR* Compressor::unpack(FB_SIZE_T inLength,
 			{
 				BUGCHECK(179);	// msg 179 decompression overran buffer
 			}
-			memcpy(output, input, len);
+#ifdef FB_CPU_SSE2
+			if (len <= 16 && output_end - output >= 16 && end - input >= 16)
+				_mm_storeu_si128((__m128i*) output, _mm_loadu_si128((const __m128i*) input));
+			else
+#endif
+				memcpy(output, input, len);
 			output += len;
 			input += len;
 		}
@@ -306,6 +422,53 @@ UCHAR* Compressor::unpack(FB_SIZE_T inLength,
 	return output;
 }
 
+UCHAR* Compressor::unpackPrefix(FB_SIZE_T inLength,
+								const UCHAR* input,
+								FB_SIZE_T outLength,
+								UCHAR* output)
+{
+/**************************************
+ *
+ *	Decompress the leading part of a compressed string,
+ *	stopping as soon as outLength bytes are produced.
+ *	Return the address where the output stopped.
+ *
+ **************************************/
+	const UCHAR* const end = input + inLength;
+	const UCHAR* const output_end = output + outLength;
+
+	while (input < end && output < output_end)
+	{
+		const int len = (signed char) *input++;
+
+		if (len < 0)
+		{
+			if (input >= end)
+			{
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+			}
+
+			const FB_SIZE_T count = MIN((FB_SIZE_T) -len, (FB_SIZE_T) (output_end - output));
+			memset(output, *input++, count);
+			output += count;
+		}
+		else
+		{
+			if (input + len > end)
+			{
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+			}
+
+			const FB_SIZE_T count = MIN((FB_SIZE_T) len, (FB_SIZE_T) (output_end - output));
+			memcpy(output, input, count);
+			output += count;
+			input += len;
+		}
+	}
+
+	return output;
+}
+
 FB_SIZE_T Compressor::makeNoDiff(FB_SIZE_T outLength, UCHAR* output)
 {
 /**************************************
@@ -459,3 +622,335 @@ void Compressor::pack(const UCHAR* input, UCHAR* output) const
 		}
 	}
 }
+
+
+// LZ record encoding
+
+namespace
+{
+	const FB_SIZE_T LZ_MIN_MATCH = 4;			// shorter matches are stored as literals
+	const FB_SIZE_T LZ_MAX_OFFSET = MAX_USHORT;	// back references fit into two bytes
+	const FB_SIZE_T LZ_HEADER = 2;				// unpacked length
+	const int LZ_HASH_BITS = 12;
+
+	inline ULONG lzHash(const UCHAR* p)
+	{
+		const ULONG value = p[0] | (p[1] << 8) | (p[2] << 16) | ((ULONG) p[3] << 24);
+		return (value * 2654435761U) >> (32 - LZ_HASH_BITS);
+	}
+
+	UCHAR* lzPutLength(UCHAR* output, FB_SIZE_T length)
+	{
+		for (; length >= 255; length -= 255)
+			*output++ = 255;
+
+		*output++ = (UCHAR) length;
+		return output;
+	}
+
+	// Store literals followed by the back reference, the last sequence has
+	// no reference (matchLength is zero). Returns NULL when output doesn't fit.
+
+	UCHAR* lzPutSequence(UCHAR* output, const UCHAR* const outEnd,
+						 const UCHAR* literals, FB_SIZE_T litLength,
+						 FB_SIZE_T offset, FB_SIZE_T matchLength)
+	{
+		const FB_SIZE_T needed = 1 + litLength + (litLength / 255 + 1) +
+			(matchLength ? 2 + (matchLength / 255 + 1) : 0);
+
+		if (output + needed > outEnd)
+			return NULL;
+
+		const FB_SIZE_T matchCode = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+
+		UCHAR* const token = output++;
+		*token = (UCHAR) ((MIN(litLength, 15) << 4) | MIN(matchCode, 15));
+
+		if (litLength >= 15)
+			output = lzPutLength(output, litLength - 15);
+
+		memcpy(output, literals, litLength);
+		output += litLength;
+
+		if (matchLength)
+		{
+			*output++ = (UCHAR) offset;
+			*output++ = (UCHAR) (offset >> 8);
+
+			if (matchCode >= 15)
+				output = lzPutLength(output, matchCode - 15);
+		}
+
+		return output;
+	}
+
+	const UCHAR* lzGetLength(const UCHAR* input, const UCHAR* const end, FB_SIZE_T& length)
+	{
+		UCHAR c;
+
+		do
+		{
+			if (input >= end)
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+
+			c = *input++;
+			length += c;
+		} while (c == 255);
+
+		return input;
+	}
+} // namespace
+
+
+LzCompressor::LzCompressor(MemoryPool& pool, FB_SIZE_T length, const UCHAR* data, FB_SIZE_T limit)
+	: m_data(pool)
+{
+/**************************************
+ *
+ *	Pack the record using LZ77 with a hash table of the
+ *	recently seen 4-byte sequences. Give up as soon as the
+ *	result is going to be not shorter than limit.
+ *
+ **************************************/
+	if (limit <= LZ_HEADER || length > MAX_USHORT)
+		return;
+
+	UCHAR* const buffer = m_data.getBuffer(limit, false);
+	const UCHAR* const outEnd = buffer + limit - 1;
+	UCHAR* output = buffer;
+
+	*output++ = (UCHAR) length;
+	*output++ = (UCHAR) (length >> 8);
+
+	// Positions are stored incremented by one, zero means empty slot
+	USHORT table[1 << LZ_HASH_BITS];
+	memset(table, 0, sizeof(table));
+
+	const UCHAR* const end = data + length;
+	const UCHAR* anchor = data;
+	const UCHAR* p = data;
+
+	while (p + LZ_MIN_MATCH <= end)
+	{
+		const ULONG hash = lzHash(p);
+		const FB_SIZE_T pos = p - data;
+		const FB_SIZE_T candidate = table[hash];
+		table[hash] = (USHORT) (pos + 1);
+
+		if (candidate && pos - (candidate - 1) <= LZ_MAX_OFFSET)
+		{
+			const UCHAR* ref = data + candidate - 1;
+
+			if (!memcmp(ref, p, LZ_MIN_MATCH))
+			{
+				FB_SIZE_T matchLength = LZ_MIN_MATCH;
+				while (p + matchLength < end && ref[matchLength] == p[matchLength])
+					matchLength++;
+
+				output = lzPutSequence(output, outEnd, anchor, p - anchor, p - ref, matchLength);
+				if (!output)
+				{
+					m_data.shrink(0);
+					return;
+				}
+
+				p += matchLength;
+				anchor = p;
+
+				// Let the tail of the match to be referenced later
+				if (p + LZ_MIN_MATCH <= end)
+					table[lzHash(p - 2)] = (USHORT) (p - 2 - data + 1);
+
+				continue;
+			}
+		}
+
+		p++;
+	}
+
+	if (anchor < end || output == buffer + LZ_HEADER)
+		output = lzPutSequence(output, outEnd, anchor, end - anchor, 0, 0);
+
+	if (!output)
+	{
+		m_data.shrink(0);
+		return;
+	}
+
+	m_data.shrink(output - buffer);
+}
+
+UCHAR* LzCompressor::unpack(FB_SIZE_T inLength,
+							const UCHAR* input,
+							FB_SIZE_T outLength,
+							UCHAR* output)
+{
+/**************************************
+ *
+ *	Decompress LZ packed record into a buffer.
+ *	Return the address where the output stopped.
+ *
+ **************************************/
+	const FB_SIZE_T length = getUnpackedLength(inLength, input);
+
+	if (inLength < LZ_HEADER || length > outLength)
+	{
+		BUGCHECK(179);	// msg 179 decompression overran buffer
+	}
+
+	return decode(inLength, input, length, length, output);
+}
+
+UCHAR* LzCompressor::unpackPrefix(FB_SIZE_T inLength,
+								  const UCHAR* input,
+								  FB_SIZE_T outLength,
+								  UCHAR* output)
+{
+/**************************************
+ *
+ *	Decompress the leading outLength bytes of LZ packed record.
+ *	Return the address where the output stopped.
+ *
+ **************************************/
+	const FB_SIZE_T length = getUnpackedLength(inLength, input);
+
+	if (inLength < LZ_HEADER)
+	{
+		BUGCHECK(179);	// msg 179 decompression overran buffer
+	}
+
+	return decode(inLength, input, length, MIN(length, outLength), output);
+}
+
+UCHAR* LzCompressor::decode(FB_SIZE_T inLength,
+							const UCHAR* input,
+							FB_SIZE_T length,
+							FB_SIZE_T limit,
+							UCHAR* output)
+{
+/**************************************
+ *
+ *	Decode LZ sequences of the record of given length,
+ *	stopping when limit bytes are produced.
+ *
+ **************************************/
+	const UCHAR* const end = input + inLength;
+	UCHAR* const start = output;
+	const UCHAR* const data_end = output + length;
+	UCHAR* const output_end = output + limit;
+	input += LZ_HEADER;
+
+	// Data may be padded with zeroes, so stop as soon as the record is complete
+
+	while (input < end && output < output_end)
+	{
+		const UCHAR token = *input++;
+
+		FB_SIZE_T litLength = token >> 4;
+		if (litLength == 15)
+			input = lzGetLength(input, end, litLength);
+
+		if (input + litLength > end || output + litLength > data_end)
+		{
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+		}
+
+		const FB_SIZE_T litCount = MIN(litLength, (FB_SIZE_T) (output_end - output));
+		memcpy(output, input, litCount);
+		output += litCount;
+		input += litLength;
+
+		if (input >= end || output == output_end)
+			break;
+
+		if (input + 2 > end)
+		{
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+		}
+
+		const FB_SIZE_T offset = input[0] | (input[1] << 8);
+		input += 2;
+
+		FB_SIZE_T matchLength = token & 15;
+		if (matchLength == 15)
+			input = lzGetLength(input, end, matchLength);
+		matchLength += LZ_MIN_MATCH;
+
+		if (!offset || offset > (FB_SIZE_T) (output - start) || output + matchLength > data_end)
+		{
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+		}
+
+		matchLength = MIN(matchLength, (FB_SIZE_T) (output_end - output));
+
+		// Source and destination may overlap, copy byte by byte then
+		const UCHAR* ref = output - offset;
+
+		if (offset >= matchLength)
+		{
+			memcpy(output, ref, matchLength);
+			output += matchLength;
+		}
+		else
+		{
+			while (matchLength--)
+				*output++ = *ref++;
+		}
+	}
+
+	if (output != output_end)
+	{
+		BUGCHECK(179);	// msg 179 decompression overran buffer
+	}
+
+	return output;
+}
+
+FB_SIZE_T LzCompressor::getUnpackedLength(FB_SIZE_T inLength, const UCHAR* input)
+{
+/**************************************
+ *
+ *	Return length of the record, stored ahead of LZ packed data.
+ *
+ **************************************/
+	if (inLength < LZ_HEADER)
+		return 0;
+
+	return input[0] | (input[1] << 8);
+}
+
+UCHAR* Jrd::unpackRecord(USHORT flags,
+						 FB_SIZE_T inLength,
+						 const UCHAR* input,
+						 FB_SIZE_T outLength,
+						 UCHAR* output)
+{
+/**************************************
+ *
+ *	Decompress the record data using the codec
+ *	it was packed with.
+ *
+ **************************************/
+	if (flags & rpb_lz)
+		return LzCompressor::unpack(inLength, input, outLength, output);
+
+	return Compressor::unpack(inLength, input, outLength, output);
+}
+
+UCHAR* Jrd::unpackRecordPrefix(USHORT flags,
+							   FB_SIZE_T inLength,
+							   const UCHAR* input,
+							   FB_SIZE_T outLength,
+							   UCHAR* output)
+{
+/**************************************
+ *
+ *	Decompress the leading outLength bytes
+ *	of the record data.
+ *
+ **************************************/
+	if (flags & rpb_lz)
+		return LzCompressor::unpackPrefix(inLength, input, outLength, output);
+
+	return Compressor::unpackPrefix(inLength, input, outLength, output);
+}
@@ -54,6 +54,7 @@ namespace Jrd
 		FB_SIZE_T getPartialLength(FB_SIZE_T, const UCHAR*) const;
 
 		static UCHAR* unpack(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
+		static UCHAR* unpackPrefix(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
 		static FB_SIZE_T applyDiff(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR* const);
 		static FB_SIZE_T makeDiff(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*, FB_SIZE_T, UCHAR*);
 		static FB_SIZE_T makeNoDiff(FB_SIZE_T, UCHAR*);
@@ -63,6 +64,44 @@ namespace Jrd
 		FB_SIZE_T m_length;
 	};
 
+	// LZ77 encoding of the whole record, used instead of RLE when enabled for
+	// the database and it gives the shorter result. Packed data starts with
+	// the unpacked length (two bytes, little endian) followed by sequences
+	// of literals and back references, similar to LZ4 block format.
+	// Such records have rhd_lz flag set and are never fragmented.
+
+	class LzCompressor
+	{
+	public:
+		LzCompressor(MemoryPool& pool, FB_SIZE_T length, const UCHAR* data, FB_SIZE_T limit);
+
+		// Zero means that the record could not be packed shorter than limit
+		FB_SIZE_T getPackedLength() const
+		{
+			return m_data.getCount();
+		}
+
+		void pack(UCHAR* output) const
+		{
+			memcpy(output, m_data.begin(), m_data.getCount());
+		}
+
+		static UCHAR* unpack(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
+		static UCHAR* unpackPrefix(FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
+		static FB_SIZE_T getUnpackedLength(FB_SIZE_T, const UCHAR*);
+
+	private:
+		static UCHAR* decode(FB_SIZE_T, const UCHAR*, FB_SIZE_T, FB_SIZE_T, UCHAR*);
+
+		Firebird::HalfStaticArray<UCHAR, 2048> m_data;
+	};
+
+	// Unpack the record data according to the record header flags
+	UCHAR* unpackRecord(USHORT flags, FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
+
+	// Same as above, but stop as soon as the given number of bytes is unpacked
+	UCHAR* unpackRecordPrefix(USHORT flags, FB_SIZE_T, const UCHAR*, FB_SIZE_T, UCHAR*);
+
 } //namespace Jrd
 
 #endif // JRD_SQZ_H
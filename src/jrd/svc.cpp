@@ -2814,6 +2814,15 @@ bool Service::process_switches(ClumpletReader& spb, string& switches)
 				}
 				break;
 
+			case isc_spb_sts_sample:
+			case isc_spb_sts_parallel:
+				if (!get_action_svc_parameter(spb.getClumpTag(), dba_in_sw_table, switches))
+				{
+					return false;
+				}
+				get_action_svc_data(spb, switches, false);
+				break;
+
 			case isc_spb_command_line:
 				{
 					string s;
@@ -2854,6 +2863,7 @@ bool Service::process_switches(ClumpletReader& spb, string& switches)
 			case isc_spb_bkp_factor:
 			case isc_spb_res_buffers:
 			case isc_spb_res_page_size:
+			case isc_spb_res_parallel:
 			case isc_spb_verbint:
 				if (!get_action_svc_parameter(spb.getClumpTag(), reference_burp_in_sw_table, switches))
 				{
@@ -3005,6 +3015,7 @@ bool Service::process_switches(ClumpletReader& spb, string& switches)
 				get_action_svc_string(spb, switches);
 				break;
 			case isc_spb_val_lock_timeout:
+			case isc_spb_val_parallel:
 				get_action_svc_data(spb, switches, bigint);
 				break;
 			}
@@ -31,16 +31,329 @@
 #include "../jrd/ods_proto.h"
 #include "../jrd/tpc_proto.h"
 #include "../jrd/tra_proto.h"
+#include "../common/file_params.h"
+#include "../common/isc_proto.h"
+
+#ifdef WIN_NT
+#include <process.h>
+#define getpid _getpid
+#endif
 
 
 using namespace Firebird;
 
 namespace Jrd {
 
+// TransactionStates class
+
+TransactionStates::TransactionStates(Database* dbb)
+	: m_pid(getpid())
+{
+	string name;
+	name.printf(TPC_FILE, dbb->getUniqueFileId().c_str());
+
+	const ULONG size = FB_ALIGN(sizeof(Header), sizeof(AtomicCounter)) +
+		BLOCKS * (BLOCK_WORDS + 1) * sizeof(AtomicCounter);
+
+	m_sharedMemory.reset(FB_NEW_POOL(*dbb->dbb_permanent)
+		SharedMemory<Header>(name.c_str(), size, this));
+
+	Header* const header = m_sharedMemory->getHeader();
+
+	if (header->mhb_type != SharedMemoryBase::SRAM_TRANSACTION_STATES ||
+		header->mhb_header_version != MemoryHeader::HEADER_VERSION ||
+		header->mhb_version != STATES_VERSION)
+	{
+		fatal_exception::raiseFmt(
+			"TPC: inconsistent shared memory type/version; found %d/%d:%d, expected %d/%d:%d",
+			header->mhb_type, header->mhb_header_version, header->mhb_version,
+			SharedMemoryBase::SRAM_TRANSACTION_STATES, MemoryHeader::HEADER_VERSION,
+			STATES_VERSION);
+	}
+
+	m_sharedMemory->mutexLock();
+
+	// If nobody alive maps the array, it's left by crashed processes and
+	// the states could belong to a database file replaced since then
+
+	if (!purgeProcesses())
+	{
+		UCHAR* const blocks = (UCHAR*) header + FB_ALIGN(sizeof(Header), sizeof(AtomicCounter));
+		memset(blocks, 0, BLOCKS * (BLOCK_WORDS + 1) * sizeof(AtomicCounter));
+	}
+
+	bool registered = false;
+
+	for (ULONG i = 0; i < MAX_PROCESSES; i++)
+	{
+		if (!header->tsh_processes[i])
+		{
+			header->tsh_processes[i] = m_pid;
+			registered = true;
+			break;
+		}
+	}
+
+	m_sharedMemory->mutexUnlock();
+
+	if (!registered)
+		fatal_exception::raise("TPC: too many processes map the transaction states");
+}
+
+
+TransactionStates::~TransactionStates()
+{
+	m_sharedMemory->mutexLock();
+
+	Header* const header = m_sharedMemory->getHeader();
+
+	for (ULONG i = 0; i < MAX_PROCESSES; i++)
+	{
+		if (header->tsh_processes[i] == m_pid)
+		{
+			header->tsh_processes[i] = 0;
+			break;
+		}
+	}
+
+	const bool last = !purgeProcesses();
+
+	m_sharedMemory->mutexUnlock();
+
+	if (last)
+		m_sharedMemory->removeMapFile();
+}
+
+
+ULONG TransactionStates::purgeProcesses()
+{
+/**************************************
+ *
+ * Functional description
+ *	Forget the processes which died without
+ *	detaching and return the number of alive ones.
+ *	The shared memory mutex must be held by the caller.
+ *
+ **************************************/
+	Header* const header = m_sharedMemory->getHeader();
+	ULONG count = 0;
+
+	for (ULONG i = 0; i < MAX_PROCESSES; i++)
+	{
+		const SLONG pid = header->tsh_processes[i];
+
+		if (!pid)
+			continue;
+
+		if (pid != m_pid && !ISC_check_process_existence(pid))
+			header->tsh_processes[i] = 0;
+		else
+			count++;
+	}
+
+	return count;
+}
+
+
+bool TransactionStates::initialize(SharedMemoryBase* sm, bool init)
+{
+	if (init)
+	{
+		Header* const header = reinterpret_cast<Header*>(sm->sh_mem_header);
+
+		header->init(SharedMemoryBase::SRAM_TRANSACTION_STATES, STATES_VERSION);
+		memset(header->tsh_processes, 0, sizeof(header->tsh_processes));
+		header->tsh_block_size = BLOCK_SIZE;
+		header->tsh_blocks = BLOCKS;
+
+		UCHAR* const blocks = (UCHAR*) header + FB_ALIGN(sizeof(Header), sizeof(AtomicCounter));
+		memset(blocks, 0, BLOCKS * (BLOCK_WORDS + 1) * sizeof(AtomicCounter));
+	}
+
+	return true;
+}
+
+
+void TransactionStates::mutexBug(int osErrorCode, const char* text)
+{
+	string msg;
+	msg.printf("TPC: mutex %s error, status = %d", text, osErrorCode);
+	fb_utils::logAndDie(msg.c_str());
+}
+
+
+AtomicCounter* TransactionStates::getBlock(StateWord sequence) const
+{
+	UCHAR* const blocks = (UCHAR*) m_sharedMemory->getHeader() +
+		FB_ALIGN(sizeof(Header), sizeof(AtomicCounter));
+
+	return (AtomicCounter*) blocks + (sequence % BLOCKS) * (BLOCK_WORDS + 1);
+}
+
+
+AtomicCounter* TransactionStates::lockBlock(StateWord sequence)
+{
+/**************************************
+ *
+ * Functional description
+ *	Return the block holding the given transaction range,
+ *	recycling an older block if necessary. The shared
+ *	memory mutex must be held by the caller.
+ *
+ **************************************/
+	AtomicCounter* const block = getBlock(sequence);
+	const StateWord current = block->value();
+
+	if (current == sequence)
+		return block;
+
+	// Never step back, the block is already reused by newer transactions
+
+	if (current > sequence)
+		return NULL;
+
+	// Readers check the block sequence before and after fetching a state,
+	// so invalidate it first and publish the new one after clearing states
+
+	block->setValue(0);
+
+	for (ULONG i = 1; i <= BLOCK_WORDS; i++)
+		block[i].setValue(0);
+
+	block->setValue(sequence);
+
+	return block;
+}
+
+
+int TransactionStates::getState(TraNumber number) const
+{
+/**************************************
+ *
+ * Functional description
+ *	Return the final state of the transaction if it's known
+ *	to be committed or dead, otherwise return tra_active.
+ *	No locks are taken here.
+ *
+ **************************************/
+	const StateWord sequence = (StateWord) (number / BLOCK_SIZE) + 1;
+	const ULONG offset = (ULONG) (number % BLOCK_SIZE);
+
+	const AtomicCounter* const block = getBlock(sequence);
+
+	if (block->value() != sequence)
+		return tra_active;
+
+	WaitForFlushCache();
+
+	const StateWord word = block[1 + offset / TRANS_PER_WORD].value();
+	const int state = (int) (word >> ((offset % TRANS_PER_WORD) * 2)) & TRA_MASK;
+
+	WaitForFlushCache();
+
+	// The block could be recycled while we were reading it
+
+	if (block->value() != sequence)
+		return tra_active;
+
+	return state;
+}
+
+
+void TransactionStates::setState(TraNumber number, int state)
+{
+	// Only the final states are published, anything else should be
+	// checked by the caller using the TIP cache and the lock manager
+
+	if (state != tra_committed && state != tra_dead)
+		return;
+
+	const StateWord sequence = (StateWord) (number / BLOCK_SIZE) + 1;
+	const ULONG offset = (ULONG) (number % BLOCK_SIZE);
+	const ULONG shift = (offset % TRANS_PER_WORD) * 2;
+
+	m_sharedMemory->mutexLock();
+
+	AtomicCounter* const block = lockBlock(sequence);
+
+	if (block)
+	{
+		AtomicCounter& word = block[1 + offset / TRANS_PER_WORD];
+		word.exchangeBitAnd(~((StateWord) TRA_MASK << shift));
+		word.exchangeBitOr((StateWord) state << shift);
+	}
+
+	m_sharedMemory->mutexUnlock();
+}
+
+
+void TransactionStates::updateStates(const UCHAR* states, TraNumber base, ULONG count)
+{
+/**************************************
+ *
+ * Functional description
+ *	Publish the final states found at the TIP page.
+ *	Transactions committed before their block was
+ *	allocated become visible to everybody this way.
+ *
+ **************************************/
+	m_sharedMemory->mutexLock();
+
+	AtomicCounter* block = NULL;
+	StateWord sequence = 0;
+
+	for (TraNumber number = base; number < base + count; number++)
+	{
+		const int state = TRA_state(states, base, number);
+
+		if (state != tra_committed && state != tra_dead)
+			continue;
+
+		const StateWord blockSequence = (StateWord) (number / BLOCK_SIZE) + 1;
+
+		if (blockSequence != sequence)
+		{
+			sequence = blockSequence;
+			block = getBlock(sequence);
+
+			// Don't allocate blocks for the old TIP pages
+
+			if (block->value() != sequence)
+				block = NULL;
+		}
+
+		if (block)
+		{
+			const ULONG offset = (ULONG) (number % BLOCK_SIZE);
+			const ULONG shift = (offset % TRANS_PER_WORD) * 2;
+			AtomicCounter& word = block[1 + offset / TRANS_PER_WORD];
+
+			if (!((word.value() >> shift) & TRA_MASK))
+				word.exchangeBitOr((StateWord) state << shift);
+		}
+	}
+
+	m_sharedMemory->mutexUnlock();
+}
+
+
+// TipCache class
+
 TipCache::TipCache(Database* dbb)
 	: m_dbb(dbb),
 	  m_cache(*m_dbb->dbb_permanent)
 {
+	// The shared states are an optimization only, so work without
+	// them if the shared memory region can't be created
+
+	try
+	{
+		m_states.reset(FB_NEW_POOL(*m_dbb->dbb_permanent) TransactionStates(m_dbb));
+	}
+	catch (const Exception& ex)
+	{
+		iscLogException("TipCache: Cannot initialize the shared transaction states", ex);
+	}
 }
 
 
@@ -67,6 +380,13 @@ int TipCache::cacheState(thread_db* tdbb, TraNumber number)
 	if (number && TRA_precommited(tdbb, number, number))
 		return tra_precommitted;
 
+	if (m_states)
+	{
+		const int state = m_states->getState(number);
+		if (state == tra_committed || state == tra_dead)
+			return state;
+	}
+
 	SyncLockGuard sync(&m_sync, SYNC_SHARED, "TipCache::cacheState");
 
 	if (!m_cache.getCount())
@@ -297,6 +617,28 @@ void TipCache::setState(TraNumber number, SSHORT state)
 }
 
 
+void TipCache::publishState(TraNumber number, SSHORT state)
+{
+/**************************************
+ *
+ *	T P C _ p u b l i s h _ s t a t e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Make the state of a transaction visible to the
+ *	other processes. It must be done only after the
+ *	TIP page with the state is written, otherwise a
+ *	crash would leave them with a state the database
+ *	doesn't know about.
+ *
+ **************************************/
+
+	if (m_states)
+		m_states->setState(number, state);
+}
+
+
 int TipCache::snapshotState(thread_db* tdbb, TraNumber number)
 {
 /**************************************
@@ -318,6 +660,16 @@ int TipCache::snapshotState(thread_db* tdbb, TraNumber number)
 	if (number && TRA_precommited(tdbb, number, number))
 		return tra_precommitted;
 
+	// committed or dead transactions published by any process
+	// need neither the TIP cache nor the lock manager
+
+	if (m_states)
+	{
+		const int state = m_states->getState(number);
+		if (state == tra_committed || state == tra_dead)
+			return state;
+	}
+
 	SyncLockGuard sync(&m_sync, SYNC_SHARED, "TipCache::snapshotState");
 
 	if (m_cache.isEmpty())
@@ -447,6 +799,9 @@ void TipCache::updateCache(const Ods::tx_inv_page* tip_page, ULONG sequence)
 
 	const USHORT len = TRANS_OFFSET(trans_per_tip);
 	memcpy(tip_cache->tpc_transactions, tip_page->tip_transactions, len);
+
+	if (m_states)
+		m_states->updateStates(tip_page->tip_transactions, first_trans, trans_per_tip);
 }
 
 
@@ -25,7 +25,10 @@
 #define JRD_TPC_PROTO_H
 
 #include "../common/classes/array.h"
+#include "../common/classes/auto.h"
+#include "../common/classes/fb_atomic.h"
 #include "../common/classes/SyncObject.h"
+#include "../common/isc_s_proto.h"
 
 namespace Ods {
 struct tx_inv_page;
@@ -36,6 +39,51 @@ namespace Jrd {
 class Database;
 class thread_db;
 
+// Process-shared array of final (committed or dead) transaction states.
+// Writers serialize on the shared memory mutex, readers never lock anything.
+
+class TransactionStates FB_FINAL : public Firebird::IpcObject
+{
+public:
+	explicit TransactionStates(Database* dbb);
+	~TransactionStates();
+
+	bool initialize(Firebird::SharedMemoryBase* sm, bool init);
+	void mutexBug(int osErrorCode, const char* text);
+
+	int getState(TraNumber number) const;
+	void setState(TraNumber number, int state);
+	void updateStates(const UCHAR* states, TraNumber base, ULONG count);
+
+private:
+	typedef Firebird::AtomicCounter::counter_type StateWord;
+
+	static const ULONG MAX_PROCESSES = 1024;
+
+	struct Header : public Firebird::MemoryHeader
+	{
+		ULONG tsh_block_size;		// transactions per block
+		ULONG tsh_blocks;			// number of blocks in the ring
+		SLONG tsh_processes[MAX_PROCESSES];	// processes mapping the array, zero if free
+	};
+
+	static const USHORT STATES_VERSION = 2;
+	static const ULONG BLOCK_SIZE = 65536;
+	static const ULONG BLOCKS = 64;
+	static const ULONG TRANS_PER_WORD = sizeof(StateWord) * 4;
+	static const ULONG BLOCK_WORDS = BLOCK_SIZE / TRANS_PER_WORD;
+
+	// Every block starts with the sequence (plus one) of the transaction
+	// range it holds, zero meaning the block is free or being recycled
+
+	Firebird::AtomicCounter* getBlock(StateWord sequence) const;
+	Firebird::AtomicCounter* lockBlock(StateWord sequence);
+	ULONG purgeProcesses();
+
+	Firebird::AutoPtr<Firebird::SharedMemory<Header> > m_sharedMemory;
+	const SLONG m_pid;
+};
+
 class TipCache
 {
 public:
@@ -46,6 +94,7 @@ public:
 	TraNumber findStates(thread_db* tdbb, TraNumber minNumber, TraNumber maxNumber, ULONG mask, int& state);
 	void initializeTpc(thread_db*, TraNumber number);
 	void setState(TraNumber number, SSHORT state);
+	void publishState(TraNumber number, SSHORT state);
 	int snapshotState(thread_db*, TraNumber number);
 	void updateCache(const Ods::tx_inv_page* tip_page, ULONG sequence);
 
@@ -68,6 +117,7 @@ private:
 	void clearCache();
 
 	Database* m_dbb;
+	Firebird::AutoPtr<TransactionStates> m_states;
 	Firebird::SyncObject m_sync;
 	Firebird::SortedArray<TxPage*, Firebird::EmptyStorage<TxPage*>, TraNumber, TxPage> m_cache;
 };
@@ -94,6 +144,11 @@ inline void TPC_set_state(thread_db* tdbb, TraNumber number, SSHORT state)
 	 tdbb->getDatabase()->dbb_tip_cache->setState(number, state);
 }
 
+inline void TPC_publish_state(thread_db* tdbb, TraNumber number, SSHORT state)
+{
+	 tdbb->getDatabase()->dbb_tip_cache->publishState(number, state);
+}
+
 inline int TPC_snapshot_state(thread_db* tdbb, TraNumber number)
 {
 	 return tdbb->getDatabase()->dbb_tip_cache->snapshotState(tdbb, number);
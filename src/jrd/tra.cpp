@@ -1438,6 +1438,7 @@ void TRA_set_state(thread_db* tdbb, jrd_tra* transaction, TraNumber number, int
 	if (dbb->readOnly() && dbb->dbb_tip_cache)
 	{
 		TPC_set_state(tdbb, number, state);
+		TPC_publish_state(tdbb, number, state);
 		return;
 	}
 
@@ -1456,12 +1457,12 @@ void TRA_set_state(thread_db* tdbb, jrd_tra* transaction, TraNumber number, int
 	CCH_MARK(tdbb, &window);
 	const ULONG generation = tip->tip_header.pag_generation;
 #else
-	if (!(dbb->dbb_flags & DBB_shared) || !transaction  ||
+	const bool mustWrite = !(dbb->dbb_flags & DBB_shared) || !transaction  ||
 		(transaction->tra_flags & TRA_write) ||
-		old_state != tra_active || state != tra_committed)
-	{
+		old_state != tra_active || state != tra_committed;
+
+	if (mustWrite)
 		CCH_MARK_MUST_WRITE(tdbb, &window);
-	}
 	else
 		CCH_MARK(tdbb, &window);
 #endif
@@ -1478,6 +1479,13 @@ void TRA_set_state(thread_db* tdbb, jrd_tra* transaction, TraNumber number, int
 
 	CCH_RELEASE(tdbb, &window);
 
+#ifndef SUPERSERVER_V2
+	// Other processes may see the new state only when it's on disk
+
+	if (mustWrite && dbb->dbb_tip_cache)
+		TPC_publish_state(tdbb, number, state);
+#endif
+
 #ifdef SUPERSERVER_V2
 	// Let the TIP be lazily updated for read-only queries.
 	// To amortize write of TIP page for update transactions,
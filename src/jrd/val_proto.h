@@ -33,6 +33,7 @@ const int IN_SW_VAL_IDX_INCL		= 3;
 const int IN_SW_VAL_IDX_EXCL		= 4;
 const int IN_SW_VAL_LOCK_TIMEOUT	= 5;
 const int IN_SW_VAL_DATABASE		= 6;
+const int IN_SW_VAL_PARALLEL		= 7;
 
 static const Switches::in_sw_tab_t val_option_in_sw_table[] =
 {
@@ -41,6 +42,7 @@ static const Switches::in_sw_tab_t val_option_in_sw_table[] =
 	{IN_SW_VAL_IDX_INCL,		isc_spb_val_idx_incl,		"IDX_INCLUDE",	0, 0, 0, false,	false,	0,	5, NULL},
 	{IN_SW_VAL_IDX_EXCL,		isc_spb_val_idx_excl,		"IDX_EXCLUDE",	0, 0, 0, false,	false,	0,	5, NULL},
 	{IN_SW_VAL_LOCK_TIMEOUT,	isc_spb_val_lock_timeout,	"WAIT", 		0, 0, 0, false,	false,	0,	1, NULL},
+	{IN_SW_VAL_PARALLEL,		isc_spb_val_parallel,		"PARALLEL",		0, 0, 0, false,	false,	0,	3, NULL},
 
 	{IN_SW_VAL_DATABASE,		isc_spb_dbname,				"DATABASE",		0, 0, 0, false,	false,	0,	1, NULL},
 
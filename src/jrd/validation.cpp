@@ -564,6 +564,7 @@ VI. ADDITIONAL NOTES
 #include "../jrd/ods_proto.h"
 #include "../jrd/tra_proto.h"
 #include "../jrd/val_proto.h"
+#include "../jrd/sqz.h"
 #include "../jrd/validation.h"
 
 #include "../common/classes/ClumpletWriter.h"
@@ -762,6 +763,7 @@ static int validate(Firebird::UtilSvc* svc)
 		Jrd::ContextPoolHolder context(tdbb, val_pool);
 
 		Validation control(tdbb, svc);
+		control.setWorkerAttach(expandedFilename, dpb.getBuffer(), dpb.getBufferLength());
 		control.run(tdbb, Validation::VDR_records | Validation::VDR_online | Validation::VDR_partial);
 
 		att->att_use_count--;
@@ -852,6 +854,12 @@ const Validation::MSG_ENTRY Validation::vdr_msg_table[VAL_MAX_ERROR] =
 };
 
 Validation::Validation(thread_db* tdbb, UtilSvc* uSvc) :
+	vdr_idx_incl_src(*tdbb->getDefaultPool()),
+	vdr_idx_excl_src(*tdbb->getDefaultPool()),
+	vdr_db_name(*tdbb->getDefaultPool()),
+	vdr_dpb(*tdbb->getDefaultPool()),
+	vdr_rel_queue(*tdbb->getDefaultPool()),
+	vdr_output(*tdbb->getDefaultPool()),
 	vdr_used_bdbs(*tdbb->getDefaultPool())
 {
 	vdr_tdbb = tdbb;
@@ -874,12 +882,69 @@ Validation::Validation(thread_db* tdbb, UtilSvc* uSvc) :
 	vdr_idx_incl = vdr_idx_excl = NULL;
 	vdr_lock_tout = -10;
 
+	vdr_parallel = 1;
+	vdr_master = NULL;
+	vdr_rel_next = 0;
+	vdr_worker_errors = vdr_worker_warns = vdr_worker_fixed = 0;
+	memset(vdr_worker_counts, 0, sizeof(vdr_worker_counts));
+	vdr_buffered = false;
+
 	if (uSvc) {
 		parse_args(tdbb);
 	}
 	output("Validation started\n\n");
 }
 
+Validation::Validation(thread_db* tdbb, Validation* master) :
+	vdr_idx_incl_src(*tdbb->getDefaultPool()),
+	vdr_idx_excl_src(*tdbb->getDefaultPool()),
+	vdr_db_name(*tdbb->getDefaultPool()),
+	vdr_dpb(*tdbb->getDefaultPool()),
+	vdr_rel_queue(*tdbb->getDefaultPool()),
+	vdr_output(*tdbb->getDefaultPool()),
+	vdr_used_bdbs(*tdbb->getDefaultPool())
+{
+	// Worker of parallel online validation, runs in its own attachment
+
+	vdr_tdbb = tdbb;
+	vdr_max_page = 0;
+	vdr_flags = master->vdr_flags;
+	vdr_errors = 0;
+	vdr_warns = 0;
+	vdr_fixed = 0;
+	vdr_max_transaction = 0;
+	vdr_rel_backversion_counter = 0;
+	vdr_backversion_pages = NULL;
+	vdr_rel_chain_counter = 0;
+	vdr_chain_pages = NULL;
+	vdr_rel_records = NULL;
+	vdr_idx_records = NULL;
+	vdr_page_bitmap = NULL;
+
+	for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
+		vdr_err_counts[i] = 0;
+
+	vdr_service = master->vdr_service;
+	vdr_tab_incl = vdr_tab_excl = NULL;
+	vdr_idx_incl = vdr_idx_excl = NULL;
+	vdr_lock_tout = master->vdr_lock_tout;
+
+	// Pattern matchers depend on the attachment, make own ones
+
+	if (master->vdr_idx_incl_src.hasData())
+		vdr_idx_incl = createPatternMatcher(tdbb, master->vdr_idx_incl_src.c_str());
+
+	if (master->vdr_idx_excl_src.hasData())
+		vdr_idx_excl = createPatternMatcher(tdbb, master->vdr_idx_excl_src.c_str());
+
+	vdr_parallel = 1;
+	vdr_master = master;
+	vdr_rel_next = 0;
+	vdr_worker_errors = vdr_worker_warns = vdr_worker_fixed = 0;
+	memset(vdr_worker_counts, 0, sizeof(vdr_worker_counts));
+	vdr_buffered = true;
+}
+
 Validation::~Validation()
 {
 	delete vdr_tab_incl;
@@ -887,7 +952,8 @@ Validation::~Validation()
 	delete vdr_idx_incl;
 	delete vdr_idx_excl;
 
-	output("Validation finished\n");
+	if (!vdr_master)
+		output("Validation finished\n");
 }
 
 void Validation::parse_args(thread_db* tdbb)
@@ -923,6 +989,7 @@ void Validation::parse_args(thread_db* tdbb)
 		case IN_SW_VAL_IDX_INCL:
 		case IN_SW_VAL_IDX_EXCL:
 		case IN_SW_VAL_LOCK_TIMEOUT:
+		case IN_SW_VAL_PARALLEL:
 			*argv++ = NULL;
 			if (argv >= end || !(*argv))
 			{
@@ -949,10 +1016,12 @@ void Validation::parse_args(thread_db* tdbb)
 
 		case IN_SW_VAL_IDX_INCL:
 			vdr_idx_incl = createPatternMatcher(tdbb, *argv);
+			vdr_idx_incl_src = *argv;
 			break;
 
 		case IN_SW_VAL_IDX_EXCL:
 			vdr_idx_excl = createPatternMatcher(tdbb, *argv);
+			vdr_idx_excl_src = *argv;
 			break;
 
 		case IN_SW_VAL_LOCK_TIMEOUT:
@@ -970,6 +1039,21 @@ void Validation::parse_args(thread_db* tdbb)
 			}
 			break;
 
+		case IN_SW_VAL_PARALLEL:
+			{
+				char* end = (char*) *argv;
+				vdr_parallel = strtol(*argv, &end, 10);
+
+				if ((end && *end) || vdr_parallel < 1)
+				{
+					string s;
+					s.printf("Value (%s) is not a valid number of workers", *argv);
+
+					(Arg::Gds(isc_random) << Arg::Str(s)).raise();
+				}
+			}
+			break;
+
 		default:
 			break;
 		}
@@ -994,12 +1078,35 @@ void Validation::output(const char* format, ...)
 	s.printf("%02d:%02d:%02d.%02d ",
 		///now.tm_year + 1900, now.tm_mon + 1, now.tm_mday,
 		now.tm_hour, now.tm_min, now.tm_sec, ms / 100);
-	vdr_service->outputVerbose(s.c_str());
+
+	if (vdr_buffered)
+		vdr_output.append(s);
+	else
+		vdr_service->outputVerbose(s.c_str());
 
 	s.vprintf(format, params);
 	va_end(params);
 
-	vdr_service->outputVerbose(s.c_str());
+	if (vdr_buffered)
+		vdr_output.append(s);
+	else
+		vdr_service->outputVerbose(s.c_str());
+}
+
+
+void Validation::flush_output()
+{
+	// Service output is not thread-safe, and lines of the relations
+	// validated in parallel should not be interleaved
+
+	if (vdr_output.isEmpty())
+		return;
+
+	Validation* const master = vdr_master ? vdr_master : this;
+	MutexLockGuard guard(master->vdr_mutex, FB_FUNCTION);
+
+	vdr_service->outputVerbose(vdr_output.c_str());
+	vdr_output.erase();
 }
 
 
@@ -1027,6 +1134,10 @@ bool Validation::run(thread_db* tdbb, USHORT flags)
 
 		vdr_flags = flags;
 
+		// Relations are validated independently in online mode only
+		if (!(vdr_flags & VDR_online))
+			vdr_parallel = 1;
+
 		// initialize validate errors
 		vdr_errors = vdr_warns = vdr_fixed = 0;
 		for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
@@ -1665,31 +1776,245 @@ void Validation::walk_database()
 				}
 			}
 
-			// We can't realiable track double allocated page's when validating online.
-			// All we can check is that page is not double allocated at the same relation.
-			if (vdr_flags & VDR_online)
-				vdr_page_bitmap->clear();
-
-			string relName;
-			relName.printf("Relation %d (%s)", relation->rel_id, relation->rel_name.c_str());
-			output("%s\n", relName.c_str());
-
-			int errs = vdr_errors;
-			walk_relation(relation);
-			errs = vdr_errors - errs;
+			if (vdr_parallel > 1)
+			{
+				vdr_rel_queue.add(relation->rel_id);
+				continue;
+			}
 
-			if (!errs)
-				output("%s is ok\n\n", relName.c_str());
-			else
-				output("%s : %d ERRORS found\n\n", relName.c_str(), errs);
+			check_relation(relation);
 		}
 	}
 
+	if (vdr_rel_queue.hasData())
+		walk_parallel();
+
 	if (!(vdr_flags & VDR_online)) {
 		release_page(&window);
 	}
 }
 
+void Validation::check_relation(jrd_rel* relation)
+{
+/**************************************
+ *
+ *	c h e c k _ r e l a t i o n
+ *
+ **************************************
+ *
+ * Functional description
+ *	Walk the relation and report the result.
+ *
+ **************************************/
+
+	// We can't realiable track double allocated page's when validating online.
+	// All we can check is that page is not double allocated at the same relation.
+	if (vdr_flags & VDR_online)
+		PageBitmap::reset(vdr_page_bitmap);
+
+	string relName;
+	relName.printf("Relation %d (%s)", relation->rel_id, relation->rel_name.c_str());
+	output("%s\n", relName.c_str());
+
+	int errs = vdr_errors;
+	walk_relation(relation);
+	errs = vdr_errors - errs;
+
+	if (!errs)
+		output("%s is ok\n\n", relName.c_str());
+	else
+		output("%s : %d ERRORS found\n\n", relName.c_str(), errs);
+}
+
+void Validation::walk_parallel()
+{
+/**************************************
+ *
+ *	w a l k _ p a r a l l e l
+ *
+ **************************************
+ *
+ * Functional description
+ *	Validate queued relations by this and worker attachments.
+ *	Online validation of a relation depends on nothing but the
+ *	relation's own locks and pages, so relations are independent.
+ *
+ **************************************/
+	HalfStaticArray<Thread::Handle, 8> workers;
+
+	vdr_rel_next = 0;
+	vdr_buffered = true;
+
+	try
+	{
+		for (int n = 1; n < vdr_parallel && (FB_SIZE_T) n < vdr_rel_queue.getCount(); n++)
+		{
+			Thread::Handle handle;
+			Thread::start(worker_thread, (THREAD_ENTRY_PARAM) this, THREAD_medium, &handle);
+			workers.add(handle);
+		}
+
+		walk_queue();
+	}
+	catch (const Exception&)
+	{
+		{	// scope
+			MutexLockGuard guard(vdr_mutex, FB_FUNCTION);
+			vdr_rel_next = vdr_rel_queue.getCount();
+		}
+
+		flush_output();
+
+		EngineCheckout checkout(vdr_tdbb, FB_FUNCTION);
+
+		for (FB_SIZE_T n = 0; n < workers.getCount(); n++)
+			Thread::waitForCompletion(workers[n]);
+
+		vdr_buffered = false;
+		throw;
+	}
+
+	{	// scope
+		EngineCheckout checkout(vdr_tdbb, FB_FUNCTION);
+
+		for (FB_SIZE_T n = 0; n < workers.getCount(); n++)
+			Thread::waitForCompletion(workers[n]);
+	}
+
+	vdr_buffered = false;
+
+	vdr_errors += vdr_worker_errors;
+	vdr_warns += vdr_worker_warns;
+	vdr_fixed += vdr_worker_fixed;
+
+	for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
+		vdr_err_counts[i] += vdr_worker_counts[i];
+}
+
+void Validation::walk_queue()
+{
+	Validation* const master = vdr_master ? vdr_master : this;
+	USHORT rel_id;
+
+	while (master->next_relation(rel_id))
+	{
+		jrd_rel* const relation = MET_lookup_relation_id(vdr_tdbb, rel_id, false);
+
+		if (relation)
+			check_relation(relation);
+
+		flush_output();
+	}
+}
+
+bool Validation::next_relation(USHORT& rel_id)
+{
+	MutexLockGuard guard(vdr_mutex, FB_FUNCTION);
+
+	if (vdr_rel_next >= vdr_rel_queue.getCount())
+		return false;
+
+	rel_id = vdr_rel_queue[vdr_rel_next++];
+	return true;
+}
+
+THREAD_ENTRY_DECLARE Validation::worker_thread(THREAD_ENTRY_PARAM arg)
+{
+	static_cast<Validation*>(arg)->worker();
+	return 0;
+}
+
+void Validation::worker()
+{
+/**************************************
+ *
+ *	w o r k e r
+ *
+ **************************************
+ *
+ * Functional description
+ *	Thread of parallel online validation. Attach the
+ *	database the same way the service did and take
+ *	relations from the master's queue.
+ *
+ **************************************/
+	FbLocalStatus status;
+
+	try
+	{
+		RefPtr<JProvider> jProv(JProvider::getInstance());
+		RefPtr<JAttachment> jAtt;
+		jAtt.assignRefNoIncr(jProv->attachDatabase(&status, vdr_db_name.c_str(),
+			vdr_dpb.getCount(), vdr_dpb.begin()));
+
+		if (status->getState() & IStatus::STATE_ERRORS)
+			status_exception::raise(&status);
+
+		Attachment* att = jAtt->getHandle();
+		Database* dbb = att->att_database;
+		MemoryPool* val_pool = NULL;
+
+		try
+		{
+			BackgroundContextHolder tdbb(dbb, att, &status, FB_FUNCTION);
+			att->att_use_count++;
+
+			tdbb->tdbb_flags |= TDBB_sweeper;
+
+			val_pool = dbb->createPool();
+			Jrd::ContextPoolHolder context(tdbb, val_pool);
+
+			Validation helper(tdbb, this);
+
+			try
+			{
+				DPM_scan_pages(tdbb);
+				helper.walk_queue();
+			}
+			catch (const Exception&)
+			{
+				CCH_unwind(tdbb, false);
+				helper.flush_output();
+				helper.vdr_errors++;
+				helper.cleanup();
+
+				MutexLockGuard guard(vdr_mutex, FB_FUNCTION);
+				vdr_worker_errors += helper.vdr_errors;
+				throw;
+			}
+
+			helper.cleanup();
+
+			{	// scope
+				MutexLockGuard guard(vdr_mutex, FB_FUNCTION);
+
+				vdr_worker_errors += helper.vdr_errors;
+				vdr_worker_warns += helper.vdr_warns;
+				vdr_worker_fixed += helper.vdr_fixed;
+
+				for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
+					vdr_worker_counts[i] += helper.vdr_err_counts[i];
+			}
+
+			att->att_use_count--;
+		}
+		catch (const Exception&)
+		{
+			att->att_use_count--;
+			dbb->deletePool(val_pool);
+			jAtt->detach(&status);
+			throw;
+		}
+
+		dbb->deletePool(val_pool);
+		jAtt->detach(&status);
+	}
+	catch (const Exception& ex)
+	{
+		iscLogException("Validation worker", ex);
+	}
+}
+
 Validation::RTN Validation::walk_data_page(jrd_rel* relation, ULONG page_number,
 	ULONG sequence, UCHAR& pp_bits)
 {
@@ -1934,6 +2259,56 @@ void Validation::walk_header(ULONG page_num)
 	}
 }
 
+bool Validation::null_field(jrd_rel* relation, RecordNumber number, USHORT field_id)
+{
+/**************************************
+ *
+ *	n u l l _ f i e l d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Check whether the field is NULL in the primary version
+ *	of the record. Deleted and vanished records are treated
+ *	as NULL, they are not expected in the index either.
+ *
+ **************************************/
+	record_param rpb;
+	rpb.rpb_relation = relation;
+	rpb.rpb_number = number;
+
+	if (!DPM_get(vdr_tdbb, &rpb, LCK_read))
+		return true;
+
+	// Null flags lead the record data, unpack just them and
+	// release the page before the format is looked up
+
+	const FB_SIZE_T flags_length = (field_id >> 3) + 1;
+	Firebird::HalfStaticArray<UCHAR, 64> flags;
+	UCHAR* const buffer = flags.getBuffer(flags_length);
+	FB_SIZE_T length = 0;
+
+	if (!(rpb.rpb_flags & rpb_deleted))
+	{
+		length = unpackRecordPrefix(rpb.rpb_flags, rpb.rpb_length, rpb.rpb_address,
+			flags_length, buffer) - buffer;
+	}
+
+	CCH_RELEASE(vdr_tdbb, &rpb.getWindow(vdr_tdbb));
+
+	if (length < flags_length)
+		return true;
+
+	// Fields added after the record was stored are NULL there
+	const Format* const format = MET_format(vdr_tdbb, relation, rpb.rpb_format_number);
+
+	if (field_id >= format->fmt_count)
+		return true;
+
+	return (buffer[field_id >> 3] & (1 << (field_id & 7))) != 0;
+}
+
+
 Validation::RTN Validation::walk_index(jrd_rel* relation, index_root_page& root_page, USHORT id)
 {
 /**************************************
@@ -1962,6 +2337,19 @@ Validation::RTN Validation::walk_index(jrd_rel* relation, index_root_page& root_
 	const bool unique = (root_page.irt_rpt[id].irt_flags & (irt_unique | idx_primary));
 	const bool descending = (root_page.irt_rpt[id].irt_flags & irt_descending);
 
+	// Trigram index has no keys for NULL values, rows with NULL
+	// in the indexed field are legitimately missing from it
+
+	const bool trigram = (root_page.irt_rpt[id].irt_flags & irt_trigram);
+	USHORT trigram_field = 0;
+
+	if (trigram)
+	{
+		index_desc idx;
+		BTR_description(vdr_tdbb, relation, &root_page, &idx, id);
+		trigram_field = idx.idx_rpt[0].idx_field;
+	}
+
 	temporary_key nullKey, *null_key = 0;
 	if (unique)
 	{
@@ -2362,8 +2750,11 @@ Validation::RTN Validation::walk_index(jrd_rel* relation, index_root_page& root_
 			{
 				SINT64 next_number = accessor.current();
 
-				if (!RecordBitmap::test(vdr_idx_records, next_number))
+				if (!RecordBitmap::test(vdr_idx_records, next_number) &&
+					!(trigram && null_field(relation, RecordNumber(next_number), trigram_field)))
+				{
 					return corrupt(VAL_INDEX_MISSING_ROWS, relation, id + 1, next_number);
+				}
 			} while (accessor.getNext());
 		}
 	}
@@ -2717,6 +3108,15 @@ Validation::RTN Validation::walk_record(jrd_rel* relation, const rhd* header, US
 
 	ULONG record_length = 0;
 
+	if (header->rhd_flags & rhd_lz)
+	{
+		// LZ packed record is never fragmented and keeps its length ahead of data
+		const FB_SIZE_T header_size = (header->rhd_flags & rhd_long_tranum) ? RHDE_SIZE : RHD_SIZE;
+		record_length = (ULONG) LzCompressor::getUnpackedLength(length - header_size,
+			(const UCHAR*) header + header_size);
+		p = end;
+	}
+
 	while (p < end)
 	{
 		const signed char c = *p++;
@@ -28,6 +28,9 @@
 #include "fb_types.h"
 
 #include "../common/classes/array.h"
+#include "../common/classes/fb_string.h"
+#include "../common/classes/locks.h"
+#include "../common/ThreadStart.h"
 #include "../jrd/ods.h"
 #include "../jrd/cch.h"
 #include "../jrd/sbm.h"
@@ -155,16 +158,43 @@ private:
 	PatternMatcher* vdr_idx_incl;
 	PatternMatcher* vdr_idx_excl;
 	int vdr_lock_tout;
+
+	// Parallel online validation. Relations are handed out to the master
+	// and worker attachments from the common queue, workers report their
+	// output and counters to the master.
+	int vdr_parallel;
+	Validation* vdr_master;
+	Firebird::string vdr_idx_incl_src;
+	Firebird::string vdr_idx_excl_src;
+	Firebird::PathName vdr_db_name;
+	Firebird::UCharBuffer vdr_dpb;
+	Firebird::Mutex vdr_mutex;
+	Firebird::Array<USHORT> vdr_rel_queue;
+	FB_SIZE_T vdr_rel_next;
+	int vdr_worker_errors;
+	int vdr_worker_warns;
+	int vdr_worker_fixed;
+	ULONG vdr_worker_counts[VAL_MAX_ERROR];
+	Firebird::string vdr_output;
+	bool vdr_buffered;
+
 	void checkDPinPP(jrd_rel *relation, SLONG page_number);
 	void checkDPinPIP(jrd_rel *relation, SLONG page_number);
 
 public:
 	explicit Validation(thread_db*, Firebird::UtilSvc* uSvc = NULL);
+	Validation(thread_db*, Validation* master);
 	~Validation();
 
 	bool run(thread_db* tdbb, USHORT flags);
 	ULONG getInfo(UCHAR item);
 
+	void setWorkerAttach(const Firebird::PathName& dbName, const UCHAR* dpb, FB_SIZE_T length)
+	{
+		vdr_db_name = dbName;
+		vdr_dpb.assign(dpb, length);
+	}
+
 private:
 	struct UsedBdb
 	{
@@ -195,6 +225,14 @@ private:
 
 	void parse_args(thread_db*);
 	void output(const char*, ...);
+	void flush_output();
+
+	static THREAD_ENTRY_DECLARE worker_thread(THREAD_ENTRY_PARAM);
+	void worker();
+	bool next_relation(USHORT&);
+	bool null_field(jrd_rel*, RecordNumber, USHORT);
+	void walk_parallel();
+	void walk_queue();
 
 	RTN walk_blob(jrd_rel*, const Ods::blh*, USHORT, RecordNumber);
 	RTN walk_chain(jrd_rel*, const Ods::rhd*, RecordNumber);
@@ -206,6 +244,7 @@ private:
 	void walk_pip();
 	RTN walk_pointer_page(jrd_rel*, ULONG);
 	RTN walk_record(jrd_rel*, const Ods::rhd*, USHORT, RecordNumber, bool);
+	void check_relation(jrd_rel*);
 	RTN walk_relation(jrd_rel*);
 	RTN walk_root(jrd_rel*);
 	RTN walk_scns();
@@ -148,6 +148,7 @@ static void list_staying(thread_db*, record_param*, RecordStack&);
 static void list_staying_fast(thread_db*, record_param*, RecordStack&, record_param* = NULL);
 static void notify_garbage_collector(thread_db* tdbb, record_param* rpb,
 	TraNumber tranid = MAX_TRA_NUMBER);
+static ULONG partial_length(const Format*, USHORT);
 
 const int PREPARE_OK		= 0;
 const int PREPARE_CONFLICT	= 1;
@@ -1261,7 +1262,7 @@ void VIO_copy_record(thread_db* tdbb, record_param* org_rpb, record_param* new_r
 }
 
 
-void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
+void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool, bool partial)
 {
 /**************************************
  *
@@ -1276,6 +1277,9 @@ void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
  *	an INactive record_param.  Yes, Virginia, getting the data for a
  *	record means losing control of the record.  This turns out
  *	to matter a lot.
+ *
+ *	If partial is set, the caller needs only the fields up to
+ *	rpb_last_field, so the rest of the record may be left unpacked.
  **************************************/
 	SET_TDBB(tdbb);
 
@@ -1310,6 +1314,16 @@ void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
 	// Primary record version not uses prior version
 	Record* prior = (rpb->rpb_flags & rpb_chained) ? rpb->rpb_prior : NULL;
 
+	// Set up prior record point for next version
+
+	rpb->rpb_prior = (rpb->rpb_b_page && (rpb->rpb_flags & rpb_delta)) ? record : NULL;
+
+	// Delta versions are applied to the complete record image,
+	// and the complete image is needed as a base for the next version
+
+	const ULONG limit = (partial && !prior && !rpb->rpb_prior) ?
+		partial_length(format, rpb->rpb_last_field) : 0;
+
 	if (prior)
 	{
 		tail = differences;
@@ -1321,16 +1335,15 @@ void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
 	else
 	{
 		tail = record->getData();
-		tail_end = tail + record->getLength();
+		tail_end = tail + (limit ? limit : record->getLength());
 	}
 
-	// Set up prior record point for next version
-
-	rpb->rpb_prior = (rpb->rpb_b_page && (rpb->rpb_flags & rpb_delta)) ? record : NULL;
-
 	// Snarf data from record
 
-	tail = Compressor::unpack(rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+	if (limit)
+		tail = unpackRecordPrefix(rpb->rpb_flags, rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+	else
+		tail = unpackRecord(rpb->rpb_flags, rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
 
 	RuntimeStatistics::Accumulator fragments(tdbb, relation, RuntimeStatistics::RECORD_FRAGMENT_READS);
 
@@ -1340,10 +1353,15 @@ void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
 		const USHORT back_line = rpb->rpb_b_line;
 		const USHORT save_flags = rpb->rpb_flags;
 
-		while (rpb->rpb_flags & rpb_incomplete)
+		while ((rpb->rpb_flags & rpb_incomplete) && !(limit && tail == tail_end))
 		{
 			DPM_fetch_fragment(tdbb, rpb, LCK_read);
-			tail = Compressor::unpack(rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+
+			if (limit)
+				tail = Compressor::unpackPrefix(rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+			else
+				tail = Compressor::unpack(rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+
 			++fragments;
 		}
 
@@ -1366,7 +1384,7 @@ void VIO_data(thread_db* tdbb, record_param* rpb, MemoryPool* pool)
 		length = tail - record->getData();
 	}
 
-	if (format->fmt_length != length)
+	if ((limit ? limit : format->fmt_length) != length)
 	{
 #ifdef VIO_DEBUG
 		VIO_trace(DEBUG_WRITES,
@@ -2126,7 +2144,7 @@ bool VIO_get(thread_db* tdbb, record_param* rpb, jrd_tra* transaction, MemoryPoo
 			rpb->rpb_length = 0;
 		}
 		else
-			VIO_data(tdbb, rpb, pool);
+			VIO_data(tdbb, rpb, pool, (rpb->rpb_stream_flags & RPB_s_partial) != 0);
 	}
 
 	tdbb->bumpRelStats(RuntimeStatistics::RECORD_IDX_READS, rpb->rpb_relation->rel_id);
@@ -2949,7 +2967,7 @@ bool VIO_next_record(thread_db* tdbb,
 			rpb->rpb_length = 0;
 		}
 		else
-			VIO_data(tdbb, rpb, pool);
+			VIO_data(tdbb, rpb, pool, (rpb->rpb_stream_flags & RPB_s_partial) != 0);
 	}
 
 #ifdef VIO_DEBUG
@@ -4016,7 +4034,7 @@ static void delete_record(thread_db* tdbb, record_param* rpb, ULONG prior_page,
 			tail_end = tail + record->getLength();
 		}
 
-		tail = Compressor::unpack(rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
+		tail = unpackRecord(rpb->rpb_flags, rpb->rpb_length, rpb->rpb_address, tail_end - tail, tail);
 		rpb->rpb_prior = (rpb->rpb_flags & rpb_delta) ? record : 0;
 	}
 
@@ -5045,6 +5063,42 @@ static void notify_garbage_collector(thread_db* tdbb, record_param* rpb, TraNumb
 }
 
 
+static ULONG partial_length(const Format* format, USHORT last_field)
+{
+/**************************************
+ *
+ *	p a r t i a l _ l e n g t h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return the length of the leading part of the record that contains
+ *	the null flags and all fields up to the given one, or zero if the
+ *	whole record is needed anyway.
+ *
+ **************************************/
+	if (last_field + 1 >= format->fmt_count)
+		return 0;
+
+	// Fields are laid out in order of their ids, computed ones take no space
+
+	ULONG length = FLAG_BYTES(format->fmt_count);
+
+	for (USHORT id = last_field + 1; id--;)
+	{
+		const dsc& desc = format->fmt_desc[id];
+
+		if (desc.dsc_dtype && desc.dsc_address)
+		{
+			length = (ULONG) (IPTR) desc.dsc_address + desc.dsc_length;
+			break;
+		}
+	}
+
+	return (length < format->fmt_length) ? length : 0;
+}
+
+
 static int prepare_update(	thread_db*		tdbb,
 							jrd_tra*		transaction,
 							TraNumber		commit_tid_read,
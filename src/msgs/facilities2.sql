@@ -6,19 +6,19 @@ set bulk_insert INSERT INTO FACILITIES (LAST_CHANGE, FACILITY, FAC_CODE, MAX_NUM
 ('2015-01-07 18:01:51', 'GFIX', 3, 134)
 ('1996-11-07 13:39:40', 'GPRE', 4, 1)
 ('2017-02-05 20:37:00', 'DSQL', 7, 41)
-('2016-12-27 12:30:00', 'DYN', 8, 297)
+('2017-11-10 18:40:00', 'DYN', 8, 299)
 ('1996-11-07 13:39:40', 'INSTALL', 10, 1)
 ('1996-11-07 13:38:41', 'TEST', 11, 4)
-('2015-07-23 14:20:00', 'GBAK', 12, 370)
+('2015-07-23 14:20:00', 'GBAK', 12, 377)
 ('2015-08-05 12:40:00', 'SQLERR', 13, 1045)
 ('1996-11-07 13:38:42', 'SQLWARN', 14, 613)
 ('2006-09-10 03:04:31', 'JRD_BUGCHK', 15, 307)
 ('2016-05-26 13:53:45', 'ISQL', 17, 196)
 ('2010-07-10 10:50:30', 'GSEC', 18, 105)
-('2017-03-09 21:51:33', 'GSTAT', 21, 61)
+('2017-03-09 21:51:33', 'GSTAT', 21, 65)
 ('2013-12-19 17:31:31', 'FBSVCMGR', 22, 58)
 ('2009-07-18 12:12:12', 'UTL', 23, 2)
-('2016-03-20 15:30:00', 'NBACKUP', 24, 80)
+('2016-03-20 15:30:00', 'NBACKUP', 24, 83)
 ('2009-07-20 07:55:48', 'FBTRACEMGR', 25, 41)
 ('2015-07-27 00:00:00', 'JAYBIRD', 26, 1)
 stop
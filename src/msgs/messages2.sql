@@ -2071,6 +2071,8 @@ COMMIT WORK;
 (NULL, 'CreateAlterRoleNode::execute', 'DdlNodes.epp', NULL, 8, 294, NULL, 'Access to SYSTEM PRIVILEGES in ROLES denied to @1', NULL, NULL);
 (NULL, 'grant/revoke', 'DdlNode.epp', NULL, 8, 295, NULL, 'Only @1, DB owner @2 or user with privilege USE_GRANTED_BY_CLAUSE can use GRANTED BY clause', NULL, NULL);
 ('dyn_cant_use_zero_inc_ident', NULL, 'DdlNodes.epp', NULL, 8, 296, NULL, 'INCREMENT BY 0 is an illegal option for identity column @1 of table @2', NULL, NULL);
+('dyn_trigram_index', 'CreateIndexNode::store', 'DdlNodes.epp', NULL, 8, 297, NULL, 'Trigram index @1 must be defined on a single CHAR or VARCHAR column and cannot be unique or descending', NULL, NULL);
+('dyn_ext_delimiter', 'CreateRelationNode::execute', 'DdlNodes.epp', NULL, 8, 298, NULL, 'Delimiter of external file must be a single ASCII character other than double quote or line break', NULL, NULL);
 COMMIT WORK;
 -- TEST
 (NULL, 'main', 'test.c', NULL, 11, 0, NULL, 'This is a modified text message', NULL, NULL);
@@ -2457,6 +2459,13 @@ ERROR: Backup incomplete', NULL, NULL);
 ('gbak_wrong_perf', 'api_gbak/gbak', 'burp.cpp', NULL, 12, 367, NULL, 'wrong char "@1" at statistics parameter', NULL, NULL);
 ('gbak_too_long_perf', 'api_gbak/gbak', 'burp.cpp', NULL, 12, 368, NULL, 'too many chars at statistics parameter', NULL, NULL);
 (NULL, 'api_gbak/gbak', 'burp.cpp', NULL, 12, 369, NULL, 'total statistics', NULL, NULL);
+(NULL, 'burp_usage', 'burp.cpp', NULL, 12, 370, NULL, '    @1PAR(ALLEL) <n>       number of workers to activate indices on restore', NULL, NULL);
+(NULL, 'BURP_gbak', 'burp.cpp', NULL, 12, 371, NULL, 'parallel workers parameter missing', NULL, NULL);
+(NULL, 'BURP_gbak', 'burp.cpp', NULL, 12, 372, NULL, 'expected number of parallel workers, encountered "@1"', NULL, NULL);
+(NULL, 'BURP_gbak', 'burp.cpp', NULL, 12, 373, NULL, 'parallel workers are allowed only on restore or create', NULL, NULL);
+(NULL, 'burp_usage', 'burp.cpp', NULL, 12, 374, NULL, '    @1ZIP                  compress backup file with zlib', NULL, NULL);
+(NULL, 'MVOL_init_write', 'mvol.cpp', NULL, 12, 375, NULL, 'zlib library is not available, backup file can not be compressed or decompressed', NULL, NULL);
+(NULL, 'mvol_read', 'mvol.cpp', NULL, 12, 376, NULL, 'compressed block is corrupted in backup file', NULL, NULL);
 -- SQLERR
 (NULL, NULL, NULL, NULL, 13, 1, NULL, 'Firebird error', NULL, NULL);
 (NULL, NULL, NULL, NULL, 13, 74, NULL, 'Rollback not performed', NULL, NULL);
@@ -3328,6 +3337,10 @@ Analyzing database pages ...', NULL, NULL);
 (NULL, 'main', 'dba.epp', NULL, 21, 58, NULL, 'Other pages: total @1, ENCRYPTED @2 (DB problem!), non-crypted @3', NULL, NULL)
 (NULL, 'main', 'dba.epp', NULL, 21, 59, NULL, 'Gstat execution time @1', NULL, NULL)
 (NULL, 'main', 'dba.epp', NULL, 21, 60, NULL, 'Gstat completion time @1', NULL, NULL)
+(NULL, 'dba_in_sw_table', 'dbaswi.h', NULL, 21, 61, NULL, '    -par    number of threads reading pages in parallel', NULL, NULL);
+(NULL, 'dba_in_sw_table', 'dbaswi.h', NULL, 21, 62, NULL, '    -sa     percent of data pages and index leaf buckets to analyze', NULL, NULL);
+(NULL, 'main', 'dba.epp', NULL, 21, 63, NULL, 'option -sa needs a percentage from 1 to 100', NULL, NULL)
+(NULL, 'main', 'dba.epp', NULL, 21, 64, NULL, 'option -par needs a positive number of threads', NULL, NULL)
 -- FBSVCMGR
 -- All messages use the new format.
 ('fbsvcmgr_bad_am', 'putAccessMode', 'fbsvcmgr.cpp', NULL, 22, 1, NULL, 'Wrong value for access mode', NULL, NULL);
@@ -3471,6 +3484,9 @@ Analyzing database pages ...', NULL, NULL);
 ('nbackup_lostrec_guid_db', 'NBackup::backup_database', 'nbackup.cpp', NULL, 24, 77, NULL, 'Cannot find record for database "@1" backup GUID @2 in the backup history', NULL, NULL)
 (NULL, 'usage', 'nbackup.cpp', NULL, 24, 78, NULL, '  -I(NPLACE)                             Restore incremental backup(s) to existing database', NULL, NULL)
 (NULL, 'usage', 'nbackup.cpp', NULL, 24, 79, NULL, '  -INPLACE option could corrupt the database that has changed since previous restore', NULL, NULL)
+(NULL, 'usage', 'nbackup.cpp', NULL, 24, 80, NULL, '  -ZIP                                   Compress backup file with zlib', NULL, NULL)
+('nbackup_zip_unavailable', 'BackupZip::BackupZip', 'nbackup.cpp', NULL, 24, 81, NULL, 'zlib library is not available, compressed backup file can not be processed', NULL, NULL)
+('nbackup_zip_corrupted', 'NBackup::read_block', 'nbackup.cpp', NULL, 24, 82, NULL, 'Compressed block @1 is corrupted in backup file @2', NULL, NULL)
 -- FBTRACEMGR
 -- All messages use the new format.
 (NULL, 'usage', 'TraceCmdLine.cpp', NULL, 25, 1, NULL, 'Firebird Trace Manager version @1', NULL, NULL)
@@ -1037,6 +1037,8 @@ set bulk_insert INSERT INTO SYSTEM_ERRORS (SQL_CODE, SQL_CLASS, SQL_SUBCLASS, FA
 (-901, '42', '000', 8, 289, 'dyn_cant_use_in_foreignkey', NULL, NULL)
 (-901, '42', '000', 8, 290, 'dyn_defvaldecl_package_func', NULL, NULL)
 (-901, '42', '000', 8, 296, 'dyn_cant_use_zero_inc_ident', NULL, NULL)
+(-607, '42', '000', 8, 297, 'dyn_trigram_index', NULL, NULL)
+(-607, '42', '000', 8, 298, 'dyn_ext_delimiter', NULL, NULL)
 --  GBAK
 (-901, '00', '000', 12, 1, 'gbak_unknown_switch', NULL, NULL)
 (-901, '00', '000', 12, 2, 'gbak_page_size_missing', NULL, NULL)
@@ -1366,6 +1368,8 @@ COMMIT WORK;
 (-901, '08', '006', 24, 73, 'nbackup_user_stop', NULL, NULL)
 (-901, '54', '023', 24, 75, 'nbackup_deco_parse', NULL, NULL)
 (-901, '00', '000', 24, 77, 'nbackup_lostrec_guid_db', NULL, NULL)
+(-901, '00', '000', 24, 81, 'nbackup_zip_unavailable', NULL, NULL)
+(-901, '00', '000', 24, 82, 'nbackup_zip_corrupted', NULL, NULL)
 -- FBTRACEMGR
 (-901, '00', '000', 25, 30, 'trace_conflict_acts', NULL, NULL)
 (-901, '00', '000', 25, 31, 'trace_act_notfound', NULL, NULL)
@@ -0,0 +1,229 @@
+/*
+ *	PROGRAM:		Firebird database encryption.
+ *	MODULE:			AesXts.cpp
+ *	DESCRIPTION:	AES-XTS database crypt plugin.
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#include "firebird.h"
+#include "firebird/Interface.h"
+
+#include "../common/classes/ImplementHelper.h"
+#include "../common/StatusArg.h"
+#include "gen/iberror.h"
+#include "Xts.h"
+
+using namespace Firebird;
+using namespace Crypt;
+
+// Data is encrypted with AES in XTS mode (IEEE 1619), the engine passes page
+// number as a tweak. Key is requested from key holder plugins: 32 bytes long
+// key selects AES-128, 64 bytes long - AES-256. First half of it is used to
+// encrypt data, second one - to encrypt tweaks.
+// When processor supports AES instructions they are used directly, otherwise
+// (and for data units not aligned to AES block) libtomcrypt does the job.
+// Both produce the same crypt text, therefore a database may be moved between
+// hosts freely.
+
+namespace
+{
+
+class AesXts FB_FINAL : public StdPlugin<IDbCryptPluginImpl<AesXts, CheckStatusWrapper> >
+{
+public:
+	explicit AesXts(IPluginConfig*)
+		: keyLength(0)
+#ifdef FB_CPU_SSE2
+		  , useAesNi(cpuSupportsAESNI())
+#endif
+	{ }
+
+	~AesXts()
+	{
+		if (keyLength)
+		{
+			tom.wipe();
+#ifdef FB_CPU_SSE2
+			aesNi.wipe();
+#endif
+		}
+	}
+
+	// IDbCryptPlugin implementation
+	void setKey(CheckStatusWrapper* status, unsigned int length, IKeyHolderPlugin** sources,
+		const char* keyName);
+	void encrypt(CheckStatusWrapper* status, unsigned int length, const void* from, void* to);
+	void decrypt(CheckStatusWrapper* status, unsigned int length, const void* from, void* to);
+	void setInfo(CheckStatusWrapper* status, IDbCryptInfo* info);
+	void encryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+		const ISC_INT64* tweaks, const void* from, void* to);
+	void decryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+		const ISC_INT64* tweaks, const void* from, void* to);
+	int release();
+
+private:
+	void crypt(CheckStatusWrapper* status, bool encrypting, unsigned count, unsigned length,
+		const ISC_INT64* tweaks, const void* from, void* to);
+
+	unsigned keyLength;
+	TomXts tom;
+#ifdef FB_CPU_SSE2
+	AesNiXts aesNi;
+	bool useAesNi;
+#endif
+};
+
+int AesXts::release()
+{
+	if (--refCounter == 0)
+	{
+		delete this;
+		return 0;
+	}
+	return 1;
+}
+
+void AesXts::setKey(CheckStatusWrapper* status, unsigned int length, IKeyHolderPlugin** sources,
+	const char* keyName)
+{
+	status->init();
+
+	if (keyLength)
+		return;
+
+	UCHAR key[MAX_KEY_LENGTH];
+
+	try
+	{
+		for (unsigned n = 0; n < length; ++n)
+		{
+			ICryptKeyCallback* callback = sources[n]->keyHandle(status, keyName);
+			if (status->getState() & IStatus::STATE_ERRORS)
+				return;
+
+			if (!callback)
+				continue;
+
+			const unsigned l = callback->callback(0, NULL, sizeof(key), key);
+			if (l != MAX_KEY_LENGTH / 2 && l != MAX_KEY_LENGTH)
+				continue;
+
+			tom.setKey(l, key);
+#ifdef FB_CPU_SSE2
+			if (useAesNi)
+				aesNi.setKey(l, key);
+#endif
+			memset(key, 0, sizeof(key));
+			keyLength = l;
+			return;
+		}
+
+		(Arg::Gds(isc_bad_crypt_key) << keyName).raise();
+	}
+	catch (const Exception& ex)
+	{
+		memset(key, 0, sizeof(key));
+		ex.stuffException(status);
+	}
+}
+
+void AesXts::setInfo(CheckStatusWrapper* status, IDbCryptInfo*)
+{
+	status->init();
+}
+
+void AesXts::encrypt(CheckStatusWrapper* status, unsigned int length, const void* from, void* to)
+{
+	crypt(status, true, 1, length, NULL, from, to);
+}
+
+void AesXts::decrypt(CheckStatusWrapper* status, unsigned int length, const void* from, void* to)
+{
+	crypt(status, false, 1, length, NULL, from, to);
+}
+
+void AesXts::encryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+	const ISC_INT64* tweaks, const void* from, void* to)
+{
+	crypt(status, true, count, length, tweaks, from, to);
+}
+
+void AesXts::decryptBlocks(CheckStatusWrapper* status, unsigned int count, unsigned int length,
+	const ISC_INT64* tweaks, const void* from, void* to)
+{
+	crypt(status, false, count, length, tweaks, from, to);
+}
+
+void AesXts::crypt(CheckStatusWrapper* status, bool encrypting, unsigned count, unsigned length,
+	const ISC_INT64* tweaks, const void* from, void* to)
+{
+	status->init();
+
+	try
+	{
+		if (!keyLength)
+			(Arg::Gds(isc_random) << "AES-XTS crypt key is not set").raise();
+
+		if (length < AES_BLOCK)
+			(Arg::Gds(isc_random) << "AES-XTS data unit can't be shorter than 16 bytes").raise();
+
+		const UCHAR* f = static_cast<const UCHAR*>(from);
+		UCHAR* t = static_cast<UCHAR*>(to);
+
+		for (unsigned n = 0; n < count; ++n, f += length, t += length)
+		{
+			const ISC_INT64 tweak = tweaks ? tweaks[n] : 0;
+
+#ifdef FB_CPU_SSE2
+			if (useAesNi && length % AES_BLOCK == 0)
+			{
+				if (encrypting)
+					aesNi.encrypt(length, tweak, f, t);
+				else
+					aesNi.decrypt(length, tweak, f, t);
+				continue;
+			}
+#endif
+
+			if (encrypting)
+				tom.encrypt(length, tweak, f, t);
+			else
+				tom.decrypt(length, tweak, f, t);
+		}
+	}
+	catch (const Exception& ex)
+	{
+		ex.stuffException(status);
+	}
+}
+
+SimpleFactory<AesXts> factory;
+
+} // anonymous namespace
+
+
+extern "C" void FB_EXPORTED FB_PLUGIN_ENTRY_POINT(IMaster* master)
+{
+	CachedMasterInterface::set(master);
+	PluginManagerInterfacePtr()->registerPluginFactory(IPluginManager::TYPE_DB_CRYPT, "AesXts", &factory);
+	getUnloadDetector()->registerMe();
+}
@@ -0,0 +1,334 @@
+/*
+ *	PROGRAM:		Firebird database encryption.
+ *	MODULE:			Xts.h
+ *	DESCRIPTION:	AES-XTS implementations.
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ */
+
+#ifndef CRYPT_AES_XTS_H
+#define CRYPT_AES_XTS_H
+
+#include "../common/classes/CpuFeatures.h"
+#include "../common/StatusArg.h"
+#include "gen/iberror.h"
+
+#if !defined(__GNUC__) || defined(__clang__)
+#define LTC_NO_ASM	// disable ASM in tomcrypt headers
+#endif
+#include <tomcrypt.h>
+
+namespace Crypt {
+
+const unsigned AES_BLOCK = 16;
+const unsigned MAX_KEY_LENGTH = 64;
+const unsigned MAX_ROUNDS = 14;
+
+inline void tomCheck(int rc)
+{
+	if (rc != CRYPT_OK)
+		(Firebird::Arg::Gds(isc_random) << error_to_string(rc)).raise();
+}
+
+// Portable implementation
+
+class TomXts
+{
+public:
+	void setKey(unsigned keyLength, const UCHAR* key)
+	{
+		const int cipher = register_cipher(&aes_desc);
+		if (cipher < 0)
+			tomCheck(CRYPT_INVALID_CIPHER);
+
+		const unsigned half = keyLength / 2;
+		tomCheck(xts_start(cipher, key, key + half, half, 0, &xts));
+	}
+
+	void wipe()
+	{
+		xts_done(&xts);
+		memset(&xts, 0, sizeof(xts));
+	}
+
+	void encrypt(unsigned length, ISC_INT64 tweak, const UCHAR* from, UCHAR* to)
+	{
+		UCHAR t[AES_BLOCK];
+		makeTweak(t, tweak);
+		tomCheck(xts_encrypt(from, length, to, t, &xts));
+	}
+
+	void decrypt(unsigned length, ISC_INT64 tweak, const UCHAR* from, UCHAR* to)
+	{
+		UCHAR t[AES_BLOCK];
+		makeTweak(t, tweak);
+		tomCheck(xts_decrypt(from, length, to, t, &xts));
+	}
+
+private:
+	symmetric_xts xts;
+
+	// Tweak is little endian 128-bit number
+	static void makeTweak(UCHAR* t, FB_UINT64 tweak)
+	{
+		for (unsigned n = 0; n < AES_BLOCK; ++n)
+		{
+			t[n] = (UCHAR) tweak;
+			tweak >>= 8;
+		}
+	}
+};
+
+#ifdef FB_CPU_SSE2
+
+// AES-NI implementation. Up to 4 blocks are processed at once to keep
+// the pipeline of AES unit busy.
+
+FB_TARGET_AESNI inline __m128i expandKey(__m128i key, __m128i assist)
+{
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	return _mm_xor_si128(key, assist);
+}
+
+// Next tweak - multiplication by x in GF(2^128)
+FB_TARGET_AESNI inline __m128i nextTweak(__m128i t)
+{
+	const __m128i feedback = _mm_set_epi32(1, 1, 1, 0x87);
+	const __m128i carry = _mm_and_si128(_mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x93), feedback);
+	return _mm_xor_si128(_mm_slli_epi32(t, 1), carry);
+}
+
+class AesNiXts
+{
+public:
+	FB_TARGET_AESNI void setKey(unsigned keyLength, const UCHAR* key)
+	{
+		__m128i k[MAX_ROUNDS + 1];
+		const unsigned half = keyLength / 2;
+
+		rounds = expand(half, key, k);
+		store(dataEnc, k);
+
+		__m128i d[MAX_ROUNDS + 1];
+		d[0] = k[rounds];
+		for (unsigned r = 1; r < rounds; ++r)
+			d[r] = _mm_aesimc_si128(k[rounds - r]);
+		d[rounds] = k[0];
+		store(dataDec, d);
+
+		expand(half, key + half, k);
+		store(tweakEnc, k);
+
+		memset(k, 0, sizeof(k));
+		memset(d, 0, sizeof(d));
+	}
+
+	void wipe()
+	{
+		memset(dataEnc, 0, sizeof(dataEnc));
+		memset(dataDec, 0, sizeof(dataDec));
+		memset(tweakEnc, 0, sizeof(tweakEnc));
+	}
+
+	FB_TARGET_AESNI void encrypt(unsigned length, ISC_INT64 tweak, const UCHAR* from, UCHAR* to) const
+	{
+		__m128i k[MAX_ROUNDS + 1];
+		load(k, dataEnc);
+		__m128i t = firstTweak(tweak);
+
+		unsigned blocks = length / AES_BLOCK;
+		for (; blocks >= 4; blocks -= 4, from += 4 * AES_BLOCK, to += 4 * AES_BLOCK)
+		{
+			const __m128i t1 = nextTweak(t);
+			const __m128i t2 = nextTweak(t1);
+			const __m128i t3 = nextTweak(t2);
+
+			__m128i b0 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 0), t), k[0]);
+			__m128i b1 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 1), t1), k[0]);
+			__m128i b2 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 2), t2), k[0]);
+			__m128i b3 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 3), t3), k[0]);
+
+			for (unsigned r = 1; r < rounds; ++r)
+			{
+				b0 = _mm_aesenc_si128(b0, k[r]);
+				b1 = _mm_aesenc_si128(b1, k[r]);
+				b2 = _mm_aesenc_si128(b2, k[r]);
+				b3 = _mm_aesenc_si128(b3, k[r]);
+			}
+
+			storeBlock(to, 0, _mm_xor_si128(_mm_aesenclast_si128(b0, k[rounds]), t));
+			storeBlock(to, 1, _mm_xor_si128(_mm_aesenclast_si128(b1, k[rounds]), t1));
+			storeBlock(to, 2, _mm_xor_si128(_mm_aesenclast_si128(b2, k[rounds]), t2));
+			storeBlock(to, 3, _mm_xor_si128(_mm_aesenclast_si128(b3, k[rounds]), t3));
+
+			t = nextTweak(t3);
+		}
+
+		for (; blocks; --blocks, from += AES_BLOCK, to += AES_BLOCK)
+		{
+			__m128i b = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 0), t), k[0]);
+			for (unsigned r = 1; r < rounds; ++r)
+				b = _mm_aesenc_si128(b, k[r]);
+			storeBlock(to, 0, _mm_xor_si128(_mm_aesenclast_si128(b, k[rounds]), t));
+
+			t = nextTweak(t);
+		}
+	}
+
+	FB_TARGET_AESNI void decrypt(unsigned length, ISC_INT64 tweak, const UCHAR* from, UCHAR* to) const
+	{
+		__m128i k[MAX_ROUNDS + 1];
+		load(k, dataDec);
+		__m128i t = firstTweak(tweak);
+
+		unsigned blocks = length / AES_BLOCK;
+		for (; blocks >= 4; blocks -= 4, from += 4 * AES_BLOCK, to += 4 * AES_BLOCK)
+		{
+			const __m128i t1 = nextTweak(t);
+			const __m128i t2 = nextTweak(t1);
+			const __m128i t3 = nextTweak(t2);
+
+			__m128i b0 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 0), t), k[0]);
+			__m128i b1 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 1), t1), k[0]);
+			__m128i b2 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 2), t2), k[0]);
+			__m128i b3 = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 3), t3), k[0]);
+
+			for (unsigned r = 1; r < rounds; ++r)
+			{
+				b0 = _mm_aesdec_si128(b0, k[r]);
+				b1 = _mm_aesdec_si128(b1, k[r]);
+				b2 = _mm_aesdec_si128(b2, k[r]);
+				b3 = _mm_aesdec_si128(b3, k[r]);
+			}
+
+			storeBlock(to, 0, _mm_xor_si128(_mm_aesdeclast_si128(b0, k[rounds]), t));
+			storeBlock(to, 1, _mm_xor_si128(_mm_aesdeclast_si128(b1, k[rounds]), t1));
+			storeBlock(to, 2, _mm_xor_si128(_mm_aesdeclast_si128(b2, k[rounds]), t2));
+			storeBlock(to, 3, _mm_xor_si128(_mm_aesdeclast_si128(b3, k[rounds]), t3));
+
+			t = nextTweak(t3);
+		}
+
+		for (; blocks; --blocks, from += AES_BLOCK, to += AES_BLOCK)
+		{
+			__m128i b = _mm_xor_si128(_mm_xor_si128(loadBlock(from, 0), t), k[0]);
+			for (unsigned r = 1; r < rounds; ++r)
+				b = _mm_aesdec_si128(b, k[r]);
+			storeBlock(to, 0, _mm_xor_si128(_mm_aesdeclast_si128(b, k[rounds]), t));
+
+			t = nextTweak(t);
+		}
+	}
+
+private:
+	// Round keys are kept unaligned - plugin instance may be allocated
+	// with less than 16 bytes alignment
+	UCHAR dataEnc[(MAX_ROUNDS + 1) * AES_BLOCK];
+	UCHAR dataDec[(MAX_ROUNDS + 1) * AES_BLOCK];
+	UCHAR tweakEnc[(MAX_ROUNDS + 1) * AES_BLOCK];
+	unsigned rounds;
+
+	FB_TARGET_AESNI static __m128i loadBlock(const UCHAR* p, unsigned n)
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + n * AES_BLOCK));
+	}
+
+	FB_TARGET_AESNI static void storeBlock(UCHAR* p, unsigned n, __m128i b)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p + n * AES_BLOCK), b);
+	}
+
+	FB_TARGET_AESNI void load(__m128i* k, const UCHAR* keys) const
+	{
+		for (unsigned r = 0; r <= rounds; ++r)
+			k[r] = loadBlock(keys, r);
+	}
+
+	FB_TARGET_AESNI void store(UCHAR* keys, const __m128i* k) const
+	{
+		for (unsigned r = 0; r <= rounds; ++r)
+			storeBlock(keys, r, k[r]);
+	}
+
+	FB_TARGET_AESNI __m128i firstTweak(ISC_INT64 tweak) const
+	{
+		__m128i k[MAX_ROUNDS + 1];
+		load(k, tweakEnc);
+
+		__m128i t = _mm_xor_si128(_mm_set_epi64x(0, tweak), k[0]);
+		for (unsigned r = 1; r < rounds; ++r)
+			t = _mm_aesenc_si128(t, k[r]);
+		return _mm_aesenclast_si128(t, k[rounds]);
+	}
+
+	// Returns number of rounds
+	FB_TARGET_AESNI static unsigned expand(unsigned keyLength, const UCHAR* key, __m128i* k)
+	{
+		k[0] = loadBlock(key, 0);
+
+		if (keyLength == 16)
+		{
+#define AES128_KEY(n, rcon) \
+	k[n] = expandKey(k[n - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k[n - 1], rcon), 0xff))
+
+			AES128_KEY(1, 0x01);
+			AES128_KEY(2, 0x02);
+			AES128_KEY(3, 0x04);
+			AES128_KEY(4, 0x08);
+			AES128_KEY(5, 0x10);
+			AES128_KEY(6, 0x20);
+			AES128_KEY(7, 0x40);
+			AES128_KEY(8, 0x80);
+			AES128_KEY(9, 0x1b);
+			AES128_KEY(10, 0x36);
+#undef AES128_KEY
+
+			return 10;
+		}
+
+		fb_assert(keyLength == 32);
+		k[1] = loadBlock(key, 1);
+
+#define AES256_KEY(n, rcon) \
+	k[n] = expandKey(k[n - 2], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k[n - 1], rcon), 0xff)); \
+	if (n < MAX_ROUNDS) \
+		k[n + 1] = expandKey(k[n - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k[n], 0), 0xaa))
+
+		AES256_KEY(2, 0x01);
+		AES256_KEY(4, 0x02);
+		AES256_KEY(6, 0x04);
+		AES256_KEY(8, 0x08);
+		AES256_KEY(10, 0x10);
+		AES256_KEY(12, 0x20);
+		AES256_KEY(14, 0x40);
+#undef AES256_KEY
+
+		return MAX_ROUNDS;
+	}
+};
+
+#endif // FB_CPU_SSE2
+
+} // namespace Crypt
+
+#endif // CRYPT_AES_XTS_H
@@ -0,0 +1,247 @@
+/*
+ *	PROGRAM:		Firebird database encryption.
+ *	MODULE:			xts_test.cpp
+ *	DESCRIPTION:	Tests for AES-XTS implementations
+ *
+ *  The contents of this file are subject to the Initial
+ *  Developer's Public License Version 1.0 (the "License");
+ *  you may not use this file except in compliance with the
+ *  License. You may obtain a copy of the License at
+ *  http://www.ibphoenix.com/main.nfs?a=ibphoenix&page=ibp_idpl.
+ *
+ *  Software distributed under the License is distributed AS IS,
+ *  WITHOUT WARRANTY OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing rights
+ *  and limitations under the License.
+ *
+ *  The Original Code was created by the Firebird Project
+ *  for the Firebird Open Source RDBMS project.
+ *
+ *  Copyright (c) 2026 The Firebird Project
+ *  and all contributors signed below.
+ *
+ *  All Rights Reserved.
+ *  Contributor(s): ______________________________________.
+ *
+ *
+ */
+
+#include "firebird.h"
+#include "../plugins/crypt/aes/Xts.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Firebird;
+using namespace Crypt;
+
+// IEEE 1619-2007 test vectors: key (data key followed by tweak key),
+// data unit sequence number, plain text and cipher text
+struct XtsVector
+{
+	const char* key;
+	ISC_INT64 tweak;
+	const char* plain;
+	const char* cipher;
+};
+
+static const XtsVector vectors[] =
+{
+	// Vector 1, 32 bytes
+	{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		0,
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e"
+	},
+	// Vector 2, 32 bytes
+	{
+		"1111111111111111111111111111111122222222222222222222222222222222",
+		QUADCONST(0x3333333333),
+		"4444444444444444444444444444444444444444444444444444444444444444",
+		"c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"
+	},
+	// Vector 5, 32 bytes
+	{
+		"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+		QUADCONST(0x123456789a),
+		"4444444444444444444444444444444444444444444444444444444444444444",
+		"b01f86f8edc1863706fa8a4253e34f28af319de38334870f4dd1f94cbe9832f1"
+	},
+	// Vector 4, 512 bytes
+	{
+		"2718281828459045235360287471352631415926535897932384626433832795",
+		0,
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+		"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+		"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+		"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+		"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+		"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+		"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+		"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+		"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+		"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+		"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+		"27a7479befa1d476489f308cd4cfa6e2a96e4bbe3208ff25287dd3819616e89c"
+		"c78cf7f5e543445f8333d8fa7f56000005279fa5d8b5e4ad40e736ddb4d35412"
+		"328063fd2aab53e5ea1e0a9f332500a5df9487d07a5c92cc512c8866c7e860ce"
+		"93fdf166a24912b422976146ae20ce846bb7dc9ba94a767aaef20c0d61ad0265"
+		"5ea92dc4c4e41a8952c651d33174be51a10c421110e6d81588ede82103a252d8"
+		"a750e8768defffed9122810aaeb99f9172af82b604dc4b8e51bcb08235a6f434"
+		"1332e4ca60482a4ba1a03b3e65008fc5da76b70bf1690db4eae29c5f1badd03c"
+		"5ccf2a55d705ddcd86d449511ceb7ec30bf12b1fa35b913f9f747a8afd1b130e"
+		"94bff94effd01a91735ca1726acd0b197c4e5b03393697e126826fb6bbde8ecc"
+		"1e08298516e2c9ed03ff3c1b7860f6de76d4cecd94c8119855ef5297ca67e9f3"
+		"e7ff72b1e99785ca0a7e7720c5b36dc6d72cac9574c8cbbc2f801e23e56fd344"
+		"b07f22154beba0f08ce8891e643ed995c94d9a69c9f1b5f499027a78572aeebd"
+		"74d20cc39881c213ee770b1010e4bea718846977ae119f7a023ab58cca0ad752"
+		"afe656bb3c17256a9f6e9bf19fdd5a38fc82bbe872c5539edb609ef4f79c203e"
+		"bb140f2e583cb2ad15b4aa5b655016a8449277dbd477ef2c8d6c017db738b18d"
+		"eb4a427d1923ce3ff262735779a418f20a282df920147beabe421ee5319d0568"
+	},
+	// Vector 7, 17 bytes
+	{
+		"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+		QUADCONST(0x123456789a),
+		"000102030405060708090a0b0c0d0e0f10",
+		"6c1625db4671522d3d7599601de7ca09ed"
+	},
+	// Vector 15, 25 bytes
+	{
+		"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+		QUADCONST(0x123456789a),
+		"000102030405060708090a0b0c0d0e0f101112131415161718",
+		"8f4dcbad55558d7b4e01d9379cd4ea22edbf9dace45d6f6a73"
+	},
+	// Vector 21, 31 bytes
+	{
+		"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+		QUADCONST(0x123456789a),
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+		"d05bc090a8e04f1b3d3ecdd5baec0fd4edbf9dace45d6f6a7306e64be5dd82"
+	},
+	// Vector 10 (AES-256), first 32 bytes of 512
+	{
+		"27182818284590452353602874713526624977572470936999595749669676273141592653589793238462643383279502884197169399375105820974944592",
+		0xff,
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+		"1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b"
+	}
+};
+
+static unsigned fromHex(const char* hex, UCHAR* data)
+{
+	unsigned length = 0;
+
+	for (; hex[0] && hex[1]; hex += 2)
+	{
+		char byte[3] = {hex[0], hex[1], 0};
+		data[length++] = (UCHAR) strtoul(byte, NULL, 16);
+	}
+
+	return length;
+}
+
+// Encrypt and decrypt with the given implementation, compare with the vector
+template <typename Xts>
+static void check(Xts& xts, unsigned length, ISC_INT64 tweak, const UCHAR* plain, const UCHAR* cipher)
+{
+	UCHAR out[512];
+
+	memset(out, 0, sizeof(out));
+	xts.encrypt(length, tweak, plain, out);
+	assert(!memcmp(out, cipher, length));
+
+	memset(out, 0, sizeof(out));
+	xts.decrypt(length, tweak, cipher, out);
+	assert(!memcmp(out, plain, length));
+}
+
+int main()
+{
+#ifdef FB_CPU_SSE2
+	const bool aesNi = cpuSupportsAESNI();
+#endif
+
+	for (unsigned i = 0; i < FB_NELEM(vectors); i++)
+	{
+		const XtsVector& v = vectors[i];
+		UCHAR key[64], plain[512], cipher[512];
+
+		const unsigned keyLength = fromHex(v.key, key);
+		const unsigned length = fromHex(v.plain, plain);
+		assert(fromHex(v.cipher, cipher) == length);
+
+		TomXts tom;
+		tom.setKey(keyLength, key);
+		check(tom, length, v.tweak, plain, cipher);
+		tom.wipe();
+
+#ifdef FB_CPU_SSE2
+		// AES-NI path is used for data units aligned to AES block only
+		if (aesNi && length % AES_BLOCK == 0)
+		{
+			AesNiXts ni;
+			ni.setKey(keyLength, key);
+			check(ni, length, v.tweak, plain, cipher);
+			ni.wipe();
+		}
+#endif
+	}
+
+#ifdef FB_CPU_SSE2
+	// Both implementations produce the same result for database pages,
+	// including the tail of less than 4 blocks and large page numbers
+
+	if (aesNi)
+	{
+		const unsigned PAGE_SIZE = 8192 + 3 * AES_BLOCK;
+		UCHAR key[MAX_KEY_LENGTH];
+		UCHAR* const page = new UCHAR[PAGE_SIZE];
+		UCHAR* const out1 = new UCHAR[PAGE_SIZE];
+		UCHAR* const out2 = new UCHAR[PAGE_SIZE];
+
+		srand(1);
+
+		for (unsigned keyLength = MAX_KEY_LENGTH / 2; keyLength <= MAX_KEY_LENGTH; keyLength *= 2)
+		{
+			for (unsigned n = 0; n < keyLength; n++)
+				key[n] = (UCHAR) rand();
+			for (unsigned n = 0; n < PAGE_SIZE; n++)
+				page[n] = (UCHAR) rand();
+
+			TomXts tom;
+			tom.setKey(keyLength, key);
+			AesNiXts ni;
+			ni.setKey(keyLength, key);
+
+			const ISC_INT64 tweaks[] = {0, 1, 12345, QUADCONST(0x7fffffffffffffff)};
+
+			for (unsigned t = 0; t < FB_NELEM(tweaks); t++)
+			{
+				tom.encrypt(PAGE_SIZE, tweaks[t], page, out1);
+				ni.encrypt(PAGE_SIZE, tweaks[t], page, out2);
+				assert(!memcmp(out1, out2, PAGE_SIZE));
+
+				ni.decrypt(PAGE_SIZE, tweaks[t], out1, out2);
+				assert(!memcmp(out2, page, PAGE_SIZE));
+			}
+
+			tom.wipe();
+			ni.wipe();
+		}
+
+		delete[] out2;
+		delete[] out1;
+		delete[] page;
+	}
+#endif
+
+	return 0;
+}
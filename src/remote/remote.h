@@ -60,7 +60,7 @@
 #endif
 
 #ifdef WIRE_COMPRESS_SUPPORT
-#include <zlib.h>
+#include "../common/classes/zip.h"
 //#define COMPRESS_DEBUG 1
 #endif // WIRE_COMPRESS_SUPPORT
 
@@ -373,6 +373,7 @@ const SvcSwitches backupOptions[] =
 	{"bkp_non_transportable", putOption, 0, isc_spb_bkp_non_transportable, 0},
 	{"bkp_convert", putOption, 0, isc_spb_bkp_convert, 0},
 	{"bkp_no_triggers", putOption, 0, isc_spb_bkp_no_triggers, 0},
+	{"bkp_zip", putOption, 0, isc_spb_bkp_zip, 0},
 	{"verbint", putIntArgument, 0, isc_spb_verbint, 0},
 	{"bkp_skip_data", putStringArgument, 0, isc_spb_bkp_skip_data, 0},
 	{"bkp_stat", putStringArgument, 0, isc_spb_bkp_stat, 0 },
@@ -401,6 +402,7 @@ const SvcSwitches restoreOptions[] =
 	{"verbint", putIntArgument, 0, isc_spb_verbint, 0},
 	{"res_skip_data", putStringArgument, 0, isc_spb_res_skip_data, 0},
 	{"res_stat", putStringArgument, 0, isc_spb_res_stat, 0 },
+	{"res_parallel", putIntArgument, 0, isc_spb_res_parallel, 0},
 	{0, 0, 0, 0, 0}
 };
 
@@ -459,6 +461,8 @@ const SvcSwitches statisticsOptions[] =
 	{"sts_idx_pages", putOption, 0, isc_spb_sts_idx_pages, 0},
 	{"sts_sys_relations", putOption, 0, isc_spb_sts_sys_relations, 0},
 	{"sts_encryption", putOption, 0, isc_spb_sts_encryption, 0},
+	{"sts_sample", putIntArgument, 0, isc_spb_sts_sample, 0},
+	{"sts_parallel", putIntArgument, 0, isc_spb_sts_parallel, 0},
 	{0, 0, 0, 0, 0}
 };
 
@@ -501,6 +505,7 @@ const SvcSwitches nbackOptions[] =
 	{"nbk_guid", putStringArgument, 0, isc_spb_nbk_guid, 0},
 	{"nbk_no_triggers", putOption, 0, isc_spb_nbk_no_triggers, 0},
 	{"nbk_direct", putStringArgument, 0, isc_spb_nbk_direct, 0},
+	{"nbk_zip", putOption, 0, isc_spb_nbk_zip, 0},
 	{0, 0, 0, 0, 0}
 };
 
@@ -533,6 +538,7 @@ const SvcSwitches validateOptions[] =
 	{"val_idx_incl", putStringArgument, 0, isc_spb_val_idx_incl, 0},
 	{"val_idx_excl", putStringArgument, 0, isc_spb_val_idx_excl, 0},
 	{"val_lock_timeout", putIntArgument, 0, isc_spb_val_lock_timeout, 0},
+	{"val_parallel", putIntArgument, 0, isc_spb_val_parallel, 0},
 	{0, 0, 0, 0, 0}
 };
 
@@ -51,6 +51,8 @@ const int IN_SW_DBA_FETCH_PASS		= 14;	// fetch password from file
 const int IN_SW_DBA_ENCRYPTION		= 15;	// analyze pages encryption
 const int IN_SW_DBA_HELP			= 16;	// show help
 const int IN_SW_DBA_ROLE			= 17;	// SQL role
+const int IN_SW_DBA_PARALLEL		= 18;	// number of threads reading pages
+const int IN_SW_DBA_SAMPLE			= 19;	// percent of pages to analyze
 
 const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
 {
@@ -64,10 +66,12 @@ const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
     {IN_SW_DBA_USERNAME,		0,							"USERNAME",	0,0,0,	false,	false,	32,	1, NULL},	// msg 32: -u      username
     {IN_SW_DBA_PASSWORD,		0,							"PASSWORD",	0,0,0,	false,	false,	33,	1, NULL},	// msg 33: -p      password
     {IN_SW_DBA_FETCH_PASS,		0,					"FETCH_PASSWORD",	0,0,0,	false,	false,	37,	2, NULL},	// msg 37: -fetch  fetch password from file
+    {IN_SW_DBA_PARALLEL,		isc_spb_sts_parallel,		"PARALLEL",	0,0,0,	false,	false,	61,	3, NULL},	// msg 61: -par    number of threads reading pages in parallel
     {IN_SW_DBA_RECORD,			isc_spb_sts_record_versions,"RECORD",	0,0,0,	false,	true,	34,	1, NULL},	// msg 34: -r      analyze average record and version length
     {IN_SW_DBA_RELATION,		isc_spb_sts_table,			"TABLE",	0,0,0,	false,	false,	35,	1, NULL},	// msg 35: -t      tablename
     {IN_SW_DBA_RELATION,		isc_spb_sts_table,			"TABLE",	0,0,0,	false,	true,	0,	1, NULL},	// no msg: let run old buggy code
     {IN_SW_DBA_ROLE,			0,							"ROLE",		0,0,0,	false,	false,	57,	1, NULL},	// msg 57: -role   SQL role name
+    {IN_SW_DBA_SAMPLE,			isc_spb_sts_sample,			"SAMPLE",	0,0,0,	false,	false,	62,	2, NULL},	// msg 62: -sa     percent of data pages and index leaf buckets to analyze
 	// special switch to avoid including creation date, only for tests (no message)
     {IN_SW_DBA_NOCREATION,		isc_spb_sts_nocreation,	"NOCREATION",	0,0,0,	false,	true,	0,	1, NULL},	// msg (ignored) -n suppress creation date
 #ifdef TRUSTED_AUTH
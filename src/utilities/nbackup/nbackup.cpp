@@ -54,6 +54,9 @@
 #include "../common/StatusArg.h"
 #include "../common/classes/objects_array.h"
 #include "../common/os/os_utils.h"
+#include "../common/ThreadStart.h"
+#include "../common/classes/semaphore.h"
+#include "../common/classes/zip.h"
 
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -256,6 +259,153 @@ const char localhost[] = "localhost";
 const char backup_signature[4] = {'N','B','A','K'};
 const SSHORT BACKUP_VERSION = 2;
 
+// Size of chunk read from incremental backup at once during restore.
+// Two chunks are used: one is being read while another is written into database.
+const FB_SIZE_T RESTORE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+// Size of chunk read from database at once during backup
+const FB_SIZE_T BACKUP_CHUNK_SIZE = 1024 * 1024;
+
+// Compressed backup file (-ZIP) is a zip_header followed by regular backup file
+// contents, split into blocks of up to block_size bytes and compressed independently.
+// Block size is a multiple of any page size, so each block holds whole pages and
+// may be unpacked and applied apart from others. Every block is preceded by
+// zip_block, a block that can't be made shorter is stored as is. The stream is
+// finished by zip_block with zero length.
+const char zip_signature[4] = {'N','B','K','Z'};
+const SSHORT ZIP_VERSION = 1;
+const ULONG ZIP_BLOCK_SIZE = 1024 * 1024;
+
+struct zip_header
+{
+	char signature[4];		// 'NBKZ'
+	SSHORT version;			// Compressed stream format version
+	SSHORT reserved;
+	ULONG block_size;		// Maximum length of uncompressed block
+};
+
+struct zip_block
+{
+	ULONG length;			// Length of uncompressed data
+	ULONG packed;			// Length of stored data, equal to length if not compressed
+	ULONG crc;				// crc32 of uncompressed data
+};
+
+// zlib stream used to pack or unpack blocks of compressed backup
+class BackupZip
+{
+public:
+	explicit BackupZip(bool compress);
+	~BackupZip();
+
+	ULONG bound(ULONG length);
+	ULONG pack(const UCHAR* data, ULONG length, UCHAR* packed, ULONG space);
+	bool unpack(const UCHAR* packed, ULONG packedLength, UCHAR* data, ULONG length);
+	ULONG crc(const UCHAR* data, ULONG length);
+
+private:
+#ifdef HAVE_ZLIB_H
+	z_stream stream;
+#endif
+	bool compress;
+};
+
+#ifdef HAVE_ZLIB_H
+BackupZip::BackupZip(bool p_compress)
+	: compress(p_compress)
+{
+	if (!zlib())
+		status_exception::raise(Arg::Gds(isc_nbackup_zip_unavailable));
+
+	memset(&stream, 0, sizeof(stream));
+	stream.zalloc = ZLib::allocFunc;
+	stream.zfree = ZLib::freeFunc;
+	stream.opaque = Z_NULL;
+
+	const int ret = compress ?
+		zlib().deflateInit(&stream, Z_DEFAULT_COMPRESSION) : zlib().inflateInit(&stream);
+
+	if (ret != Z_OK)
+		status_exception::raise(Arg::Gds(isc_nbackup_zip_unavailable));
+}
+
+BackupZip::~BackupZip()
+{
+	if (compress)
+		zlib().deflateEnd(&stream);
+	else
+		zlib().inflateEnd(&stream);
+}
+
+ULONG BackupZip::bound(ULONG length)
+{
+	return compress ? zlib().deflateBound(&stream, length) : length;
+}
+
+// Returns length of packed data or zero when block doesn't get shorter
+ULONG BackupZip::pack(const UCHAR* data, ULONG length, UCHAR* packed, ULONG space)
+{
+	zlib().deflateReset(&stream);
+
+	stream.next_in = const_cast<Bytef*>(data);
+	stream.avail_in = length;
+	stream.next_out = packed;
+	stream.avail_out = space;
+
+	if (zlib().deflate(&stream, Z_FINISH) != Z_STREAM_END || stream.total_out >= length)
+		return 0;
+
+	return stream.total_out;
+}
+
+bool BackupZip::unpack(const UCHAR* packed, ULONG packedLength, UCHAR* data, ULONG length)
+{
+	zlib().inflateReset(&stream);
+
+	stream.next_in = const_cast<Bytef*>(packed);
+	stream.avail_in = packedLength;
+	stream.next_out = data;
+	stream.avail_out = length;
+
+	return zlib().inflate(&stream, Z_FINISH) == Z_STREAM_END && stream.total_out == length;
+}
+
+ULONG BackupZip::crc(const UCHAR* data, ULONG length)
+{
+	return zlib().crc32(0, data, length);
+}
+#else // HAVE_ZLIB_H
+BackupZip::BackupZip(bool p_compress)
+	: compress(p_compress)
+{
+	status_exception::raise(Arg::Gds(isc_nbackup_zip_unavailable));
+}
+
+BackupZip::~BackupZip()
+{
+}
+
+ULONG BackupZip::bound(ULONG length)
+{
+	return length;
+}
+
+ULONG BackupZip::pack(const UCHAR*, ULONG, UCHAR*, ULONG)
+{
+	return 0;
+}
+
+bool BackupZip::unpack(const UCHAR*, ULONG, UCHAR*, ULONG)
+{
+	return false;
+}
+
+ULONG BackupZip::crc(const UCHAR*, ULONG)
+{
+	return 0;
+}
+#endif // HAVE_ZLIB_H
+
 struct inc_header
 {
 	char signature[4];		// 'NBAK'
@@ -274,12 +424,14 @@ class NBackup
 {
 public:
 	NBackup(UtilSvc* _uSvc, const PathName& _database, const string& _username, const string& _role,
-			const string& _password, bool _run_db_triggers, bool _direct_io, const string& _deco)
+			const string& _password, bool _run_db_triggers, bool _direct_io, const string& _deco,
+			bool _zip)
 	  : uSvc(_uSvc), newdb(0), trans(0), database(_database),
 		username(_username), role(_role), password(_password),
 		run_db_triggers(_run_db_triggers), direct_io(_direct_io),
-		dbase(0), backup(0), decompress(_deco), childId(0), db_size_pages(0),
-		m_odsNumber(0), m_silent(false), m_printed(false)
+		dbase(0), backup(0), decompress(_deco), zip(_zip), zip_pos(0), zip_length(0),
+		zip_count(0), childId(0), db_size_pages(0), scan_data(NULL), scan_first(0),
+		scan_count(0), scan_size(0), m_odsNumber(0), m_silent(false), m_printed(false)
 	{
 		// Recognition of local prefix allows to work with
 		// database using TCP/IP loopback while reading file locally.
@@ -335,8 +487,20 @@ private:
 	FILE_HANDLE dbase;
 	FILE_HANDLE backup;
 	string decompress;
+	bool zip;						// compress backup being written
+	AutoPtr<BackupZip> zipper;		// set when compressed backup is written or read
+	Array<UCHAR> zip_data;			// uncompressed data of the current block
+	Array<UCHAR> zip_packed;		// compressed data of the current block
+	FB_SIZE_T zip_pos;				// bytes of zip_data written or consumed
+	FB_SIZE_T zip_length;			// bytes of zip_data available for reading
+	ULONG zip_count;				// number of blocks processed
 	int childId;
 	ULONG db_size_pages;	// In pages
+	Array<UCHAR> scan_buffer;		// chunk of database pages read at once
+	UCHAR* scan_data;				// its aligned start
+	ULONG scan_first;				// first page in chunk
+	ULONG scan_count;				// number of pages in chunk
+	ULONG scan_size;				// chunk capacity in pages
 	USHORT m_odsNumber;
 	bool m_silent;		// are we already handling an exception?
 	bool m_printed;		// pr_error() was called to print status vector
@@ -365,6 +529,24 @@ private:
 	void open_backup_scan();
 	void create_backup();
 	void close_backup();
+
+	// Backup file contents, compressed or not
+	bool open_backup_stream();
+	FB_SIZE_T read_backup(void* buffer, FB_SIZE_T bufsize);
+	void write_backup(const void* buffer, FB_SIZE_T bufsize);
+	void finish_backup();
+	bool read_block();
+	void write_block();
+
+	// Database pages are read in large chunks
+	void init_scan(ULONG page_size);
+	FB_SIZE_T read_page(ULONG page, ULONG span, ULONG page_size, void* buffer);
+
+	// Apply pages of incremental backup to database
+	struct ApplyChunks;
+	void apply_backup(ULONG page_size);
+	void write_pages(const UCHAR* buffer, FB_SIZE_T count, ULONG page_size);
+	static THREAD_ENTRY_DECLARE apply_thread(THREAD_ENTRY_PARAM arg);
 };
 
 
@@ -709,6 +891,8 @@ void NBackup::create_backup()
 
 void NBackup::close_backup()
 {
+	zipper.reset(NULL);
+
 	if (bakname == "stdout")
 		return;
 #ifdef WIN_NT
@@ -723,6 +907,188 @@ void NBackup::close_backup()
 #endif
 }
 
+// Check if backup file just opened is compressed. Returns true when it is.
+bool NBackup::open_backup_stream()
+{
+	zipper.reset(NULL);
+	zip_pos = zip_length = 0;
+	zip_count = 0;
+
+	zip_header zh;
+	const FB_SIZE_T bytesDone = read_file(backup, &zh, sizeof(zh));
+
+	if (bytesDone == sizeof(zh) &&
+		memcmp(zh.signature, zip_signature, sizeof(zip_signature)) == 0 &&
+		zh.version == ZIP_VERSION)
+	{
+		zipper.reset(FB_NEW_POOL(*getDefaultMemoryPool()) BackupZip(false));
+		zip_data.getBuffer(zh.block_size);
+		zip_packed.getBuffer(zh.block_size);
+		return true;
+	}
+
+	// Not compressed, return read bytes as the first part of backup
+	memcpy(zip_data.getBuffer(bytesDone), &zh, bytesDone);
+	zip_length = bytesDone;
+	return false;
+}
+
+FB_SIZE_T NBackup::read_backup(void* buffer, FB_SIZE_T bufsize)
+{
+	FB_SIZE_T rc = 0;
+	while (rc < bufsize)
+	{
+		if (zip_pos < zip_length)
+		{
+			const FB_SIZE_T length = MIN(bufsize - rc, zip_length - zip_pos);
+			memcpy(static_cast<UCHAR*>(buffer) + rc, zip_data.begin() + zip_pos, length);
+			zip_pos += length;
+			rc += length;
+			continue;
+		}
+
+		if (!zipper)
+		{
+			rc += read_file(backup, static_cast<UCHAR*>(buffer) + rc, bufsize - rc);
+			break;
+		}
+
+		if (!read_block())
+			break;
+	}
+
+	return rc;
+}
+
+bool NBackup::read_block()
+{
+	zip_block block;
+	if (read_file(backup, &block, sizeof(block)) != sizeof(block))
+		status_exception::raise(Arg::Gds(isc_nbackup_err_eofbk) << bakname.c_str());
+
+	zip_pos = zip_length = 0;
+	if (!block.length)
+		return false;
+
+	zip_count++;
+	if (block.length > zip_packed.getCount() || block.packed > block.length)
+	{
+		status_exception::raise(Arg::Gds(isc_nbackup_zip_corrupted) <<
+			Arg::Num(zip_count) << bakname.c_str());
+	}
+
+	UCHAR* const data = zip_data.getBuffer(block.length);
+	UCHAR* const packed = block.packed < block.length ? zip_packed.begin() : data;
+
+	if (read_file(backup, packed, block.packed) != block.packed)
+		status_exception::raise(Arg::Gds(isc_nbackup_err_eofbk) << bakname.c_str());
+
+	if ((packed != data && !zipper->unpack(packed, block.packed, data, block.length)) ||
+		zipper->crc(data, block.length) != block.crc)
+	{
+		status_exception::raise(Arg::Gds(isc_nbackup_zip_corrupted) <<
+			Arg::Num(zip_count) << bakname.c_str());
+	}
+
+	zip_length = block.length;
+	return true;
+}
+
+void NBackup::write_backup(const void* buffer, FB_SIZE_T bufsize)
+{
+	if (!zip)
+	{
+		write_file(backup, const_cast<void*>(buffer), bufsize);
+		return;
+	}
+
+	if (!zipper)
+	{
+		zipper.reset(FB_NEW_POOL(*getDefaultMemoryPool()) BackupZip(true));
+		zip_data.getBuffer(ZIP_BLOCK_SIZE);
+		zip_packed.getBuffer(zipper->bound(ZIP_BLOCK_SIZE));
+		zip_pos = 0;
+
+		zip_header zh;
+		memcpy(zh.signature, zip_signature, sizeof(zip_signature));
+		zh.version = ZIP_VERSION;
+		zh.reserved = 0;
+		zh.block_size = ZIP_BLOCK_SIZE;
+		write_file(backup, &zh, sizeof(zh));
+	}
+
+	const UCHAR* data = static_cast<const UCHAR*>(buffer);
+	while (bufsize)
+	{
+		const FB_SIZE_T length = MIN(bufsize, ZIP_BLOCK_SIZE - zip_pos);
+		memcpy(zip_data.begin() + zip_pos, data, length);
+		zip_pos += length;
+		data += length;
+		bufsize -= length;
+
+		if (zip_pos == ZIP_BLOCK_SIZE)
+			write_block();
+	}
+}
+
+void NBackup::write_block()
+{
+	zip_block block;
+	block.length = zip_pos;
+	block.crc = zipper->crc(zip_data.begin(), zip_pos);
+	block.packed = zipper->pack(zip_data.begin(), zip_pos, zip_packed.begin(), zip_packed.getCount());
+
+	const UCHAR* const data = block.packed ? zip_packed.begin() : zip_data.begin();
+	if (!block.packed)
+		block.packed = block.length;
+
+	write_file(backup, &block, sizeof(block));
+	write_file(backup, const_cast<UCHAR*>(data), block.packed);
+	zip_pos = 0;
+}
+
+// Write the last block and end of compressed stream
+void NBackup::finish_backup()
+{
+	if (!zipper)
+		return;
+
+	if (zip_pos)
+		write_block();
+
+	zip_block block;
+	block.length = block.packed = block.crc = 0;
+	write_file(backup, &block, sizeof(block));
+}
+
+void NBackup::init_scan(ULONG page_size)
+{
+	scan_size = MAX(BACKUP_CHUNK_SIZE / page_size, 1u);
+	UCHAR* buf = scan_buffer.getBuffer(scan_size * page_size + SECTOR_ALIGNMENT);
+	scan_data = FB_ALIGN(buf, SECTOR_ALIGNMENT);
+	scan_first = scan_count = 0;
+}
+
+// Read a database page. When page is not in the current chunk, up to span
+// pages starting from it are read with single call. Sector aligned chunk keeps
+// this working with direct IO.
+FB_SIZE_T NBackup::read_page(ULONG page, ULONG span, ULONG page_size, void* buffer)
+{
+	if (page < scan_first || page >= scan_first + scan_count)
+	{
+		seek_file(dbase, (SINT64) page * page_size);
+		const FB_SIZE_T bytesDone = read_file(dbase, scan_data, MIN(MAX(span, 1u), scan_size) * page_size);
+
+		scan_first = page;
+		scan_count = bytesDone / page_size;
+		if (!scan_count)
+			return bytesDone;
+	}
+
+	memcpy(buffer, scan_data + (page - scan_first) * page_size, page_size);
+	return page_size;
+}
+
 void NBackup::fixup_database(bool set_readonly)
 {
 	open_database_write();
@@ -1109,6 +1475,7 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 		} // end scope
 
 		ULONG db_size = db_size_pages;
+		init_scan(header->hdr_page_size);
 		seek_file(dbase, 0);
 
 		if (read_file(dbase, page_buff, header->hdr_page_size) != header->hdr_page_size)
@@ -1158,7 +1525,7 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 
 			memset(page_buff, 0, header->hdr_page_size);
 			memcpy(page_buff, &bh, sizeof(bh));
-			write_file(backup, page_buff, header->hdr_page_size);
+			write_backup(page_buff, header->hdr_page_size);
 			page_writes++;
 
 			seek_file(dbase, 0);
@@ -1190,7 +1557,7 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 
 			if (!level || page_buff->pag_scn > prev_scn)
 			{
-				write_file(backup, page_buff, header->hdr_page_size);
+				write_backup(page_buff, header->hdr_page_size);
 				page_writes++;
 			}
 
@@ -1216,7 +1583,6 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 						curPage == nextSCN ||
 						curPage == lastPage)
 					{
-						seek_file(dbase, (SINT64) curPage * header->hdr_page_size);
 						break;
 					}
 				}
@@ -1234,8 +1600,21 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 			else
 				curPage++;
 
+			// Pages that follow and are going to be read too. When backup is incremental
+			// and SCN page shows no changes in the rest of chunk, just the needed part of
+			// it is read. Unchanged runs between changed pages are skipped with seek.
+			ULONG span = scan_size;
+			if (level && (scns || curPage >= FIRST_SCN_PAGE))
+			{
+				span = 1;
+				for (ULONG n = 1; scns && n < scan_size && scnsSlot + n < pagesPerSCN; n++)
+				{
+					if (scns->scn_pages[scnsSlot + n] > prev_scn || curPage + n == lastPage)
+						span = n + 1;
+				}
+			}
 
-			const FB_SIZE_T bytesDone = read_file(dbase, page_buff, header->hdr_page_size);
+			const FB_SIZE_T bytesDone = read_page(curPage, span, header->hdr_page_size, page_buff);
 			--db_size;
 			page_reads++;
 			if (bytesDone == 0)
@@ -1279,6 +1658,7 @@ void NBackup::backup_database(int level, Guid& guid, const PathName& fname)
 			}
 		}
 		close_database();
+		finish_backup();
 		close_backup();
 
 		delete_backup = false; // Backup file is consistent. No need to delete it
@@ -1442,7 +1822,10 @@ void NBackup::restore_database(const BackupFiles& files, bool inc_rest)
 #ifdef WIN_NT
 						if (curLevel)
 #endif
+						{
 							open_backup_scan();
+							open_backup_stream();
+						}
 						break;
 					}
 					catch (const status_exception& e)
@@ -1471,13 +1854,16 @@ void NBackup::restore_database(const BackupFiles& files, bool inc_rest)
 #else
 				if (!inc_rest || curLevel)
 #endif
+				{
 					open_backup_scan();
+					open_backup_stream();
+				}
 			}
 
 			if (curLevel)
 			{
 				inc_header bakheader;
-				if (read_file(backup, &bakheader, sizeof(bakheader)) != sizeof(bakheader))
+				if (read_backup(&bakheader, sizeof(bakheader)) != sizeof(bakheader))
 					status_exception::raise(Arg::Gds(isc_nbackup_err_eofhdrbk) << bakname.c_str());
 				if (memcmp(bakheader.signature, backup_signature, sizeof(backup_signature)) != 0)
 					status_exception::raise(Arg::Gds(isc_nbackup_invalid_incbk) << bakname.c_str());
@@ -1494,24 +1880,17 @@ void NBackup::restore_database(const BackupFiles& files, bool inc_rest)
 				// We may also add SCN check, but GUID check covers this case too
 				if (memcmp(&bakheader.prev_guid, &prev_guid, sizeof(Guid)) != 0)
 					status_exception::raise(Arg::Gds(isc_nbackup_wrong_orderbk) << bakname.c_str());
-				seek_file(backup, bakheader.page_size);
+
+				// Skip the rest of header page, backup may be a compressed stream or a pipe
+				Array<UCHAR> header_rest;
+				const FB_SIZE_T restLength = bakheader.page_size - sizeof(bakheader);
+				if (read_backup(header_rest.getBuffer(restLength), restLength) != restLength)
+					status_exception::raise(Arg::Gds(isc_nbackup_err_eofhdrbk) << bakname.c_str());
 
 				if (!inc_rest)
 					delete_database = true;
 				prev_guid = bakheader.backup_guid;
-				while (true)
-				{
-					const FB_SIZE_T bytesDone = read_file(backup, page_buffer, bakheader.page_size);
-					if (bytesDone == 0)
-						break;
-					if (bytesDone != bakheader.page_size) {
-						status_exception::raise(Arg::Gds(isc_nbackup_err_eofbk) << bakname.c_str());
-					}
-					const SINT64 pageNum = reinterpret_cast<Ods::pag*> (page_buffer)->pag_pageno;
-					seek_file(dbase, pageNum * bakheader.page_size);
-					write_file(dbase, page_buffer, bakheader.page_size);
-					checkCtrlC(uSvc);
-				}
+				apply_backup(bakheader.page_size);
 				delete_database = false;
 			}
 			else
@@ -1519,27 +1898,45 @@ void NBackup::restore_database(const BackupFiles& files, bool inc_rest)
 				if (!inc_rest)
 				{
 #ifdef WIN_NT
-					if (!CopyFile(bakname.c_str(), dbname.c_str(), TRUE))
+					// Compressed backup can't be just copied
+					open_backup_scan();
+					const bool compressed = open_backup_stream();
+					if (compressed)
 					{
-						status_exception::raise(Arg::Gds(isc_nbackup_err_copy) <<
-							dbname.c_str() << bakname.c_str() << Arg::OsError());
+						create_database();
+						delete_database = true;
 					}
-					checkCtrlC(uSvc);
-					delete_database = true; // database is possibly broken
-					open_database_write();
-#else
-					// Use relatively small buffer to make use of prefetch and lazy flush
-					char buffer[65536];
-					while (true)
+					else
 					{
-						const FB_SIZE_T bytesRead = read_file(backup, buffer, sizeof(buffer));
-						if (bytesRead == 0)
-							break;
-						write_file(dbase, buffer, bytesRead);
+						close_backup();
+						if (!CopyFile(bakname.c_str(), dbname.c_str(), TRUE))
+						{
+							status_exception::raise(Arg::Gds(isc_nbackup_err_copy) <<
+								dbname.c_str() << bakname.c_str() << Arg::OsError());
+						}
 						checkCtrlC(uSvc);
+						delete_database = true; // database is possibly broken
+						open_database_write();
 					}
-					seek_file(dbase, 0);
+
+					if (compressed)
 #endif
+					{
+						// Use relatively small buffer to make use of prefetch and lazy flush
+						char buffer[65536];
+						while (true)
+						{
+							const FB_SIZE_T bytesRead = read_backup(buffer, sizeof(buffer));
+							if (bytesRead == 0)
+								break;
+							write_file(dbase, buffer, bytesRead);
+							checkCtrlC(uSvc);
+						}
+						seek_file(dbase, 0);
+#ifdef WIN_NT
+						close_backup();
+#endif
+					}
 				}
 				else
 					open_database_write(true);
@@ -1598,6 +1995,137 @@ void NBackup::restore_database(const BackupFiles& files, bool inc_rest)
 	}
 }
 
+// State shared by restore_database() reading backup and thread writing pages
+struct NBackup::ApplyChunks
+{
+	ApplyChunks(NBackup* p_nbk, ULONG p_page_size)
+		: nbk(p_nbk), page_size(p_page_size), failed(false)
+	{
+		chunk_pages = MAX(RESTORE_CHUNK_SIZE / page_size, 1u);
+		for (int i = 0; i < 2; i++)
+		{
+			buffers[i] = FB_NEW_POOL(*getDefaultMemoryPool()) UCHAR[chunk_pages * page_size];
+			pages[i] = 0;
+		}
+		free.release(2);
+	}
+
+	~ApplyChunks()
+	{
+		for (int i = 0; i < 2; i++)
+			delete[] buffers[i];
+	}
+
+	NBackup* const nbk;
+	const ULONG page_size;
+	FB_SIZE_T chunk_pages;
+	UCHAR* buffers[2];
+	FB_SIZE_T pages[2];		// zero pages in a chunk tells writer to stop
+	Semaphore free, filled;
+	bool failed;
+	StaticStatusVector error;
+};
+
+THREAD_ENTRY_DECLARE NBackup::apply_thread(THREAD_ENTRY_PARAM arg)
+{
+	ApplyChunks* const chunks = static_cast<ApplyChunks*>(arg);
+
+	for (int n = 0; ; n ^= 1)
+	{
+		chunks->filled.enter();
+		if (!chunks->pages[n])
+			break;
+
+		// After an error keep consuming chunks until reader notices it
+		if (!chunks->failed)
+		{
+			try
+			{
+				chunks->nbk->write_pages(chunks->buffers[n], chunks->pages[n], chunks->page_size);
+			}
+			catch (const Exception& e)
+			{
+				e.stuffException(chunks->error);
+				chunks->failed = true;
+			}
+		}
+
+		chunks->free.release();
+	}
+
+	return 0;
+}
+
+void NBackup::write_pages(const UCHAR* buffer, FB_SIZE_T count, ULONG page_size)
+{
+	// Incremental backup has pages in ascending order, write every run
+	// of consecutive pages with single call
+	FB_SIZE_T i = 0;
+	while (i < count)
+	{
+		const UCHAR* const start = buffer + i * page_size;
+		const ULONG startPage = reinterpret_cast<const Ods::pag*>(start)->pag_pageno;
+
+		FB_SIZE_T run = 1;
+		while (i + run < count &&
+			reinterpret_cast<const Ods::pag*>(start + run * page_size)->pag_pageno == startPage + run)
+		{
+			run++;
+		}
+
+		seek_file(dbase, (SINT64) startPage * page_size);
+		write_file(dbase, const_cast<UCHAR*>(start), run * page_size);
+		i += run;
+	}
+}
+
+void NBackup::apply_backup(ULONG page_size)
+{
+	// Backup is read in large chunks by this thread and written to database by
+	// another one, so reading backup file (or decompressor pipe) overlaps with
+	// writing into database
+	ApplyChunks chunks(this, page_size);
+
+	Thread::Handle writer;
+	Thread::start(apply_thread, &chunks, THREAD_medium, &writer);
+
+	for (int n = 0; ; n ^= 1)
+	{
+		chunks.free.enter();
+
+		try
+		{
+			checkCtrlC(uSvc);
+
+			if (chunks.failed)
+				status_exception::raise(chunks.error.begin());
+
+			const FB_SIZE_T bytesDone =
+				read_backup(chunks.buffers[n], chunks.chunk_pages * page_size);
+			if (bytesDone % page_size != 0)
+				status_exception::raise(Arg::Gds(isc_nbackup_err_eofbk) << bakname.c_str());
+
+			chunks.pages[n] = bytesDone / page_size;
+		}
+		catch (const Exception&)
+		{
+			chunks.pages[n] = 0;
+			chunks.filled.release();
+			Thread::waitForCompletion(writer);
+			throw;
+		}
+
+		chunks.filled.release();
+		if (!chunks.pages[n])
+			break;
+	}
+
+	Thread::waitForCompletion(writer);
+
+	if (chunks.failed)
+		status_exception::raise(chunks.error.begin());
+}
+
 int NBACKUP_main(UtilSvc* uSvc)
 {
 	int exit_code = FB_SUCCESS;
@@ -1655,7 +2183,7 @@ void nbackup(UtilSvc* uSvc)
 	NBackup::BackupFiles backup_files;
 	int level = -1;
 	Guid guid;
-	bool print_size = false, version = false, inc_rest = false;
+	bool print_size = false, version = false, inc_rest = false, zip = false;
 	string onOff;
 
 	const Switches switches(nbackup_action_in_sw_table, FB_NELEM(nbackup_action_in_sw_table),
@@ -1836,6 +2364,10 @@ void nbackup(UtilSvc* uSvc)
 			inc_rest = true;
 			break;
 
+		case IN_SW_NBK_ZIP:
+			zip = true;
+			break;
+
 		default:
 			usage(uSvc, isc_nbackup_unknown_switch, argv[itr]);
 			break;
@@ -1861,7 +2393,7 @@ void nbackup(UtilSvc* uSvc)
 		usage(uSvc, isc_nbackup_size_with_lock);
 	}
 
-	NBackup nbk(uSvc, database, username, role, password, run_db_triggers, direct_io, decompress);
+	NBackup nbk(uSvc, database, username, role, password, run_db_triggers, direct_io, decompress, zip);
 	try
 	{
 		switch (op)
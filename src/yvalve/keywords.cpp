@@ -104,6 +104,7 @@ static const TOK tokens[] =
 	{TOK_BOTH, "BOTH", false},
 	{TOK_BREAK, "BREAK", true},
 	{TOK_BY, "BY", false},
+	{TOK_CACHE, "CACHE", true},
 	{TOK_CALLER, "CALLER", true},
 	{TOK_CASCADE, "CASCADE", true},
 	{TOK_CASE, "CASE", false},
@@ -169,6 +170,7 @@ static const TOK tokens[] =
 	{TOK_DEFINER, "DEFINER", true},
 	{TOK_DELETE, "DELETE", false},
 	{TOK_DELETING, "DELETING", false},
+	{TOK_DELIMITER, "DELIMITER", true},
 	{TOK_DENSE_RANK, "DENSE_RANK", true},
 	{TOK_DESC, "DESC", true},	// Alias of DESCENDING
 	{TOK_DESC, "DESCENDING", true},
@@ -453,6 +455,7 @@ static const TOK tokens[] =
 	{TOK_TRANSACTION, "TRANSACTION", true},
 	{TOK_TRAPS, "TRAPS", true},
 	{TOK_TRIGGER, "TRIGGER", false},
+	{TOK_TRIGRAM, "TRIGRAM", true},
 	{TOK_TRIM, "TRIM", false},
 	{TOK_TRUE, "TRUE", false},
 	{TOK_TRUNC, "TRUNC", true},